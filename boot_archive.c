@@ -0,0 +1,1023 @@
+/*
+ *  Copyright (C) 2025 Texas Instruments Incorporated
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions
+ *  are met:
+ *
+ *    Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *
+ *    Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the
+ *    distribution.
+ *
+ *    Neither the name of Texas Instruments Incorporated nor the names of
+ *    its contributors may be used to endorse or promote products derived
+ *    from this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ *  "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ *  LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ *  A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ *  OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ *  SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ *  LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ *  DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ *  THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ *  (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ *  OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/**
+ * \file boot_archive.c
+ * \brief Columnar boot archive. Readers map the file and use the summary
+ * rows and name column in place; only the start/delta columns need
+ * decoding, and only for the boots asked for. An append writes the new
+ * boot as a segment after the committed end of the file and then commits
+ * it by rewriting the header, so the boots already archived are neither
+ * read back nor rewritten and readers never see a partial segment.
+ */
+
+/* ========================================================================== */
+/*                           Include Files                                    */
+/* ========================================================================== */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include <fcntl.h>
+#include <errno.h>
+#include <time.h>
+#include <inttypes.h>
+#include <sys/file.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+
+#include "boot_archive.h"
+
+/* ========================================================================== */
+/*                           Macros & Typedefs                                */
+/* ========================================================================== */
+
+#define ALIGN8(x)	(((x) + 7) & ~(uint64_t)7)
+/* Longest LEB128 encoding of a 64-bit value */
+#define VARINT_MAX	10
+/* Bound on segment counts and lengths, so section sizes cannot wrap */
+#define SEG_MAX_LEN	((uint64_t)1 << 40)
+
+/* Section offsets of a segment, relative to its start */
+typedef struct {
+	uint64_t names;
+	uint64_t boots;
+	uint64_t cores;
+	uint64_t name_col;
+	uint64_t id_col;
+	uint64_t start_col;
+	uint64_t delta_col;
+	uint64_t dur_col;
+	uint64_t size;
+} seg_layout_t;
+
+
+/* ========================================================================== */
+/*                          Function Definitions                              */
+/* ========================================================================== */
+
+static uint64_t zigzag(int64_t v)
+{
+	return ((uint64_t)v << 1) ^ (uint64_t)(v >> 63);
+}
+
+static int64_t unzigzag(uint64_t v)
+{
+	return (int64_t)(v >> 1) ^ -(int64_t)(v & 1);
+}
+
+static size_t varint_put(uint8_t *p, uint64_t v)
+{
+	size_t n = 0;
+
+	while (v >= 0x80) {
+		p[n++] = (uint8_t)v | 0x80;
+		v >>= 7;
+	}
+	p[n++] = (uint8_t)v;
+	return n;
+}
+
+/* Returns the position after the varint, or NULL if it runs past end */
+static const uint8_t *varint_get(const uint8_t *p, const uint8_t *end, uint64_t *v)
+{
+	uint64_t r = 0;
+
+	for (int shift = 0; p < end && shift < 64; shift += 7) {
+		uint8_t b = *p++;
+		r |= (uint64_t)(b & 0x7f) << shift;
+		if (!(b & 0x80)) {
+			*v = r;
+			return p;
+		}
+	}
+	return NULL;
+}
+
+static int section_ok(uint64_t size, uint64_t off, uint64_t len)
+{
+	return off <= size && len <= size - off;
+}
+
+/*
+ * Checks a dictionary section: count + 1 offsets, then the strings. Every
+ * offset must fall inside the strings and the last string must be NUL
+ * terminated, so no name can run past the section.
+ */
+static int names_ok(const uint8_t *p, uint64_t len, uint32_t count)
+{
+	const uint32_t *offs = (const uint32_t *)p;
+	uint64_t table = ((uint64_t)count + 1) * sizeof(uint32_t);
+	uint32_t strs;
+
+	if (table > len)
+		return 0;
+	strs = offs[count];
+	if (strs > len - table || (count && (strs == 0 || p[table + strs - 1] != '\0')))
+		return 0;
+	for (uint32_t i = 0; i < count; i++)
+		if (offs[i] >= strs)
+			return 0;
+	return 1;
+}
+
+/* Lays out the sections of a segment; returns -1 if its counts are absurd */
+static int seg_layout(const boot_archive_seg_t *s, seg_layout_t *l)
+{
+	if (s->names_len > SEG_MAX_LEN || s->core_count > SEG_MAX_LEN ||
+			s->record_count > SEG_MAX_LEN || s->start_col_len > SEG_MAX_LEN ||
+			s->delta_col_len > SEG_MAX_LEN || s->dur_col_len > SEG_MAX_LEN)
+		return -1;
+	l->names = ALIGN8(sizeof(*s));
+	l->boots = l->names + ALIGN8(s->names_len);
+	l->cores = l->boots + ALIGN8((uint64_t)s->boot_count * sizeof(boot_archive_boot_t));
+	l->name_col = l->cores + ALIGN8(s->core_count * sizeof(boot_archive_core_t));
+	l->id_col = l->name_col + ALIGN8(s->record_count * sizeof(uint32_t));
+	l->start_col = l->id_col + ALIGN8(s->record_count * sizeof(int32_t));
+	l->delta_col = l->start_col + ALIGN8(s->start_col_len);
+	l->dur_col = l->delta_col + ALIGN8(s->delta_col_len);
+	l->size = l->dur_col + ALIGN8(s->dur_col_len);
+	return 0;
+}
+
+/* Adds the names of one dictionary section, already checked, to ar->names */
+static void add_names(boot_archive_t *ar, const uint8_t *p, uint32_t count)
+{
+	const uint32_t *offs = (const uint32_t *)p;
+	const char *strs = (const char *)(offs + count + 1);
+
+	for (uint32_t i = 0; i < count; i++)
+		ar->names[ar->name_count++] = strs + offs[i];
+}
+
+/* Gathers the segments of an archive */
+static int open_segments(boot_archive_t *ar)
+{
+	const boot_archive_hdr_t *h = (const boot_archive_hdr_t *)ar->map;
+	uint64_t off = ALIGN8(sizeof(*h));
+	uint64_t records = 0, cores = 0;
+
+	if (h->file_size < off || h->file_size > ar->size ||
+			h->boot_count > h->file_size / sizeof(boot_archive_boot_t) ||
+			h->name_count > h->file_size / sizeof(uint32_t) ||
+			h->segment_count > h->file_size / sizeof(boot_archive_seg_t))
+		return -1;
+	ar->names = malloc(((size_t)h->name_count + 1) * sizeof(*ar->names));
+	ar->boots = malloc(((size_t)h->boot_count + 1) * sizeof(*ar->boots));
+	ar->boot_seg = malloc(((size_t)h->boot_count + 1) * sizeof(*ar->boot_seg));
+	ar->segs = malloc(((size_t)h->segment_count + 1) * sizeof(*ar->segs));
+	if (!ar->names || !ar->boots || !ar->boot_seg || !ar->segs)
+		return -1;
+
+	while (off < h->file_size) {
+		const boot_archive_seg_t *s = (const boot_archive_seg_t *)(ar->map + off);
+		const uint8_t *base = ar->map + off;
+		boot_archive_cols_t *c;
+		seg_layout_t l;
+
+		if (!section_ok(h->file_size, off, sizeof(*s)) || s->magic != BOOT_ARCHIVE_SEG_MAGIC ||
+				seg_layout(s, &l) < 0 || l.size != s->size ||
+				!section_ok(h->file_size, off, s->size) ||
+				ar->nsegs == h->segment_count || s->first_name != ar->name_count ||
+				s->name_count > h->name_count - ar->name_count ||
+				s->boot_count > h->boot_count - ar->boot_count ||
+				!names_ok(base + l.names, s->names_len, s->name_count))
+			return -1;
+		add_names(ar, base + l.names, s->name_count);
+		memcpy(ar->boots + ar->boot_count, base + l.boots,
+				(size_t)s->boot_count * sizeof(*ar->boots));
+		for (uint32_t i = 0; i < s->boot_count; i++)
+			ar->boot_seg[ar->boot_count++] = ar->nsegs;
+		c = &ar->segs[ar->nsegs++];
+		c->cores = (const boot_archive_core_t *)(base + l.cores);
+		c->name_col = (const uint32_t *)(base + l.name_col);
+		c->id_col = (const int32_t *)(base + l.id_col);
+		c->start_col = base + l.start_col;
+		c->delta_col = base + l.delta_col;
+		c->dur_col = base + l.dur_col;
+		c->core_count = s->core_count;
+		c->record_count = s->record_count;
+		c->start_col_len = s->start_col_len;
+		c->delta_col_len = s->delta_col_len;
+		c->dur_col_len = s->dur_col_len;
+		records += s->record_count;
+		cores += s->core_count;
+		off += s->size;
+	}
+	if (ar->nsegs != h->segment_count || ar->boot_count != h->boot_count ||
+			ar->name_count != h->name_count || records != h->record_count ||
+			cores != h->core_count)
+		return -1;
+	return 0;
+}
+
+/**
+ * @brief Maps an archive read-only and checks its layout.
+ *
+ * @param ar Receives the archive view.
+ * @param path Archive file.
+ * @return int 0 on success, -1 on failure.
+ */
+int boot_archive_open(boot_archive_t *ar, const char *path)
+{
+	const boot_archive_hdr_t *h;
+	struct stat st;
+	void *map;
+	int fd;
+
+	memset(ar, 0, sizeof(*ar));
+	fd = open(path, O_RDONLY);
+	if (fd < 0) {
+		perror("Failed to open boot archive");
+		return -1;
+	}
+	if (fstat(fd, &st) < 0) {
+		perror("fstat");
+		close(fd);
+		return -1;
+	}
+	if ((size_t)st.st_size < sizeof(*h)) {
+		fprintf(stderr, "Boot archive %s too small\n", path);
+		close(fd);
+		return -1;
+	}
+	map = mmap(NULL, st.st_size, PROT_READ, MAP_SHARED, fd, 0);
+	close(fd);
+	if (map == MAP_FAILED) {
+		perror("mmap");
+		return -1;
+	}
+	ar->map = map;
+	ar->size = st.st_size;
+	h = map;
+
+	if (h->magic != BOOT_ARCHIVE_MAGIC || h->version != BOOT_ARCHIVE_VERSION ||
+			h->time_unit_ns != BOOT_ARCHIVE_TIME_UNIT_NS) {
+		fprintf(stderr, "Unsupported boot archive %s: magic=0x%08x version=%u unit=%u ns\n",
+				path, h->magic, h->version, h->time_unit_ns);
+		goto bad;
+	}
+	if (open_segments(ar) < 0) {
+		fprintf(stderr, "Corrupt boot archive %s\n", path);
+		goto bad;
+	}
+	return 0;
+bad:
+	boot_archive_close(ar);
+	return -1;
+}
+
+/**
+ * @brief Unmaps an archive.
+ */
+void boot_archive_close(boot_archive_t *ar)
+{
+	if (ar->map)
+		munmap((void *)ar->map, ar->size);
+	free(ar->names);
+	free(ar->boots);
+	free(ar->boot_seg);
+	free(ar->segs);
+	memset(ar, 0, sizeof(*ar));
+}
+
+/**
+ * @brief Returns a dictionary entry.
+ */
+const char *boot_archive_name(const boot_archive_t *ar, uint32_t idx)
+{
+	if (idx >= ar->name_count)
+		return "";
+	return ar->names[idx];
+}
+
+/**
+ * @brief Returns the name column of one boot, in place.
+ *
+ * @return const uint32_t* count + mcu_reccount dictionary indices, or NULL
+ * if the boot row is corrupt.
+ */
+const uint32_t *boot_archive_record_names(const boot_archive_t *ar, uint32_t boot)
+{
+	const boot_archive_boot_t *b = &ar->boots[boot];
+	const boot_archive_cols_t *c = &ar->segs[ar->boot_seg[boot]];
+
+	if (b->first_record > c->record_count ||
+			(uint64_t)b->count + b->mcu_reccount > c->record_count - b->first_record)
+		return NULL;
+	return c->name_col + b->first_record;
+}
+
+/**
+ * @brief Returns the bootstage id column of one boot, in place.
+ *
+ * @return const int32_t* count + mcu_reccount ids, or NULL if the boot
+ * row is corrupt.
+ */
+const int32_t *boot_archive_record_ids(const boot_archive_t *ar, uint32_t boot)
+{
+	if (!boot_archive_record_names(ar, boot))
+		return NULL;
+	return ar->segs[ar->boot_seg[boot]].id_col + ar->boots[boot].first_record;
+}
+
+/**
+ * @brief Returns the remote core table of one boot, in place.
+ *
+ * @return const boot_archive_core_t* core_count entries whose counts add
+ * up to mcu_reccount, or NULL if the boot row is corrupt.
+ */
+const boot_archive_core_t *boot_archive_boot_cores(const boot_archive_t *ar, uint32_t boot)
+{
+	const boot_archive_boot_t *b = &ar->boots[boot];
+	const boot_archive_cols_t *s = &ar->segs[ar->boot_seg[boot]];
+	const boot_archive_core_t *c;
+	uint64_t n = 0;
+
+	if (b->first_core > s->core_count || b->core_count > s->core_count - b->first_core)
+		return NULL;
+	c = s->cores + b->first_core;
+	for (uint32_t i = 0; i < b->core_count; i++)
+		n += c[i].count;
+	return (n == b->mcu_reccount) ? c : NULL;
+}
+
+/**
+ * @brief Decodes the varint columns of one boot, in nanoseconds.
+ *
+ * @param ar Archive.
+ * @param boot Boot index, 0 is the oldest.
+ * @param start_time Receives count + mcu_reccount values.
+ * @param delta_time Receives count + mcu_reccount values.
+ * @param duration Receives count + mcu_reccount values.
+ * @return int 0 on success, -1 if the columns are corrupt.
+ */
+int boot_archive_decode(const boot_archive_t *ar, uint32_t boot,
+		uint64_t *start_time, uint64_t *delta_time, uint64_t *duration)
+{
+	const boot_archive_boot_t *b = &ar->boots[boot];
+	const boot_archive_cols_t *c = &ar->segs[ar->boot_seg[boot]];
+	const boot_archive_core_t *cores = boot_archive_boot_cores(ar, boot);
+	const uint8_t *sp, *send = c->start_col + c->start_col_len;
+	const uint8_t *dp, *dend = c->delta_col + c->delta_col_len;
+	const uint8_t *up, *uend = c->dur_col + c->dur_col_len;
+	uint32_t n = b->count + b->mcu_reccount;
+	uint32_t run_end = b->count, core = 0;
+	uint64_t prev = 0, v;
+
+	if (!cores || b->start_off > c->start_col_len ||
+			b->delta_off > c->delta_col_len || b->dur_off > c->dur_col_len)
+		return -1;
+	sp = c->start_col + b->start_off;
+	dp = c->delta_col + b->delta_off;
+	up = c->dur_col + b->dur_off;
+	for (uint32_t i = 0; i < n; i++) {
+		/* Each remote core's run restarts the chain */
+		while (i == run_end && core < b->core_count) {
+			run_end += cores[core++].count;
+			prev = 0;
+		}
+		sp = varint_get(sp, send, &v);
+		if (!sp)
+			return -1;
+		prev += (uint64_t)unzigzag(v);
+		start_time[i] = prev;
+		dp = varint_get(dp, dend, &v);
+		if (!dp)
+			return -1;
+		delta_time[i] = (uint64_t)unzigzag(v);
+		up = varint_get(up, uend, &duration[i]);
+		if (!up)
+			return -1;
+	}
+	return 0;
+}
+
+/**
+ * @brief Prints the summary row of every archived boot, oldest first.
+ *
+ * Only the summary rows are read; no record column is decoded.
+ *
+ * @param ar Archive.
+ * @param unit Display unit of the times.
+ * @param fp Output stream.
+ */
+void boot_archive_print(const boot_archive_t *ar, boot_time_unit_t unit, FILE *fp)
+{
+	fprintf(fp, "--------------------------------------------------------------------\n");
+	fprintf(fp, "                 Archived Boots (%u)\n", ar->boot_count);
+	fprintf(fp, "--------------------------------------------------------------------\n");
+	fprintf(fp, "%6s %-19s %-16s %6s %6s %7s %6s %6s (%s)\n", "boot", "captured", "host",
+			"SPL", "U-Boot", "handoff", "kernel", "total", boot_time_unit_name(unit));
+	for (uint32_t i = 0; i < ar->boot_count; i++) {
+		const boot_archive_boot_t *b = &ar->boots[i];
+		time_t t = (time_t)b->timestamp;
+		char when[32] = "-";
+		struct tm tm;
+
+		if (t && localtime_r(&t, &tm))
+			strftime(when, sizeof(when), "%Y-%m-%d %H:%M:%S", &tm);
+		fprintf(fp, "%6d %-19s %-16.16s %6" PRIu64 " %6" PRIu64 " %7" PRIu64
+				" %6" PRIu64 " %6" PRIu64 "\n",
+				(int)i - (int)(ar->boot_count - 1), when,
+				boot_archive_name(ar, b->host),
+				boot_time_to_unit(b->ustart_time, unit),
+				boot_time_to_unit(b->uend_time - b->ustart_time, unit),
+				boot_time_to_unit(b->kstart_time - b->uend_time, unit),
+				boot_time_to_unit(b->kend_time - b->kstart_time, unit),
+				boot_time_to_unit(b->kend_time, unit));
+	}
+	fprintf(fp, "--------------------------------------------------------------------\n");
+}
+
+/**
+ * @brief Initialises an empty archive writer.
+ */
+void boot_archive_writer_init(boot_archive_writer_t *w)
+{
+	memset(w, 0, sizeof(*w));
+	arena_init(&w->arena);
+	strtab_init(&w->names, &w->arena);
+}
+
+/**
+ * @brief Releases an archive writer.
+ */
+void boot_archive_writer_free(boot_archive_writer_t *w)
+{
+	free(w->boots);
+	free(w->cores);
+	free(w->name_col);
+	free(w->id_col);
+	free(w->start_col);
+	free(w->delta_col);
+	free(w->dur_col);
+	arena_release(&w->arena);
+	memset(w, 0, sizeof(*w));
+}
+
+static int grow(void **p, size_t *cap, size_t need, size_t elem)
+{
+	size_t n = *cap ? *cap : 256;
+	void *q;
+
+	if (need <= *cap)
+		return 0;
+	while (n < need)
+		n *= 2;
+	q = realloc(*p, n * elem);
+	if (!q)
+		return -1;
+	*p = q;
+	*cap = n;
+	return 0;
+}
+
+static int reserve(boot_archive_writer_t *w, uint32_t boots, uint64_t cores,
+		uint64_t records, size_t bytes)
+{
+	size_t rcap = w->records_cap;
+	size_t icap = w->records_cap;
+	size_t bcap = w->boots_cap;
+	int err = 0;
+
+	err |= grow((void **)&w->boots, &bcap, (size_t)w->nboots + boots, sizeof(*w->boots));
+	err |= grow((void **)&w->cores, &w->cores_cap, w->ncores + cores, sizeof(*w->cores));
+	err |= grow((void **)&w->name_col, &rcap, w->nrecords + records, sizeof(uint32_t));
+	err |= grow((void **)&w->id_col, &icap, w->nrecords + records, sizeof(int32_t));
+	err |= grow((void **)&w->start_col, &w->start_cap, w->start_len + bytes, 1);
+	err |= grow((void **)&w->delta_col, &w->delta_cap, w->delta_len + bytes, 1);
+	err |= grow((void **)&w->dur_col, &w->dur_cap, w->dur_len + bytes, 1);
+	w->records_cap = rcap < icap ? rcap : icap;
+	w->boots_cap = bcap;
+	return err ? -1 : 0;
+}
+
+/* Appends the varints of one record; prev carries the start_time chain */
+static void put_record(boot_archive_writer_t *w, uint64_t *prev, uint64_t start,
+		uint64_t delta, uint64_t dur)
+{
+	w->start_len += varint_put(w->start_col + w->start_len,
+			zigzag((int64_t)(start - *prev)));
+	w->delta_len += varint_put(w->delta_col + w->delta_len, zigzag((int64_t)delta));
+	w->dur_len += varint_put(w->dur_col + w->dur_len, dur);
+	*prev = start;
+}
+
+/*
+ * Copies one boot of an archive into the writer, re-encoding its times in
+ * BOOT_ARCHIVE_TIME_UNIT_NS; remap translates its dictionary indices.
+ */
+static int copy_boot(boot_archive_writer_t *w, const boot_archive_t *ar, uint32_t boot,
+		const uint32_t *remap)
+{
+	const boot_archive_boot_t *src = &ar->boots[boot];
+	const boot_archive_core_t *cores = boot_archive_boot_cores(ar, boot);
+	const uint32_t *names = boot_archive_record_names(ar, boot);
+	const int32_t *ids = boot_archive_record_ids(ar, boot);
+	uint32_t n = src->count + src->mcu_reccount;
+	uint32_t run_end = src->count, core = 0;
+	uint64_t *v = malloc(((size_t)n * 3 + 1) * sizeof(*v));
+	boot_archive_boot_t *b;
+	uint64_t prev = 0;
+
+	if (!v || !cores || !names || !ids ||
+			boot_archive_decode(ar, boot, v, v + n, v + 2 * n) < 0 ||
+			reserve(w, 1, src->core_count, n, (size_t)n * VARINT_MAX) < 0) {
+		free(v);
+		return -1;
+	}
+	b = &w->boots[w->nboots++];
+	*b = *src;
+	b->first_record = w->nrecords;
+	b->start_off = w->start_len;
+	b->delta_off = w->delta_len;
+	b->dur_off = w->dur_len;
+	b->first_core = w->ncores;
+	b->host = (b->host < ar->name_count) ? remap[b->host] : 0;
+	for (uint32_t i = 0; i < b->core_count; i++) {
+		boot_archive_core_t *c = &w->cores[w->ncores++];
+
+		*c = cores[i];
+		c->label = (c->label < ar->name_count) ? remap[c->label] : 0;
+	}
+	for (uint32_t i = 0; i < n; i++) {
+		while (i == run_end && core < b->core_count) {
+			run_end += cores[core++].count;
+			prev = 0;
+		}
+		w->name_col[w->nrecords] = (names[i] < ar->name_count) ? remap[names[i]] : 0;
+		w->id_col[w->nrecords++] = ids[i];
+		put_record(w, &prev, v[i], v[n + i], v[2 * n + i]);
+	}
+	free(v);
+	return 0;
+}
+
+/**
+ * @brief Copies every boot of an existing archive into the writer.
+ *
+ * Each boot is decoded and re-encoded, so the segments of the archive come
+ * out as one.
+ *
+ * @return int 0 on success, -1 on allocation failure or corrupt input.
+ */
+int boot_archive_writer_add_archive(boot_archive_writer_t *w, const boot_archive_t *ar)
+{
+	uint32_t *remap;
+	int ret = 0;
+
+	remap = malloc(((size_t)ar->name_count + 1) * sizeof(*remap));
+	if (!remap)
+		return -1;
+	for (uint32_t i = 0; i < ar->name_count; i++) {
+		const char *s = boot_archive_name(ar, i);
+		remap[i] = strtab_intern(&w->names, s, strlen(s));
+		if (remap[i] == STRTAB_NONE) {
+			free(remap);
+			return -1;
+		}
+	}
+	for (uint32_t i = 0; i < ar->boot_count && ret == 0; i++)
+		ret = copy_boot(w, ar, i, remap);
+	free(remap);
+	return ret;
+}
+
+static int add_records(boot_archive_writer_t *w, const boot_time_ctx_t *ctx,
+		const boot_record_columns_t *cols)
+{
+	uint64_t prev = 0;
+
+	for (int i = 0; i < cols->count; i++) {
+		const char *s = boot_time_name(ctx, cols->name[i]);
+		uint32_t idx = strtab_intern(&w->names, s, strlen(s));
+
+		if (idx == STRTAB_NONE)
+			return -1;
+		w->name_col[w->nrecords] = idx;
+		w->id_col[w->nrecords++] = cols->id[i];
+		put_record(w, &prev, cols->start_time[i], cols->delta_time[i], cols->duration[i]);
+	}
+	return 0;
+}
+
+/**
+ * @brief Adds the boot held in a parser context.
+ *
+ * @param w Writer.
+ * @param ctx Parsed boot.
+ * @param host Host name stored with the boot.
+ * @param timestamp Capture time, seconds since the epoch.
+ * @return int 0 on success, -1 on allocation failure.
+ */
+int boot_archive_writer_add_ctx(boot_archive_writer_t *w, const boot_time_ctx_t *ctx,
+		const char *host, uint64_t timestamp)
+{
+	const boot_summary_t *sum = boot_time_summary(ctx);
+	int ncores = boot_time_remote_core_count(ctx);
+	boot_record_columns_t recs, remote;
+	boot_archive_boot_t *b;
+	uint32_t hidx;
+	uint64_t n;
+
+	boot_time_records(ctx, &recs);
+	n = recs.count;
+	for (int c = 0; c < ncores; c++) {
+		boot_time_remote_records(ctx, c, &remote);
+		n += remote.count;
+	}
+	hidx = strtab_intern(&w->names, host, strlen(host));
+	if (hidx == STRTAB_NONE || reserve(w, 1, ncores, n, n * VARINT_MAX) < 0)
+		return -1;
+
+	b = &w->boots[w->nboots];
+	memset(b, 0, sizeof(*b));
+	b->timestamp = timestamp;
+	b->ustart_time = sum->ustart_time;
+	b->mcu_start_time = sum->mcu_start_time;
+	b->uend_time = sum->uend_time;
+	b->kstart_time = sum->kstart_time;
+	b->kend_time = sum->kend_time;
+	b->first_record = w->nrecords;
+	b->start_off = w->start_len;
+	b->delta_off = w->delta_len;
+	b->dur_off = w->dur_len;
+	b->first_core = w->ncores;
+	b->count = recs.count;
+	b->mcu_reccount = n - recs.count;
+	b->host = hidx;
+	b->core_count = ncores;
+
+	if (add_records(w, ctx, &recs) < 0)
+		return -1;
+	for (int c = 0; c < ncores; c++) {
+		const boot_remote_core_t *rc = boot_time_remote_core(ctx, c);
+		boot_archive_core_t *core = &w->cores[w->ncores++];
+
+		memset(core, 0, sizeof(*core));
+		core->offset = rc->offset;
+		core->anchor_id = rc->anchor_id;
+		core->label = strtab_intern(&w->names, rc->label, strlen(rc->label));
+		if (core->label == STRTAB_NONE)
+			return -1;
+		boot_time_remote_records(ctx, c, &remote);
+		core->count = remote.count;
+		if (add_records(w, ctx, &remote) < 0)
+			return -1;
+	}
+	w->nboots++;
+	return 0;
+}
+
+/* Writes one section at *pos followed by zero padding to the next 8-byte boundary */
+static int write_section(int fd, const void *buf, size_t len, uint64_t *pos)
+{
+	static const uint8_t zero[8];
+	const uint8_t *p = buf;
+	size_t pad = ALIGN8(len) - len;
+
+	while (len) {
+		ssize_t n = pwrite(fd, p, len, *pos);
+		if (n < 0) {
+			if (errno == EINTR)
+				continue;
+			return -1;
+		}
+		p += n;
+		len -= n;
+		*pos += n;
+	}
+	if (pad && pwrite(fd, zero, pad, *pos) != (ssize_t)pad)
+		return -1;
+	*pos += pad;
+	return 0;
+}
+
+/*
+ * Serialises the dictionary entries from first on as an offset table
+ * followed by the strings.
+ */
+static uint8_t *build_names(const strtab_t *names, uint32_t first, size_t *len)
+{
+	uint32_t count = names->count - first;
+	size_t table = ((size_t)count + 1) * sizeof(uint32_t);
+	size_t total = table;
+	uint32_t *offs;
+	uint8_t *buf;
+
+	for (uint32_t i = first; i < names->count; i++)
+		total += strlen(strtab_str(names, i)) + 1;
+	buf = malloc(total);
+	if (!buf)
+		return NULL;
+	offs = (uint32_t *)buf;
+	*len = table;
+	for (uint32_t i = 0; i < count; i++) {
+		const char *s = strtab_str(names, first + i);
+		size_t n = strlen(s) + 1;
+
+		offs[i] = *len - table;
+		memcpy(buf + *len, s, n);
+		*len += n;
+	}
+	offs[count] = *len - table;
+	return buf;
+}
+
+/*
+ * Writes every boot of the writer as one segment at *pos. Names below
+ * first_name are already in the archive and are left out.
+ */
+static int write_segment(int fd, const boot_archive_writer_t *w, uint32_t first_name,
+		uint64_t prev_names_off, uint64_t *pos, boot_archive_seg_t *s)
+{
+	uint64_t start = *pos;
+	seg_layout_t l;
+	uint8_t *names;
+	size_t names_len;
+	int err = 0;
+
+	names = build_names(&w->names, first_name, &names_len);
+	if (!names)
+		return -1;
+	memset(s, 0, sizeof(*s));
+	s->magic = BOOT_ARCHIVE_SEG_MAGIC;
+	s->boot_count = w->nboots;
+	s->first_name = first_name;
+	s->name_count = w->names.count - first_name;
+	s->names_len = names_len;
+	s->prev_names_off = prev_names_off;
+	s->core_count = w->ncores;
+	s->record_count = w->nrecords;
+	s->start_col_len = w->start_len;
+	s->delta_col_len = w->delta_len;
+	s->dur_col_len = w->dur_len;
+	if (seg_layout(s, &l) < 0) {
+		free(names);
+		return -1;
+	}
+	s->size = l.size;
+
+	err |= write_section(fd, s, sizeof(*s), pos);
+	err |= write_section(fd, names, names_len, pos);
+	err |= write_section(fd, w->boots, (size_t)w->nboots * sizeof(*w->boots), pos);
+	err |= write_section(fd, w->cores, w->ncores * sizeof(*w->cores), pos);
+	err |= write_section(fd, w->name_col, w->nrecords * sizeof(*w->name_col), pos);
+	err |= write_section(fd, w->id_col, w->nrecords * sizeof(*w->id_col), pos);
+	err |= write_section(fd, w->start_col, w->start_len, pos);
+	err |= write_section(fd, w->delta_col, w->delta_len, pos);
+	err |= write_section(fd, w->dur_col, w->dur_len, pos);
+	free(names);
+	return (err || *pos - start != s->size) ? -1 : 0;
+}
+
+/**
+ * @brief Writes the archive image to path.
+ *
+ * The image goes to a temporary file in the same directory first and is
+ * renamed into place, so an interrupted write leaves the old archive.
+ *
+ * @return int 0 on success, -1 on failure.
+ */
+int boot_archive_writer_save(boot_archive_writer_t *w, const char *path)
+{
+	boot_archive_hdr_t h = { 0 };
+	boot_archive_seg_t s;
+	char tmp[4096];
+	uint64_t pos;
+	int fd, err = 0;
+
+	h.magic = BOOT_ARCHIVE_MAGIC;
+	h.version = BOOT_ARCHIVE_VERSION;
+	h.boot_count = w->nboots;
+	h.name_count = w->names.count;
+	h.record_count = w->nrecords;
+	h.core_count = w->ncores;
+	h.time_unit_ns = BOOT_ARCHIVE_TIME_UNIT_NS;
+	h.segment_count = 1;
+	pos = ALIGN8(sizeof(h));
+	h.names_seg_off = w->names.count ? pos : 0;
+
+	if (snprintf(tmp, sizeof(tmp), "%s.tmp.%d", path, (int)getpid()) >= (int)sizeof(tmp)) {
+		fprintf(stderr, "Boot archive path %s too long\n", path);
+		return -1;
+	}
+	fd = open(tmp, O_WRONLY | O_CREAT | O_TRUNC, 0644);
+	if (fd < 0) {
+		perror("Failed to create boot archive");
+		return -1;
+	}
+	err |= write_segment(fd, w, 0, 0, &pos, &s);
+	h.file_size = pos;
+	pos = 0;
+	err |= write_section(fd, &h, sizeof(h), &pos);
+
+	if (err || fsync(fd) < 0) {
+		perror("Failed to write boot archive");
+		close(fd);
+		unlink(tmp);
+		return -1;
+	}
+	close(fd);
+	if (rename(tmp, path) < 0) {
+		perror("Failed to replace boot archive");
+		unlink(tmp);
+		return -1;
+	}
+	return 0;
+}
+
+/*
+ * Opens and locks the archive for an append. If a new file was renamed
+ * over the path meanwhile, e.g. by boot_archive_writer_save(), the lock is
+ * taken again on that file.
+ */
+static int lock_archive(const char *path)
+{
+	struct stat st, cur;
+
+	for (;;) {
+		int fd = open(path, O_RDWR | O_CREAT, 0644);
+
+		if (fd < 0) {
+			perror("Failed to open boot archive");
+			return -1;
+		}
+		if (flock(fd, LOCK_EX) < 0 || fstat(fd, &st) < 0) {
+			perror("Failed to lock boot archive");
+			close(fd);
+			return -1;
+		}
+		if (stat(path, &cur) == 0 && cur.st_dev == st.st_dev && cur.st_ino == st.st_ino)
+			return fd;
+		close(fd);
+	}
+}
+
+/*
+ * Interns the dictionary of the archive open on fd in index order, walking
+ * back the chain of segments that added names.
+ */
+static int load_names(int fd, const boot_archive_hdr_t *h, strtab_t *names)
+{
+	uint64_t *chain = NULL;
+	size_t n = 0, cap = 0;
+	boot_archive_seg_t s;
+	uint8_t *buf = NULL;
+	int ret = -1;
+
+	for (uint64_t off = h->names_seg_off; off; off = s.prev_names_off) {
+		if (off < ALIGN8(sizeof(*h)) || !section_ok(h->file_size, off, sizeof(s)) ||
+				(n && off >= chain[n - 1]) ||
+				grow((void **)&chain, &cap, n + 1, sizeof(*chain)) < 0 ||
+				pread(fd, &s, sizeof(s), off) != sizeof(s))
+			goto out;
+		chain[n++] = off;
+	}
+	while (n--) {
+		seg_layout_t l;
+
+		if (pread(fd, &s, sizeof(s), chain[n]) != sizeof(s) ||
+				s.magic != BOOT_ARCHIVE_SEG_MAGIC || s.first_name != names->count ||
+				seg_layout(&s, &l) < 0 ||
+				!section_ok(h->file_size, chain[n] + l.names, s.names_len))
+			goto out;
+		free(buf);
+		buf = malloc(s.names_len + 1);
+		if (!buf || pread(fd, buf, s.names_len, chain[n] + l.names) != (ssize_t)s.names_len ||
+				!names_ok(buf, s.names_len, s.name_count))
+			goto out;
+		for (uint32_t i = 0; i < s.name_count; i++) {
+			const uint32_t *offs = (const uint32_t *)buf;
+			const char *str = (const char *)(offs + s.name_count + 1) + offs[i];
+
+			if (strtab_intern(names, str, strlen(str)) != s.first_name + i)
+				goto out;
+		}
+	}
+	ret = (names->count == h->name_count) ? 0 : -1;
+out:
+	free(chain);
+	free(buf);
+	return ret;
+}
+
+/**
+ * @brief Appends the boot held in a parser context to an archive file.
+ *
+ * A missing archive is created. The boot is written as a new segment after
+ * the committed end of the file and the header is rewritten last, under
+ * an exclusive lock; the boots already archived are not touched.
+ *
+ * @param path Archive file.
+ * @param ctx Parsed boot.
+ * @param host Host name stored with the boot.
+ * @param timestamp Capture time, seconds since the epoch.
+ * @return int 0 on success, -1 on failure.
+ */
+int boot_archive_append(const char *path, const boot_time_ctx_t *ctx,
+		const char *host, uint64_t timestamp)
+{
+	boot_archive_writer_t w;
+	boot_archive_hdr_t h;
+	boot_archive_seg_t s;
+	struct stat st;
+	uint64_t pos;
+	ssize_t n;
+	int fd, ret = -1;
+
+	fd = lock_archive(path);
+	if (fd < 0)
+		return -1;
+	n = pread(fd, &h, sizeof(h), 0);
+	if (fstat(fd, &st) < 0 || n < 0) {
+		perror("Failed to read boot archive");
+		close(fd);
+		return -1;
+	}
+
+	/* Empty, or the first append was interrupted before its header */
+	if (n == 0 || (n == sizeof(h) && h.magic == 0)) {
+		memset(&h, 0, sizeof(h));
+		h.magic = BOOT_ARCHIVE_MAGIC;
+		h.version = BOOT_ARCHIVE_VERSION;
+		h.time_unit_ns = BOOT_ARCHIVE_TIME_UNIT_NS;
+		h.file_size = ALIGN8(sizeof(h));
+	} else if (n != sizeof(h) || h.magic != BOOT_ARCHIVE_MAGIC ||
+			h.version != BOOT_ARCHIVE_VERSION ||
+			h.time_unit_ns != BOOT_ARCHIVE_TIME_UNIT_NS) {
+		fprintf(stderr, "Unsupported boot archive %s\n", path);
+		close(fd);
+		return -1;
+	} else if (h.file_size < ALIGN8(sizeof(h)) || h.file_size > (uint64_t)st.st_size) {
+		fprintf(stderr, "Corrupt boot archive %s\n", path);
+		close(fd);
+		return -1;
+	}
+
+	boot_archive_writer_init(&w);
+	if (load_names(fd, &h, &w.names) < 0) {
+		fprintf(stderr, "Corrupt boot archive %s\n", path);
+		goto out;
+	}
+	if (boot_archive_writer_add_ctx(&w, ctx, host, timestamp) < 0) {
+		fprintf(stderr, "Out of memory building boot archive\n");
+		goto out;
+	}
+	pos = h.file_size;
+	if (write_segment(fd, &w, h.name_count, h.names_seg_off, &pos, &s) < 0 ||
+			ftruncate(fd, pos) < 0 || fsync(fd) < 0) {
+		perror("Failed to write boot archive");
+		goto out;
+	}
+
+	/* The header commits the segment */
+	if (s.name_count)
+		h.names_seg_off = h.file_size;
+	h.boot_count += s.boot_count;
+	h.name_count += s.name_count;
+	h.record_count += s.record_count;
+	h.core_count += s.core_count;
+	h.segment_count++;
+	h.file_size = pos;
+	if (pwrite(fd, &h, sizeof(h), 0) != sizeof(h) || fsync(fd) < 0) {
+		perror("Failed to write boot archive");
+		goto out;
+	}
+	ret = 0;
+out:
+	boot_archive_writer_free(&w);
+	close(fd);
+	return ret;
+}
@@ -0,0 +1,245 @@
+/*
+ *  Copyright (C) 2025 Texas Instruments Incorporated
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions
+ *  are met:
+ *
+ *    Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *
+ *    Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the
+ *    distribution.
+ *
+ *    Neither the name of Texas Instruments Incorporated nor the names of
+ *    its contributors may be used to endorse or promote products derived
+ *    from this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ *  "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ *  LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ *  A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ *  OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ *  SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ *  LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ *  DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ *  THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ *  (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ *  OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/**
+ * \file boot_archive.h
+ * \brief Versioned, memory mappable columnar archive holding many boots:
+ * a shared stage name dictionary, per-boot summary rows and delta encoded
+ * record columns, in segments that are appended without rewriting the
+ * boots already archived.
+ */
+
+#ifndef BOOT_ARCHIVE_H
+#define BOOT_ARCHIVE_H
+
+/* ========================================================================== */
+/*                           Include Files                                    */
+/* ========================================================================== */
+#include <stdio.h>
+#include <stdint.h>
+#include <stddef.h>
+
+#include "boot_time_report.h"
+#include "record_store.h"
+
+/* ========================================================================== */
+/*                           Macros & Typedefs                                */
+/* ========================================================================== */
+
+#define BOOT_ARCHIVE_MAGIC		0x52415442 /* "BTAR" */
+#define BOOT_ARCHIVE_SEG_MAGIC		0x47455342 /* "BSEG" */
+#define BOOT_ARCHIVE_VERSION		1
+/* Unit of every time stored in the archive, in nanoseconds */
+#define BOOT_ARCHIVE_TIME_UNIT_NS	1u
+
+/* ========================================================================== */
+/*                           Data Structures                                  */
+/* ========================================================================== */
+
+/*
+ * File layout, little endian, every section 8-byte aligned:
+ *
+ *   boot_archive_hdr_t
+ *   segments   one per append, up to file_size
+ *
+ * and each segment:
+ *
+ *   boot_archive_seg_t
+ *   names      uint32_t offsets[name_count + 1], then NUL terminated strings
+ *   boots      boot_archive_boot_t[boot_count]
+ *   cores      boot_archive_core_t[core_count], remote cores of each boot
+ *   name col   uint32_t[record_count], dictionary index per record
+ *   id col     int32_t[record_count], bootstage id or -1
+ *   start col  zigzag varints, start_time minus the previous record's
+ *   delta col  zigzag varints, delta_time
+ *   dur col    varints, accumulated duration (0 for point records)
+ *
+ * The dictionary is shared by the whole archive: a segment only holds the
+ * names first used by its boots, numbered from first_name on. Offsets and
+ * indices in a boot row are relative to its segment.
+ *
+ * An append writes a new segment past file_size and then the header, so
+ * the header is the commit point; bytes past file_size are left by an
+ * interrupted append and are overwritten by the next one.
+ *
+ * Each boot holds its bootloader/kernel records followed by the records of
+ * its remote cores, one core after the other in core table order; the
+ * start_time chain restarts at 0 at the start of each core's run.
+ */
+typedef struct {
+	uint32_t magic;
+	uint32_t version;
+	uint32_t boot_count;
+	uint32_t name_count;
+	uint64_t record_count;
+	uint64_t core_count;
+	uint32_t time_unit_ns;
+	uint32_t segment_count;
+	uint64_t names_seg_off; /* Latest segment adding names, 0 if none */
+	uint64_t file_size; /* Committed length of the archive */
+} boot_archive_hdr_t;
+
+/**
+ * Segment header; the lengths of its sections follow from the counts.
+ */
+typedef struct {
+	uint32_t magic;
+	uint32_t boot_count;
+	uint32_t first_name; /* Dictionary index of the first name added */
+	uint32_t name_count; /* Names added by this segment */
+	uint64_t names_len; /* Offset table and strings */
+	uint64_t prev_names_off; /* Previous segment adding names, 0 if none */
+	uint64_t core_count;
+	uint64_t record_count;
+	uint64_t start_col_len;
+	uint64_t delta_col_len;
+	uint64_t dur_col_len;
+	uint64_t size; /* Whole segment, this header included */
+} boot_archive_seg_t;
+
+/**
+ * Per-boot summary row; the times match boot_summary_t.
+ */
+typedef struct {
+	uint64_t timestamp; /* Capture time, seconds since the epoch */
+	uint64_t ustart_time;
+	uint64_t mcu_start_time;
+	uint64_t uend_time;
+	uint64_t kstart_time;
+	uint64_t kend_time;
+	uint64_t first_record; /* Index of the boot's first record */
+	uint64_t start_off; /* Byte offset of the boot in the start column */
+	uint64_t delta_off; /* Byte offset of the boot in the delta column */
+	uint64_t dur_off; /* Byte offset of the boot in the duration column */
+	uint64_t first_core; /* Index of the boot's first core table entry */
+	uint32_t count; /* Bootloader and kernel records */
+	uint32_t mcu_reccount; /* Records of all remote cores */
+	uint32_t host; /* Dictionary index of the host name */
+	uint32_t core_count; /* Remote cores */
+} boot_archive_boot_t;
+
+/**
+ * Remote core of one boot, see boot_remote_core_t.
+ */
+typedef struct {
+	uint64_t offset;
+	uint32_t label; /* Dictionary index */
+	int32_t anchor_id;
+	uint32_t count; /* Records of this core */
+	uint32_t reserved;
+} boot_archive_core_t;
+
+/**
+ * Core table and record columns of one segment, mapped in place.
+ */
+typedef struct {
+	const boot_archive_core_t *cores;
+	const uint32_t *name_col;
+	const int32_t *id_col;
+	const uint8_t *start_col;
+	const uint8_t *delta_col;
+	const uint8_t *dur_col;
+	uint64_t core_count;
+	uint64_t record_count;
+	uint64_t start_col_len;
+	uint64_t delta_col_len;
+	uint64_t dur_col_len;
+} boot_archive_cols_t;
+
+/**
+ * Read-only view of an archive mapped into memory. The summary rows and
+ * the dictionary are gathered from every segment when it is opened.
+ */
+typedef struct {
+	const uint8_t *map;
+	size_t size;
+	uint32_t boot_count;
+	uint32_t name_count;
+	const char **names;
+	boot_archive_boot_t *boots;
+	uint32_t *boot_seg; /* Segment of each boot */
+	boot_archive_cols_t *segs;
+	uint32_t nsegs;
+} boot_archive_t;
+
+/**
+ * Builds a new archive image in memory before it is written out.
+ */
+typedef struct {
+	arena_t arena;
+	strtab_t names;
+	boot_archive_boot_t *boots;
+	uint32_t nboots;
+	uint32_t boots_cap;
+	boot_archive_core_t *cores;
+	uint64_t ncores;
+	size_t cores_cap;
+	uint32_t *name_col;
+	int32_t *id_col;
+	uint64_t nrecords;
+	uint64_t records_cap;
+	uint8_t *start_col;
+	size_t start_len;
+	size_t start_cap;
+	uint8_t *delta_col;
+	size_t delta_len;
+	size_t delta_cap;
+	uint8_t *dur_col;
+	size_t dur_len;
+	size_t dur_cap;
+} boot_archive_writer_t;
+
+/* ========================================================================== */
+/*                          Function Declarations                             */
+/* ========================================================================== */
+
+int boot_archive_open(boot_archive_t *ar, const char *path);
+void boot_archive_close(boot_archive_t *ar);
+const char *boot_archive_name(const boot_archive_t *ar, uint32_t idx);
+const uint32_t *boot_archive_record_names(const boot_archive_t *ar, uint32_t boot);
+const int32_t *boot_archive_record_ids(const boot_archive_t *ar, uint32_t boot);
+const boot_archive_core_t *boot_archive_boot_cores(const boot_archive_t *ar, uint32_t boot);
+int boot_archive_decode(const boot_archive_t *ar, uint32_t boot,
+		uint64_t *start_time, uint64_t *delta_time, uint64_t *duration);
+void boot_archive_print(const boot_archive_t *ar, boot_time_unit_t unit, FILE *fp);
+
+void boot_archive_writer_init(boot_archive_writer_t *w);
+int boot_archive_writer_add_archive(boot_archive_writer_t *w, const boot_archive_t *ar);
+int boot_archive_writer_add_ctx(boot_archive_writer_t *w, const boot_time_ctx_t *ctx,
+		const char *host, uint64_t timestamp);
+int boot_archive_writer_save(boot_archive_writer_t *w, const char *path);
+void boot_archive_writer_free(boot_archive_writer_t *w);
+
+int boot_archive_append(const char *path, const boot_time_ctx_t *ctx,
+		const char *host, uint64_t timestamp);
+
+#endif /* BOOT_ARCHIVE_H */
@@ -0,0 +1,135 @@
+/*
+ *  Copyright (C) 2025 Texas Instruments Incorporated
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions
+ *  are met:
+ *
+ *    Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *
+ *    Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the
+ *    distribution.
+ *
+ *    Neither the name of Texas Instruments Incorporated nor the names of
+ *    its contributors may be used to endorse or promote products derived
+ *    from this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ *  "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ *  LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ *  A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ *  OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ *  SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ *  LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ *  DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ *  THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ *  (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ *  OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/**
+ * \file boot_capture.c
+ * \brief Loads capture files written by boot_time_capture.
+ */
+
+/* ========================================================================== */
+/*                           Include Files                                    */
+/* ========================================================================== */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include <fcntl.h>
+#include <sys/stat.h>
+
+#include "boot_capture.h"
+
+
+/* ========================================================================== */
+/*                          Function Definitions                              */
+/* ========================================================================== */
+
+/**
+ * @brief Loads a capture file.
+ *
+ * The region sections are copied into a zeroed region of the captured
+ * size, and the kernel line sections are concatenated.
+ *
+ * @param cap Receives the capture; release with boot_capture_free().
+ * @param path Capture file.
+ * @return int 0 on success, -1 on failure.
+ */
+int boot_capture_load(boot_capture_t *cap, const char *path)
+{
+	boot_capture_section_t sec;
+	struct stat st;
+	uint8_t *buf = NULL;
+	size_t pos;
+	int fd;
+
+	memset(cap, 0, sizeof(*cap));
+	fd = open(path, O_RDONLY);
+	if (fd < 0) {
+		perror("Failed to open capture");
+		return -1;
+	}
+	if (fstat(fd, &st) < 0 || (size_t)st.st_size < sizeof(cap->hdr) ||
+			!(buf = malloc(st.st_size)) ||
+			read(fd, buf, st.st_size) != st.st_size) {
+		fprintf(stderr, "Failed to read capture %s\n", path);
+		goto fail;
+	}
+	memcpy(&cap->hdr, buf, sizeof(cap->hdr));
+	if (cap->hdr.magic != BOOT_CAPTURE_MAGIC || cap->hdr.version != BOOT_CAPTURE_VERSION) {
+		fprintf(stderr, "%s is not a boot capture (magic 0x%08x, version %u)\n", path,
+				cap->hdr.magic, cap->hdr.version);
+		goto fail;
+	}
+	cap->region = calloc(1, cap->hdr.region_size ? cap->hdr.region_size : 1);
+	cap->klog = malloc(st.st_size);
+	if (!cap->region || !cap->klog) {
+		fprintf(stderr, "Out of memory loading capture %s\n", path);
+		goto fail;
+	}
+
+	for (pos = sizeof(cap->hdr); pos + sizeof(sec) <= (size_t)st.st_size; ) {
+		memcpy(&sec, buf + pos, sizeof(sec));
+		pos += sizeof(sec);
+		if (sec.len > st.st_size - pos)
+			break; /* Truncated while capturing: keep what is complete */
+		if (sec.type == BOOT_CAPTURE_REGION) {
+			if (sec.offset > cap->hdr.region_size ||
+					sec.len > cap->hdr.region_size - sec.offset) {
+				fprintf(stderr, "Capture %s: region section out of range\n", path);
+				goto fail;
+			}
+			memcpy(cap->region + sec.offset, buf + pos, sec.len);
+		} else if (sec.type == BOOT_CAPTURE_KLOG) {
+			memcpy(cap->klog + cap->klog_len, buf + pos, sec.len);
+			cap->klog_len += sec.len;
+		}
+		pos += sec.len;
+	}
+	free(buf);
+	close(fd);
+	return 0;
+fail:
+	free(buf);
+	close(fd);
+	boot_capture_free(cap);
+	return -1;
+}
+
+/**
+ * @brief Releases a loaded capture.
+ */
+void boot_capture_free(boot_capture_t *cap)
+{
+	free(cap->region);
+	free(cap->klog);
+	memset(cap, 0, sizeof(*cap));
+}
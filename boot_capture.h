@@ -0,0 +1,111 @@
+/*
+ *  Copyright (C) 2025 Texas Instruments Incorporated
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions
+ *  are met:
+ *
+ *    Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *
+ *    Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the
+ *    distribution.
+ *
+ *    Neither the name of Texas Instruments Incorporated nor the names of
+ *    its contributors may be used to endorse or promote products derived
+ *    from this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ *  "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ *  LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ *  A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ *  OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ *  SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ *  LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ *  DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ *  THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ *  (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ *  OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/**
+ * \file boot_capture.h
+ * \brief Compact capture file written early in boot by boot_time_capture
+ * and analyzed later, on the target or on a host: the valid bytes of the
+ * bootstage region plus the kernel tracker lines.
+ */
+
+#ifndef BOOT_CAPTURE_H
+#define BOOT_CAPTURE_H
+
+/* ========================================================================== */
+/*                           Include Files                                    */
+/* ========================================================================== */
+#include <stdint.h>
+#include <stddef.h>
+
+/* ========================================================================== */
+/*                           Macros & Typedefs                                */
+/* ========================================================================== */
+
+#define BOOT_CAPTURE_MAGIC		0x50414342 /* "BCAP" */
+#define BOOT_CAPTURE_VERSION		1
+/* Capture files are picked up from a fleet directory by this suffix */
+#define BOOT_CAPTURE_SUFFIX		".btcap"
+
+/* boot_capture_hdr_t.flags */
+#define BOOT_CAPTURE_KERNEL_END		(1u << 0) /* Kernel lines up to BOOTSTAGE_KERNEL_END */
+#define BOOT_CAPTURE_ALL_LINES		(1u << 1) /* Every kernel line, not just tracker lines */
+
+typedef enum {
+	BOOT_CAPTURE_REGION = 1, /* Bytes of the bootstage region at offset */
+	BOOT_CAPTURE_KLOG, /* Kernel lines in dmesg "[sec.usec] message" format */
+} boot_capture_section_type_t;
+
+/* ========================================================================== */
+/*                           Data Structures                                  */
+/* ========================================================================== */
+
+/*
+ * File layout, native endian:
+ *
+ *   boot_capture_hdr_t
+ *   boot_capture_section_t, followed by len payload bytes, repeated
+ */
+typedef struct {
+	uint32_t magic;
+	uint32_t version;
+	uint32_t flags;
+	uint32_t region_size; /* Size of the bootstage region */
+	uint64_t region_base; /* Physical address of the region */
+	uint64_t capture_ns; /* CLOCK_MONOTONIC when the capture was taken */
+} boot_capture_hdr_t;
+
+typedef struct {
+	uint32_t type;
+	uint32_t offset; /* Region offset of a BOOT_CAPTURE_REGION payload */
+	uint32_t len; /* Payload bytes following the section header */
+	uint32_t reserved;
+} boot_capture_section_t;
+
+/**
+ * Capture file loaded for analysis. Region bytes that were not captured
+ * read as zero.
+ */
+typedef struct {
+	boot_capture_hdr_t hdr;
+	uint8_t *region;
+	char *klog;
+	size_t klog_len;
+} boot_capture_t;
+
+/* ========================================================================== */
+/*                          Function Declarations                             */
+/* ========================================================================== */
+
+int boot_capture_load(boot_capture_t *cap, const char *path);
+void boot_capture_free(boot_capture_t *cap);
+
+#endif /* BOOT_CAPTURE_H */
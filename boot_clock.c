@@ -0,0 +1,141 @@
+/*
+ *  Copyright (C) 2025 Texas Instruments Incorporated
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions
+ *  are met:
+ *
+ *    Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *
+ *    Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the
+ *    distribution.
+ *
+ *    Neither the name of Texas Instruments Incorporated nor the names of
+ *    its contributors may be used to endorse or promote products derived
+ *    from this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ *  "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ *  LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ *  A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ *  OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ *  SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ *  LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ *  DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ *  THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ *  (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ *  OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/**
+ * \file boot_clock.c
+ * \brief Tick to timebase conversion and the least squares offset/drift
+ * fit of a clock domain.
+ */
+
+/* ========================================================================== */
+/*                           Include Files                                    */
+/* ========================================================================== */
+
+#include <math.h>
+
+#include "boot_clock.h"
+
+
+/* ========================================================================== */
+/*                          Function Definitions                              */
+/* ========================================================================== */
+
+/**
+ * @brief Initialises a domain with a nominal frequency and no drift.
+ *
+ * @param dom Domain to initialise.
+ * @param freq_hz Counter frequency, 0 for BOOT_CLOCK_DEFAULT_HZ.
+ * @param epoch_ns Timebase time of tick 0.
+ */
+void boot_clock_init(boot_clock_domain_t *dom, uint64_t freq_hz, double epoch_ns)
+{
+	dom->freq_hz = freq_hz ? freq_hz : BOOT_CLOCK_DEFAULT_HZ;
+	dom->epoch_ns = epoch_ns;
+	dom->drift_ppm = 0;
+}
+
+/* Nominal nanoseconds of a tick count, before drift */
+static double nominal_ns(const boot_clock_domain_t *dom, uint64_t ticks)
+{
+	return (double)ticks * BOOT_CLOCK_NS_PER_SEC / dom->freq_hz;
+}
+
+/**
+ * @brief Places a tick count on the common timebase.
+ *
+ * @return double Nanoseconds since power on.
+ */
+double boot_clock_to_ns(const boot_clock_domain_t *dom, uint64_t ticks)
+{
+	return dom->epoch_ns + nominal_ns(dom, ticks) * (1.0 - dom->drift_ppm * 1e-6);
+}
+
+/**
+ * @brief Fits the epoch and drift of a domain to its sync points.
+ *
+ * With one point only the epoch moves; with two or more, ref = a + b * t
+ * is fitted by least squares over the nominal times t, giving the epoch a
+ * and drift (1 - b). The error bound is the largest residual plus the
+ * resolution of the reference records, widened by the standard error of
+ * the fit when there are more points than parameters.
+ *
+ * @param dom Domain whose frequency is set; epoch and drift are updated.
+ * @param pts Sync points.
+ * @param n Number of points.
+ * @param ref_resolution_ns Resolution of the reference times.
+ * @param fit Receives the fit quality.
+ * @return int 0 on success, -1 if there is no point to fit.
+ */
+int boot_clock_fit(boot_clock_domain_t *dom, const boot_clock_point_t *pts, size_t n,
+		double ref_resolution_ns, boot_clock_fit_t *fit)
+{
+	double mx = 0, my = 0, sxx = 0, sxy = 0, a, b = 1, sse = 0;
+
+	fit->points = 0;
+	fit->max_residual_ns = 0;
+	fit->err_ns = ref_resolution_ns;
+	if (n == 0)
+		return -1;
+
+	for (size_t i = 0; i < n; i++) {
+		mx += nominal_ns(dom, pts[i].ticks);
+		my += pts[i].ref_ns;
+	}
+	mx /= n;
+	my /= n;
+	for (size_t i = 0; i < n; i++) {
+		double dx = nominal_ns(dom, pts[i].ticks) - mx;
+
+		sxx += dx * dx;
+		sxy += dx * (pts[i].ref_ns - my);
+	}
+	/* Points at a single tick value say nothing about drift */
+	if (n > 1 && sxx > 0)
+		b = sxy / sxx;
+	a = my - b * mx;
+
+	for (size_t i = 0; i < n; i++) {
+		double r = pts[i].ref_ns - (a + b * nominal_ns(dom, pts[i].ticks));
+
+		sse += r * r;
+		if (fabs(r) > fit->max_residual_ns)
+			fit->max_residual_ns = fabs(r);
+	}
+
+	dom->epoch_ns = a;
+	dom->drift_ppm = (1.0 - b) * 1e6;
+	fit->points = n;
+	fit->err_ns = fit->max_residual_ns + ref_resolution_ns;
+	if (n > 2)
+		fit->err_ns += sqrt(sse / (n - 2));
+	return 0;
+}
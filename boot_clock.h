@@ -0,0 +1,99 @@
+/*
+ *  Copyright (C) 2025 Texas Instruments Incorporated
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions
+ *  are met:
+ *
+ *    Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *
+ *    Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the
+ *    distribution.
+ *
+ *    Neither the name of Texas Instruments Incorporated nor the names of
+ *    its contributors may be used to endorse or promote products derived
+ *    from this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ *  "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ *  LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ *  A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ *  OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ *  SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ *  LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ *  DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ *  THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ *  (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ *  OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/**
+ * \file boot_clock.h
+ * \brief Clock domains of the boot record sources. Each source counts in
+ * its own ticks from its own epoch; records are placed on the common
+ * timebase (nanoseconds since power on) through an offset and drift fitted
+ * to the sync points seen on both sides.
+ */
+
+#ifndef BOOT_CLOCK_H
+#define BOOT_CLOCK_H
+
+/* ========================================================================== */
+/*                           Include Files                                    */
+/* ========================================================================== */
+#include <stdint.h>
+#include <stddef.h>
+
+/* ========================================================================== */
+/*                           Macros & Typedefs                                */
+/* ========================================================================== */
+
+/* U-Boot bootstage, kernel tracker and MCU profile counters tick in us */
+#define BOOT_CLOCK_DEFAULT_HZ	1000000u
+#define BOOT_CLOCK_NS_PER_SEC	1000000000.0
+
+/* ========================================================================== */
+/*                           Data Structures                                  */
+/* ========================================================================== */
+
+/**
+ * A counter: tick t is at epoch_ns + t * 1e9 / freq_hz on the common
+ * timebase, stretched by drift_ppm.
+ */
+typedef struct {
+	uint64_t freq_hz;
+	double epoch_ns;
+	double drift_ppm; /* Counter runs this much fast (+) or slow (-) */
+} boot_clock_domain_t;
+
+/**
+ * One event seen by both clocks: the counter's tick and the reference
+ * time of the same instant.
+ */
+typedef struct {
+	uint64_t ticks;
+	double ref_ns;
+} boot_clock_point_t;
+
+/**
+ * Result of fitting a domain to its sync points.
+ */
+typedef struct {
+	int points; /* Sync points used, 0 when nothing was fitted */
+	double max_residual_ns; /* Largest distance of a point from the fit */
+	double err_ns; /* Error bound of a placed record */
+} boot_clock_fit_t;
+
+/* ========================================================================== */
+/*                          Function Declarations                             */
+/* ========================================================================== */
+
+void boot_clock_init(boot_clock_domain_t *dom, uint64_t freq_hz, double epoch_ns);
+double boot_clock_to_ns(const boot_clock_domain_t *dom, uint64_t ticks);
+int boot_clock_fit(boot_clock_domain_t *dom, const boot_clock_point_t *pts, size_t n,
+		double ref_resolution_ns, boot_clock_fit_t *fit);
+
+#endif /* BOOT_CLOCK_H */
@@ -0,0 +1,727 @@
+/*
+ *  Copyright (C) 2025 Texas Instruments Incorporated
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions
+ *  are met:
+ *
+ *    Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *
+ *    Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the
+ *    distribution.
+ *
+ *    Neither the name of Texas Instruments Incorporated nor the names of
+ *    its contributors may be used to endorse or promote products derived
+ *    from this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ *  "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ *  LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ *  A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ *  OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ *  SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ *  LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ *  DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ *  THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ *  (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ *  OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/**
+ * \file boot_compare.c
+ * \brief Baseline comparison and latency budget gate. Baseline and
+ * candidate boots are folded into running per-stage mean/variance
+ * accumulators, so comparing against thousands of archived boots costs one
+ * pass over the archive's record columns and no per-boot allocation.
+ */
+
+/* ========================================================================== */
+/*                           Include Files                                    */
+/* ========================================================================== */
+
+#include <stdlib.h>
+#include <string.h>
+#include <ctype.h>
+#include <math.h>
+#include <inttypes.h>
+
+#include "boot_compare.h"
+#include "boot_archive.h"
+
+/* ========================================================================== */
+/*                           Macros & Typedefs                                */
+/* ========================================================================== */
+
+/* Continued fraction limits of the incomplete beta function */
+#define BETACF_ITER	200
+#define BETACF_EPS	1e-12
+#define BETACF_TINY	1e-300
+
+/* Summary rows, as in the fleet report */
+static const char *const summary_names[] = {
+	"SPL Time",
+	"U-Boot Time",
+	"Kernel handoff time",
+	"Kernel Time",
+	"Total Boot Time",
+};
+#define SUMMARY_TOTAL	4
+
+static const char *const domain_titles[FLEET_DOMAINS] = {
+	[FLEET_DOMAIN_SUMMARY] = "Boot Time Summary",
+	[FLEET_DOMAIN_BOOT] = "Bootloader and Kernel Boot Records",
+	[FLEET_DOMAIN_MCU] = "Remote Core Boot Records",
+};
+
+
+/* ========================================================================== */
+/*                          Function Definitions                              */
+/* ========================================================================== */
+
+/**
+ * @brief Initialises an empty comparison.
+ */
+void boot_compare_init(boot_compare_t *cmp)
+{
+	memset(cmp, 0, sizeof(*cmp));
+	arena_init(&cmp->arena);
+	strtab_init(&cmp->names, &cmp->arena);
+}
+
+/**
+ * @brief Releases a comparison.
+ */
+void boot_compare_free(boot_compare_t *cmp)
+{
+	free(cmp->stages);
+	for (int d = 0; d < FLEET_DOMAINS; d++)
+		free(cmp->stage_of[d]);
+	arena_release(&cmp->arena);
+	memset(cmp, 0, sizeof(*cmp));
+}
+
+/*
+ * Returns the stage of (id, name) in a domain for the boot being added:
+ * the first stage of the pair not matched yet by this boot, so the n-th
+ * repetition in a boot meets the n-th in the others. Stages are added on
+ * first sight and chained to the earlier stages of the same name.
+ */
+static boot_compare_stage_t *get_stage_idx(boot_compare_t *cmp, fleet_domain_t domain,
+		uint32_t idx, int32_t id)
+{
+	boot_compare_stage_t *st;
+	int32_t *link;
+	uint32_t nth = 0;
+
+	if (idx >= cmp->nstage_of[domain]) {
+		uint32_t n = cmp->names.cap;
+		int32_t *p = realloc(cmp->stage_of[domain], n * sizeof(*p));
+
+		if (!p)
+			return NULL;
+		for (uint32_t i = cmp->nstage_of[domain]; i < n; i++)
+			p[i] = -1;
+		cmp->stage_of[domain] = p;
+		cmp->nstage_of[domain] = n;
+	}
+	for (link = &cmp->stage_of[domain][idx]; *link >= 0; link = &st->next) {
+		st = &cmp->stages[*link];
+		if (st->id == id && st->seen != cmp->serial) {
+			st->seen = cmp->serial;
+			return st;
+		}
+		nth++;
+	}
+
+	if (cmp->nstages == cmp->stages_cap) {
+		uint32_t n = cmp->stages_cap ? cmp->stages_cap * 2 : 64;
+		boot_compare_stage_t *p = realloc(cmp->stages, n * sizeof(*p));
+
+		if (!p)
+			return NULL;
+		cmp->stages = p;
+		cmp->stages_cap = n;
+		/* link may point into the moved array */
+		link = &cmp->stage_of[domain][idx];
+		while (*link >= 0)
+			link = &cmp->stages[*link].next;
+	}
+	st = &cmp->stages[cmp->nstages];
+	memset(st, 0, sizeof(*st));
+	st->domain = domain;
+	st->name = idx;
+	st->label = idx;
+	st->id = id;
+	st->next = -1;
+	st->seen = cmp->serial;
+	if (nth) {
+		char buf[288];
+		int len = snprintf(buf, sizeof(buf), "%s[%u]", strtab_str(&cmp->names, idx),
+				nth + 1);
+
+		if (len >= (int)sizeof(buf))
+			len = sizeof(buf) - 1;
+		st->label = strtab_intern(&cmp->names, buf, len);
+		if (st->label == STRTAB_NONE)
+			return NULL;
+	}
+	*link = cmp->nstages++;
+	return st;
+}
+
+static boot_compare_stage_t *get_stage(boot_compare_t *cmp, fleet_domain_t domain,
+		const char *name, size_t len, int32_t id)
+{
+	uint32_t idx = strtab_intern(&cmp->names, name, len);
+
+	if (idx == STRTAB_NONE)
+		return NULL;
+	return get_stage_idx(cmp, domain, idx, id);
+}
+
+static void acc_add(boot_compare_acc_t *acc, uint64_t v)
+{
+	double d = (double)v - acc->mean;
+
+	acc->n++;
+	acc->mean += d / acc->n;
+	acc->m2 += d * ((double)v - acc->mean);
+}
+
+static int add_sample(boot_compare_t *cmp, boot_compare_side_t side,
+		fleet_domain_t domain, const char *name, size_t len, int32_t id, uint64_t v)
+{
+	boot_compare_stage_t *st = get_stage(cmp, domain, name, len, id);
+
+	if (!st)
+		return -1;
+	acc_add(&st->acc[side], v);
+	return 0;
+}
+
+/* Adds the summary split of one boot, times in ns */
+static int add_summary(boot_compare_t *cmp, boot_compare_side_t side, uint64_t ustart,
+		uint64_t uend, uint64_t kstart, uint64_t kend)
+{
+	const uint64_t t[] = { 0, ustart, uend, kstart, kend };
+	int n = kend ? 4 : 2;
+
+	for (int i = 0; i < n; i++) {
+		if (t[i + 1] >= t[i] && add_sample(cmp, side, FLEET_DOMAIN_SUMMARY,
+					summary_names[i], strlen(summary_names[i]), RECORD_NO_ID,
+					t[i + 1] - t[i]) < 0)
+			return -1;
+	}
+	if (kend && add_sample(cmp, side, FLEET_DOMAIN_SUMMARY, summary_names[SUMMARY_TOTAL],
+				strlen(summary_names[SUMMARY_TOTAL]), RECORD_NO_ID, kend) < 0)
+		return -1;
+	return 0;
+}
+
+/* Adds one record, prefixing the names of remote cores after the first */
+static int add_record(boot_compare_t *cmp, boot_compare_side_t side,
+		fleet_domain_t domain, const char *prefix, const char *name, int32_t id,
+		uint64_t v)
+{
+	char buf[256];
+	int len;
+
+	if (!prefix)
+		return add_sample(cmp, side, domain, name, strlen(name), id, v);
+	len = snprintf(buf, sizeof(buf), "%s:%s", prefix, name);
+	if (len >= (int)sizeof(buf))
+		len = sizeof(buf) - 1;
+	return add_sample(cmp, side, domain, buf, len, id, v);
+}
+
+/*
+ * Duration of a bootloader/kernel stage: the time since the previous
+ * tracker stage. User milestones and log markers are measured the same
+ * way but do not end a stage themselves, so a marker line between two
+ * tracker stages leaves the second one's duration alone.
+ */
+static uint64_t stage_duration(uint64_t start, int32_t id, uint64_t *prev)
+{
+	uint64_t d = (*prev != UINT64_MAX && start > *prev) ? start - *prev : 0;
+
+	if (id != BOOTSTAGE_USER_MILESTONE && id != BOOTSTAGE_LOG_MARKER)
+		*prev = start;
+	return d;
+}
+
+/**
+ * @brief Adds the boot held in a parser context to one side.
+ *
+ * @return int 0 on success, -1 on allocation failure.
+ */
+int boot_compare_add_ctx(boot_compare_t *cmp, boot_compare_side_t side,
+		const boot_time_ctx_t *ctx)
+{
+	const boot_summary_t *sum = boot_time_summary(ctx);
+	boot_record_columns_t cols;
+	uint64_t prev = UINT64_MAX;
+
+	cmp->serial++;
+	if (add_summary(cmp, side, sum->ustart_time, sum->uend_time, sum->kstart_time,
+				sum->kend_time) < 0)
+		return -1;
+	boot_time_records(ctx, &cols);
+	for (int i = 0; i < cols.count; i++) {
+		if (add_record(cmp, side, FLEET_DOMAIN_BOOT, NULL,
+					boot_time_name(ctx, cols.name[i]), cols.id[i],
+					stage_duration(cols.start_time[i], cols.id[i], &prev)) < 0)
+			return -1;
+	}
+	for (int c = 0; c < boot_time_remote_core_count(ctx); c++) {
+		const char *prefix = c ? boot_time_remote_core(ctx, c)->label : NULL;
+
+		boot_time_remote_records(ctx, c, &cols);
+		for (int i = 0; i < cols.count; i++) {
+			if (add_record(cmp, side, FLEET_DOMAIN_MCU, prefix,
+						boot_time_name(ctx, cols.name[i]), cols.id[i],
+						cols.delta_time[i]) < 0)
+				return -1;
+		}
+	}
+	cmp->boots[side]++;
+	return 0;
+}
+
+/**
+ * @brief Adds every boot of a boot archive to one side.
+ *
+ * Record columns are decoded boot by boot into one reused buffer, and the
+ * archive dictionary is resolved to comparison names once per name.
+ *
+ * @return int 0 on success, -1 on failure.
+ */
+int boot_compare_add_archive(boot_compare_t *cmp, boot_compare_side_t side,
+		const char *path)
+{
+	/* Comparison name index + 1 of each dictionary name */
+	uint32_t *cache = NULL;
+	uint64_t *buf = NULL;
+	size_t buf_cap = 0;
+	boot_archive_t ar;
+	int ret = -1;
+
+	if (boot_archive_open(&ar, path) < 0)
+		return -1;
+	cache = calloc(ar.name_count + 1, sizeof(*cache));
+	if (!cache)
+		goto oom;
+
+	for (uint32_t bi = 0; bi < ar.boot_count; bi++) {
+		const boot_archive_boot_t *b = &ar.boots[bi];
+		const boot_archive_core_t *cores = boot_archive_boot_cores(&ar, bi);
+		const uint32_t *names = boot_archive_record_names(&ar, bi);
+		const int32_t *ids = boot_archive_record_ids(&ar, bi);
+		uint32_t n = b->count + b->mcu_reccount;
+		uint32_t core_end = b->count;
+		uint64_t *start, *delta, prev = UINT64_MAX;
+		int core = -1;
+
+		if ((size_t)n * 3 > buf_cap) {
+			uint64_t *p = realloc(buf, (size_t)n * 3 * sizeof(*p));
+
+			if (!p)
+				goto oom;
+			buf = p;
+			buf_cap = (size_t)n * 3;
+		}
+		start = buf;
+		delta = buf + n;
+		if (!cores || !names || !ids || boot_archive_decode(&ar, bi, start, delta, buf + 2 * n) < 0) {
+			fprintf(stderr, "Corrupt boot %u in archive %s\n", bi, path);
+			goto out;
+		}
+		cmp->serial++;
+		if (add_summary(cmp, side, b->ustart_time, b->uend_time,
+					b->kstart_time, b->kend_time) < 0)
+			goto oom;
+
+		for (uint32_t i = 0; i < n; i++) {
+			const char *name = boot_archive_name(&ar, names[i]);
+			boot_compare_stage_t *st;
+			fleet_domain_t domain;
+			uint64_t v;
+			uint32_t *slot;
+
+			while (i == core_end && core + 1 < (int)b->core_count)
+				core_end += cores[++core].count;
+			domain = (core < 0) ? FLEET_DOMAIN_BOOT : FLEET_DOMAIN_MCU;
+			v = (core < 0) ? stage_duration(start[i], ids[i], &prev) : delta[i];
+			if (core > 0) {
+				if (add_record(cmp, side, domain,
+							boot_archive_name(&ar, cores[core].label),
+							name, ids[i], v) < 0)
+					goto oom;
+				continue;
+			}
+			slot = &cache[names[i] < ar.name_count ? names[i] : ar.name_count];
+			if (!*slot) {
+				uint32_t idx = strtab_intern(&cmp->names, name, strlen(name));
+
+				if (idx == STRTAB_NONE)
+					goto oom;
+				*slot = idx + 1;
+			}
+			st = get_stage_idx(cmp, domain, *slot - 1, ids[i]);
+			if (!st)
+				goto oom;
+			acc_add(&st->acc[side], v);
+		}
+		cmp->boots[side]++;
+	}
+	ret = 0;
+	goto out;
+oom:
+	fprintf(stderr, "Out of memory comparing boots\n");
+out:
+	free(cache);
+	free(buf);
+	boot_archive_close(&ar);
+	return ret;
+}
+
+/* Continued fraction of the regularized incomplete beta function */
+static double betacf(double a, double b, double x)
+{
+	double c = 1, d = 1 - (a + b) * x / (a + 1), h;
+
+	d = 1 / (fabs(d) < BETACF_TINY ? BETACF_TINY : d);
+	h = d;
+	for (int m = 1; m <= BETACF_ITER; m++) {
+		double aa = m * (b - m) * x / ((a + 2 * m - 1) * (a + 2 * m));
+		double del;
+
+		for (int k = 0; k < 2; k++) {
+			d = 1 + aa * d;
+			d = 1 / (fabs(d) < BETACF_TINY ? BETACF_TINY : d);
+			c = 1 + aa / c;
+			if (fabs(c) < BETACF_TINY)
+				c = BETACF_TINY;
+			del = d * c;
+			h *= del;
+			aa = -(a + m) * (a + b + m) * x / ((a + 2 * m) * (a + 2 * m + 1));
+		}
+		if (fabs(del - 1) < BETACF_EPS)
+			break;
+	}
+	return h;
+}
+
+/* Regularized incomplete beta function I_x(a, b) */
+static double incbeta(double a, double b, double x)
+{
+	double front;
+
+	if (x <= 0)
+		return 0;
+	if (x >= 1)
+		return 1;
+	front = exp(lgamma(a + b) - lgamma(a) - lgamma(b) + a * log(x) + b * log(1 - x));
+	if (x < (a + 1) / (a + b + 2))
+		return front * betacf(a, b, x) / a;
+	return 1 - front * betacf(b, a, 1 - x) / b;
+}
+
+/* Two-sided p-value of Student's t with df degrees of freedom */
+static double t_pvalue(double t, double df)
+{
+	return incbeta(df / 2, 0.5, df / (df + t * t));
+}
+
+/*
+ * Tests whether the candidate mean differs from the baseline mean. Two
+ * sample sets use Welch's t-test; a single boot on one side is tested
+ * against the prediction interval of the other side's distribution.
+ */
+static double compare_p(const boot_compare_acc_t *x, const boot_compare_acc_t *y)
+{
+	double vx = (x->n > 1) ? x->m2 / (x->n - 1) : 0;
+	double vy = (y->n > 1) ? y->m2 / (y->n - 1) : 0;
+	double d = y->mean - x->mean;
+	double se, df;
+
+	if (!x->n || !y->n || (x->n < 2 && y->n < 2))
+		return NAN;
+	if (x->n > 1 && y->n > 1) {
+		double a = vx / x->n, b = vy / y->n;
+
+		se = sqrt(a + b);
+		df = (a + b) * (a + b) / ((a > 0 ? a * a / (x->n - 1) : 0) +
+				(b > 0 ? b * b / (y->n - 1) : 0) + 1e-300);
+	} else if (x->n > 1) {
+		se = sqrt(vx * (1 + 1.0 / x->n));
+		df = x->n - 1;
+	} else {
+		se = sqrt(vy * (1 + 1.0 / y->n));
+		df = y->n - 1;
+	}
+	if (se == 0)
+		return (d == 0) ? 1 : 0;
+	return t_pvalue(d / se, df);
+}
+
+/**
+ * @brief Compares one stage of the baseline and the candidate.
+ *
+ * @param cmp Comparison.
+ * @param stage Index into cmp->stages.
+ * @param row Receives the result.
+ */
+void boot_compare_row(const boot_compare_t *cmp, uint32_t stage, boot_compare_row_t *row)
+{
+	const boot_compare_stage_t *st = &cmp->stages[stage];
+	const boot_compare_acc_t *base = &st->acc[BOOT_COMPARE_BASELINE];
+	const boot_compare_acc_t *cand = &st->acc[BOOT_COMPARE_CANDIDATE];
+
+	row->name = strtab_str(&cmp->names, st->label);
+	row->stage = st;
+	row->delta = (base->n && cand->n) ? cand->mean - base->mean : 0;
+	row->p = compare_p(base, cand);
+}
+
+static void print_value(FILE *fp, const boot_compare_acc_t *acc, double div)
+{
+	if (acc->n)
+		fprintf(fp, " %10.1f", acc->mean / div);
+	else
+		fprintf(fp, " %10s", "-");
+}
+
+/**
+ * @brief Prints the per-stage mean durations of both sides, their
+ * difference and its significance.
+ *
+ * Stages whose change is significant at BOOT_COMPARE_ALPHA are marked with
+ * '*'. Stages seen on one side only are listed with '-' for the other.
+ *
+ * @param cmp Comparison.
+ * @param unit Display unit of the times.
+ * @param fp Output stream.
+ */
+void boot_compare_print(const boot_compare_t *cmp, boot_time_unit_t unit, FILE *fp)
+{
+	double div = boot_time_unit_ns(unit);
+
+	fprintf(fp, "--------------------------------------------------------------------\n");
+	fprintf(fp, "                 Boot Comparison\n");
+	fprintf(fp, "--------------------------------------------------------------------\n");
+	fprintf(fp, "Baseline boots          : %" PRIu64 "\n", cmp->boots[BOOT_COMPARE_BASELINE]);
+	fprintf(fp, "Candidate boots         : %" PRIu64 "\n", cmp->boots[BOOT_COMPARE_CANDIDATE]);
+	fprintf(fp, "--------------------------------------------------------------------\n");
+	for (int d = 0; d < FLEET_DOMAINS; d++) {
+		int header = 0;
+
+		for (uint32_t i = 0; i < cmp->nstages; i++) {
+			boot_compare_row_t row;
+
+			if (cmp->stages[i].domain != (fleet_domain_t)d)
+				continue;
+			if (!header) {
+				fprintf(fp, "\n--------------------------------------------------------------------\n");
+				fprintf(fp, "                 %s (duration, %s)\n", domain_titles[d],
+						boot_time_unit_name(unit));
+				fprintf(fp, "--------------------------------------------------------------------\n");
+				fprintf(fp, "%-30s %10s %10s %10s %8s\n", "Stage", "baseline",
+						"candidate", "delta", "p");
+				header = 1;
+			}
+			boot_compare_row(cmp, i, &row);
+			fprintf(fp, "%-30s", row.name);
+			print_value(fp, &row.stage->acc[BOOT_COMPARE_BASELINE], div);
+			print_value(fp, &row.stage->acc[BOOT_COMPARE_CANDIDATE], div);
+			fprintf(fp, " %+10.1f", row.delta / div);
+			if (isnan(row.p))
+				fprintf(fp, " %8s\n", "-");
+			else
+				fprintf(fp, " %8.4f%s\n", row.p, (row.p < BOOT_COMPARE_ALPHA) ? "*" : "");
+		}
+	}
+	fprintf(fp, "--------------------------------------------------------------------\n");
+}
+
+/* Trims leading and trailing white space in place */
+static char *trim(char *s)
+{
+	char *end;
+
+	while (isspace((unsigned char)*s))
+		s++;
+	end = s + strlen(s);
+	while (end > s && isspace((unsigned char)end[-1]))
+		*--end = '\0';
+	return s;
+}
+
+/**
+ * @brief Loads a budget file.
+ *
+ * Each line holds a stage name and a duration limit, e.g.
+ * "BOOTSTAGE_KERNEL_END 2600ms"; the limit is the last word, so summary
+ * rows such as "Kernel Time" may contain spaces. "total" limits the total
+ * boot time and "regression" the significant slowdown of any stage against
+ * the baseline. Limits take the units of boot_time_parse_duration(). '#'
+ * starts a comment.
+ *
+ * @param budget Budget to fill.
+ * @param path Budget file.
+ * @return int 0 on success, -1 on failure.
+ */
+int boot_budget_load(boot_budget_t *budget, const char *path)
+{
+	char line[512];
+	unsigned lineno = 0;
+	FILE *fp;
+
+	memset(budget, 0, sizeof(*budget));
+	fp = fopen(path, "r");
+	if (!fp) {
+		perror("Failed to open budget file");
+		return -1;
+	}
+	while (fgets(line, sizeof(line), fp)) {
+		char *hash = strchr(line, '#');
+		char *s, *limit;
+		uint64_t ns;
+
+		lineno++;
+		if (hash)
+			*hash = '\0';
+		s = trim(line);
+		if (!*s)
+			continue;
+		limit = s + strlen(s);
+		while (limit > s && !isspace((unsigned char)limit[-1]))
+			limit--;
+		if (limit == s || boot_time_parse_duration(limit, &ns) < 0) {
+			fprintf(stderr, "%s:%u: expected <stage> <limit>\n", path, lineno);
+			goto fail;
+		}
+		limit[-1] = '\0';
+		s = trim(s);
+		if (strcmp(s, BOOT_BUDGET_REGRESSION) == 0) {
+			budget->has_regression = 1;
+			budget->regression = ns;
+			continue;
+		}
+		if (budget->count == budget->cap) {
+			size_t n = budget->cap ? budget->cap * 2 : 16;
+			boot_budget_entry_t *p = realloc(budget->entries, n * sizeof(*p));
+
+			if (!p)
+				goto oom;
+			budget->entries = p;
+			budget->cap = n;
+		}
+		budget->entries[budget->count].stage = strdup(s);
+		if (!budget->entries[budget->count].stage)
+			goto oom;
+		budget->entries[budget->count++].limit = ns;
+	}
+	fclose(fp);
+	return 0;
+oom:
+	fprintf(stderr, "%s:%u: out of memory\n", path, lineno);
+fail:
+	fclose(fp);
+	boot_budget_free(budget);
+	return -1;
+}
+
+/**
+ * @brief Releases a budget.
+ */
+void boot_budget_free(boot_budget_t *budget)
+{
+	for (size_t i = 0; i < budget->count; i++)
+		free(budget->entries[i].stage);
+	free(budget->entries);
+	memset(budget, 0, sizeof(*budget));
+}
+
+/*
+ * Finds a stage by label, e.g. "eth-link" or "eth-link[2]" for its second
+ * occurrence, searching the summary, boot and remote domains in turn.
+ */
+static const boot_compare_stage_t *find_stage(const boot_compare_t *cmp, const char *name)
+{
+	for (int d = 0; d < FLEET_DOMAINS; d++) {
+		for (uint32_t i = 0; i < cmp->nstages; i++) {
+			const boot_compare_stage_t *st = &cmp->stages[i];
+
+			if (st->domain == (fleet_domain_t)d &&
+					strcmp(strtab_str(&cmp->names, st->label), name) == 0)
+				return st;
+		}
+	}
+	return NULL;
+}
+
+/**
+ * @brief Checks the candidate boots against a budget.
+ *
+ * Stage limits apply to the candidate's mean stage duration, which is the
+ * duration itself for a single boot. A budgeted stage the candidate never
+ * reached is a violation. With a regression limit, every stage that is
+ * significantly slower than the baseline by more than the limit is one too.
+ *
+ * @param budget Budget from boot_budget_load().
+ * @param cmp Comparison holding the candidate and, optionally, the baseline.
+ * @param unit Display unit of the times.
+ * @param fp Output stream for the report.
+ * @return int Number of violations.
+ */
+int boot_budget_check(const boot_budget_t *budget, const boot_compare_t *cmp,
+		boot_time_unit_t unit, FILE *fp)
+{
+	double div = boot_time_unit_ns(unit);
+	const char *un = boot_time_unit_name(unit);
+	int violations = 0;
+
+	fprintf(fp, "--------------------------------------------------------------------\n");
+	fprintf(fp, "                 Latency Budget\n");
+	fprintf(fp, "--------------------------------------------------------------------\n");
+	fprintf(fp, "%-30s %10s %10s\n", "Stage", "actual", "limit");
+	for (size_t i = 0; i < budget->count; i++) {
+		const boot_budget_entry_t *e = &budget->entries[i];
+		const char *name = strcmp(e->stage, BOOT_BUDGET_TOTAL) ?
+			e->stage : summary_names[SUMMARY_TOTAL];
+		const boot_compare_stage_t *st = find_stage(cmp, name);
+		const boot_compare_acc_t *acc = st ? &st->acc[BOOT_COMPARE_CANDIDATE] : NULL;
+
+		if (!acc || !acc->n) {
+			fprintf(fp, "%-30s %10s %10.1f %s  MISSING\n", e->stage, "-",
+					e->limit / div, un);
+			violations++;
+		} else if (acc->mean > e->limit) {
+			fprintf(fp, "%-30s %10.1f %10.1f %s  OVER\n", e->stage, acc->mean / div,
+					e->limit / div, un);
+			violations++;
+		} else {
+			fprintf(fp, "%-30s %10.1f %10.1f %s  ok\n", e->stage, acc->mean / div,
+					e->limit / div, un);
+		}
+	}
+	if (budget->has_regression && cmp->boots[BOOT_COMPARE_BASELINE]) {
+		for (uint32_t i = 0; i < cmp->nstages; i++) {
+			boot_compare_row_t row;
+
+			boot_compare_row(cmp, i, &row);
+			if (isnan(row.p) || row.p >= BOOT_COMPARE_ALPHA ||
+					row.delta <= (double)budget->regression)
+				continue;
+			fprintf(fp, "%-30s %+10.1f %10.1f %s  REGRESSION (p=%.4f)\n", row.name,
+					row.delta / div, budget->regression / div, un, row.p);
+			violations++;
+		}
+	}
+	fprintf(fp, "Budget violations       : %d\n", violations);
+	fprintf(fp, "--------------------------------------------------------------------\n");
+	return violations;
+}
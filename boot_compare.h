@@ -0,0 +1,158 @@
+/*
+ *  Copyright (C) 2025 Texas Instruments Incorporated
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions
+ *  are met:
+ *
+ *    Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *
+ *    Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the
+ *    distribution.
+ *
+ *    Neither the name of Texas Instruments Incorporated nor the names of
+ *    its contributors may be used to endorse or promote products derived
+ *    from this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ *  "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ *  LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ *  A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ *  OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ *  SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ *  LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ *  DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ *  THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ *  (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ *  OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/**
+ * \file boot_compare.h
+ * \brief Comparison of boots against a stored baseline, and latency budget
+ * checks for CI.
+ */
+
+#ifndef BOOT_COMPARE_H
+#define BOOT_COMPARE_H
+
+/* ========================================================================== */
+/*                           Include Files                                    */
+/* ========================================================================== */
+#include <stdio.h>
+#include <stdint.h>
+#include <stddef.h>
+
+#include "record_store.h"
+#include "boot_time_report.h"
+#include "fleet_batch.h"
+
+/* ========================================================================== */
+/*                           Macros & Typedefs                                */
+/* ========================================================================== */
+
+/* Two-sided p-value below which a stage change counts as significant */
+#define BOOT_COMPARE_ALPHA	0.05
+/* Budget file key of the total boot time */
+#define BOOT_BUDGET_TOTAL	"total"
+/* Budget file key of the allowed significant slowdown of any stage */
+#define BOOT_BUDGET_REGRESSION	"regression"
+
+typedef enum {
+	BOOT_COMPARE_BASELINE,
+	BOOT_COMPARE_CANDIDATE,
+	BOOT_COMPARE_SIDES,
+} boot_compare_side_t;
+
+/* ========================================================================== */
+/*                           Data Structures                                  */
+/* ========================================================================== */
+
+/**
+ * Running mean and variance (Welford) of one stage's duration, in ns.
+ */
+typedef struct {
+	uint64_t n;
+	double mean;
+	double m2;
+} boot_compare_acc_t;
+
+typedef struct {
+	fleet_domain_t domain;
+	uint32_t name; /* boot_compare_t.names index */
+	uint32_t label; /* Name shown, "<name>[<n>]" for the n-th stage of a name */
+	int32_t id; /* Bootstage id, -1 for summary rows and MCU profiles */
+	int32_t next; /* Next stage of the same name, or -1 */
+	uint64_t seen; /* Last boot that matched it, see boot_compare_t.serial */
+	boot_compare_acc_t acc[BOOT_COMPARE_SIDES];
+} boot_compare_stage_t;
+
+/**
+ * Stage durations of the baseline and candidate boots. Stages are matched
+ * by bootstage id, name and occurrence within the boot, in the domains of
+ * the fleet report: the boot summary split, the bootloader/kernel records,
+ * and the remote core records, where cores after the first are prefixed
+ * "<label>:". A stage repeated in a boot, e.g. a log marker, is matched to
+ * the same repetition in the other boots.
+ */
+typedef struct {
+	arena_t arena;
+	strtab_t names;
+	boot_compare_stage_t *stages; /* In first seen order, summary first */
+	uint32_t nstages;
+	uint32_t stages_cap;
+	int32_t *stage_of[FLEET_DOMAINS]; /* Name index to its first stage, or -1 */
+	uint32_t nstage_of[FLEET_DOMAINS];
+	uint64_t boots[BOOT_COMPARE_SIDES];
+	uint64_t serial; /* Boots added to either side */
+} boot_compare_t;
+
+/**
+ * Result of comparing one stage.
+ */
+typedef struct {
+	const char *name; /* Stage label */
+	const boot_compare_stage_t *stage;
+	double delta; /* Candidate minus baseline mean, ns */
+	double p; /* Two-sided p-value, NAN when there are too few samples */
+} boot_compare_row_t;
+
+typedef struct {
+	char *stage; /* Stage key, or BOOT_BUDGET_TOTAL */
+	uint64_t limit; /* ns */
+} boot_budget_entry_t;
+
+/**
+ * Latency budget: per-stage and total duration limits, and an optional
+ * limit on significant slowdowns against the baseline.
+ */
+typedef struct {
+	boot_budget_entry_t *entries;
+	size_t count;
+	size_t cap;
+	int has_regression;
+	uint64_t regression; /* ns */
+} boot_budget_t;
+
+/* ========================================================================== */
+/*                          Function Declarations                             */
+/* ========================================================================== */
+
+void boot_compare_init(boot_compare_t *cmp);
+int boot_compare_add_ctx(boot_compare_t *cmp, boot_compare_side_t side,
+		const boot_time_ctx_t *ctx);
+int boot_compare_add_archive(boot_compare_t *cmp, boot_compare_side_t side,
+		const char *path);
+void boot_compare_row(const boot_compare_t *cmp, uint32_t stage, boot_compare_row_t *row);
+void boot_compare_print(const boot_compare_t *cmp, boot_time_unit_t unit, FILE *fp);
+void boot_compare_free(boot_compare_t *cmp);
+
+int boot_budget_load(boot_budget_t *budget, const char *path);
+int boot_budget_check(const boot_budget_t *budget, const boot_compare_t *cmp,
+		boot_time_unit_t unit, FILE *fp);
+void boot_budget_free(boot_budget_t *budget);
+
+#endif /* BOOT_COMPARE_H */
@@ -0,0 +1,419 @@
+/*
+ *  Copyright (C) 2025 Texas Instruments Incorporated
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions
+ *  are met:
+ *
+ *    Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *
+ *    Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the
+ *    distribution.
+ *
+ *    Neither the name of Texas Instruments Incorporated nor the names of
+ *    its contributors may be used to endorse or promote products derived
+ *    from this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ *  "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ *  LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ *  A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ *  OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ *  SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ *  LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ *  DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ *  THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ *  (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ *  OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/**
+ * \file boot_critical_path.c
+ * \brief Critical path and wait-state attribution over the merged A53 and
+ * remote core timelines.
+ *
+ * Every record is an event. An event is reached after its predecessor on
+ * the same core plus the work in between, and, when it is a sync point
+ * (including the first record of a remote core, released at its anchor),
+ * no earlier than the event it waits for on the other core plus the work
+ * done after the sync. Whichever bound is later is the event's critical
+ * predecessor; following those links back from "system ready" gives the
+ * critical path. The same recurrence replays what-if speedups.
+ */
+
+/* ========================================================================== */
+/*                           Include Files                                    */
+/* ========================================================================== */
+
+#include <stdlib.h>
+#include <string.h>
+#include <strings.h>
+#include <inttypes.h>
+
+#include "boot_critical_path.h"
+
+/* ========================================================================== */
+/*                          Global Variables                                  */
+/* ========================================================================== */
+
+/*
+ * Sync points of the TI boot flow beyond the remote core releases: the MCU
+ * firmware's Linux IPC sync waits for the kernel to come up.
+ */
+const boot_sync_dep_t boot_cp_default_deps[] = {
+	{ "MCU", "IPC_SYNC_FOR_LINUX", "A53", "BOOTSTAGE_KERNEL_END" },
+};
+
+const size_t boot_cp_default_ndeps =
+	sizeof(boot_cp_default_deps) / sizeof(boot_cp_default_deps[0]);
+
+
+/* ========================================================================== */
+/*                          Function Definitions                              */
+/* ========================================================================== */
+
+/**
+ * @brief Returns the name of a core.
+ */
+const char *boot_cp_core_name(const boot_cp_t *cp, int core)
+{
+	return (core >= 0 && core < cp->ncores) ? cp->core_names[core] : "";
+}
+
+static int core_index(const boot_cp_t *cp, const char *name)
+{
+	for (int c = 0; c < cp->ncores; c++)
+		if (strcasecmp(name, cp->core_names[c]) == 0)
+			return c;
+	return -1;
+}
+
+/* First event of a core with the given name, or -1 */
+static int32_t find_event(const boot_cp_t *cp, int core, const char *name)
+{
+	for (int32_t i = 0; i < cp->count; i++)
+		if (cp->events[i].core == core && strcmp(cp->events[i].name, name) == 0)
+			return i;
+	return -1;
+}
+
+static void add_core(boot_cp_t *cp, const boot_time_ctx_t *ctx, int core,
+		const boot_record_columns_t *c)
+{
+	int32_t prev = -1;
+
+	for (int i = 0; i < c->count; i++) {
+		boot_cp_event_t *e = &cp->events[cp->count];
+
+		memset(e, 0, sizeof(*e));
+		e->core = core;
+		e->name = boot_time_name(ctx, c->name[i]);
+		e->time = c->start_time[i];
+		e->pred = prev;
+		e->dep = -1;
+		e->crit = prev;
+		prev = cp->count++;
+	}
+}
+
+/*
+ * Splits the time before each event into work and waiting, and picks the
+ * bound that made it late.
+ */
+static void attribute(boot_cp_t *cp)
+{
+	for (int32_t i = 0; i < cp->count; i++) {
+		boot_cp_event_t *e = &cp->events[i];
+		uint64_t tp = (e->pred >= 0) ? cp->events[e->pred].time : 0;
+		uint64_t t = (e->time > tp) ? e->time : tp;
+
+		if (e->dep < 0) {
+			e->pre = t - tp;
+		} else {
+			uint64_t td = cp->events[e->dep].time;
+
+			if (e->pred < 0 || td >= tp) {
+				/* Idle from the predecessor until the sync source */
+				e->wait = (e->pred < 0) ? 0 : td - tp;
+				e->post = (t > td) ? t - td : 0;
+				e->crit = e->dep;
+			} else {
+				e->pre = t - tp;
+			}
+		}
+		e->work = e->pre + e->post;
+	}
+}
+
+/* Kahn's algorithm over the same-core and sync edges */
+static int topo_sort(boot_cp_t *cp)
+{
+	int32_t n = cp->count, head = 0, tail = 0;
+	int32_t *indeg = calloc(n ? n : 1, sizeof(*indeg));
+	int32_t *first = malloc((n + 1) * sizeof(*first));
+	int32_t *succ = malloc((n ? 2 * n : 1) * sizeof(*succ));
+	int ret = -1;
+
+	cp->order = malloc((n ? n : 1) * sizeof(*cp->order));
+	if (!indeg || !first || !succ || !cp->order)
+		goto out;
+
+	/* Successor lists in CSR form */
+	memset(first, 0, (n + 1) * sizeof(*first));
+	for (int32_t i = 0; i < n; i++) {
+		if (cp->events[i].pred >= 0)
+			first[cp->events[i].pred + 1]++;
+		if (cp->events[i].dep >= 0)
+			first[cp->events[i].dep + 1]++;
+	}
+	for (int32_t i = 0; i < n; i++)
+		first[i + 1] += first[i];
+	for (int32_t i = 0; i < n; i++) {
+		const boot_cp_event_t *e = &cp->events[i];
+		if (e->pred >= 0) {
+			succ[first[e->pred] + indeg[e->pred]++] = i;
+		}
+		if (e->dep >= 0)
+			succ[first[e->dep] + indeg[e->dep]++] = i;
+	}
+	for (int32_t i = 0; i < n; i++)
+		indeg[i] = (cp->events[i].pred >= 0) + (cp->events[i].dep >= 0);
+
+	for (int32_t i = 0; i < n; i++)
+		if (!indeg[i])
+			cp->order[tail++] = i;
+	while (head < tail) {
+		int32_t v = cp->order[head++];
+		for (int32_t k = first[v]; k < first[v + 1]; k++)
+			if (--indeg[succ[k]] == 0)
+				cp->order[tail++] = succ[k];
+	}
+	ret = (tail == n) ? 0 : -1;
+	if (ret < 0)
+		fprintf(stderr, "Sync dependencies form a cycle\n");
+out:
+	free(indeg);
+	free(first);
+	free(succ);
+	return ret;
+}
+
+/**
+ * @brief Builds the merged event graph of a boot and its critical path.
+ *
+ * @param ctx Parsed boot.
+ * @param deps Sync points; unknown stages are ignored.
+ * @param ndeps Number of deps.
+ * @param ready Stage that marks "system ready", or NULL for the last
+ * event of the boot.
+ * @param cp Receives the analysis; release with boot_cp_free().
+ * @return int 0 on success, -1 on failure.
+ */
+int boot_cp_analyze(const boot_time_ctx_t *ctx, const boot_sync_dep_t *deps,
+		size_t ndeps, const char *ready, boot_cp_t *cp)
+{
+	boot_record_columns_t cols[BOOT_CP_CORES_MAX];
+	int32_t n = 0;
+
+	memset(cp, 0, sizeof(*cp));
+	cp->ready = -1;
+	cp->ncores = boot_time_lane_count(ctx);
+	for (int c = 0; c < cp->ncores; c++) {
+		cp->core_names[c] = boot_time_lane_name(ctx, c);
+		boot_time_lane_records(ctx, c, &cols[c]);
+		n += cols[c].count;
+	}
+	if (n == 0) {
+		fprintf(stderr, "No boot records to analyze\n");
+		return -1;
+	}
+	cp->events = malloc(n * sizeof(*cp->events));
+	cp->path = malloc(n * sizeof(*cp->path));
+	if (!cp->events || !cp->path)
+		goto fail;
+	for (int c = 0; c < cp->ncores; c++) {
+		int32_t first = cp->count;
+
+		add_core(cp, ctx, c, &cols[c]);
+		if (c == BOOT_CP_CORE_A53 || first == cp->count)
+			continue;
+		/* A remote core starts when the A53 passes its anchor stage */
+		for (int32_t i = cols[BOOT_CP_CORE_A53].count; i-- > 0; ) {
+			if (cols[BOOT_CP_CORE_A53].id[i] == boot_time_remote_core(ctx, c - 1)->anchor_id) {
+				cp->events[first].dep = i;
+				break;
+			}
+		}
+	}
+
+	for (size_t i = 0; i < ndeps; i++) {
+		int wc = core_index(cp, deps[i].waiter_core);
+		int sc = core_index(cp, deps[i].source_core);
+		int32_t w, s;
+
+		if (wc < 0 || sc < 0)
+			continue;
+		w = find_event(cp, wc, deps[i].waiter);
+		s = find_event(cp, sc, deps[i].source);
+		if (w < 0 || s < 0 || w == s)
+			continue;
+		/* With several sources the latest one binds */
+		if (cp->events[w].dep < 0 || cp->events[s].time > cp->events[cp->events[w].dep].time)
+			cp->events[w].dep = s;
+	}
+	attribute(cp);
+	if (topo_sort(cp) < 0)
+		goto fail;
+
+	for (int32_t i = 0; i < n; i++) {
+		const boot_cp_event_t *e = &cp->events[i];
+
+		if (ready ? strcmp(e->name, ready) == 0 :
+				(cp->ready < 0 || e->time >= cp->events[cp->ready].time))
+			cp->ready = i;
+	}
+	if (cp->ready < 0) {
+		fprintf(stderr, "Ready stage %s not found\n", ready);
+		goto fail;
+	}
+
+	/* Walk the binding predecessors back from system ready */
+	for (int32_t v = cp->ready; v >= 0; v = cp->events[v].crit)
+		cp->path[cp->path_len++] = v;
+	for (int32_t i = 0; i < cp->path_len / 2; i++) {
+		int32_t t = cp->path[i];
+		cp->path[i] = cp->path[cp->path_len - 1 - i];
+		cp->path[cp->path_len - 1 - i] = t;
+	}
+
+	for (int32_t i = 0; i < n; i++) {
+		const boot_cp_event_t *e = &cp->events[i];
+		boot_cp_core_t *c = &cp->cores[e->core];
+
+		if (e->pred < 0)
+			c->off = e->time - e->work;
+		c->work += e->work;
+		c->wait += e->wait;
+	}
+	return 0;
+fail:
+	boot_cp_free(cp);
+	return -1;
+}
+
+/**
+ * @brief Replays the boot with some stages made faster.
+ *
+ * Each event is reached at max(pred + own work, dep + work after sync),
+ * evaluated in topological order, so a speedup only shortens the boot
+ * when it lies on the critical path and no wait on another core absorbs
+ * it.
+ *
+ * @param cp Analysis from boot_cp_analyze().
+ * @param wi Speedups; a stage named more than once is sped up each time.
+ * @param n Number of speedups.
+ * @param ready_time Receives the new system ready time.
+ * @return int 0 on success, -1 on allocation failure.
+ */
+int boot_cp_what_if(const boot_cp_t *cp, const boot_what_if_t *wi, size_t n,
+		uint64_t *ready_time)
+{
+	uint64_t *t = malloc((cp->count ? cp->count : 1) * sizeof(*t));
+
+	if (!t)
+		return -1;
+	for (int32_t k = 0; k < cp->count; k++) {
+		int32_t i = cp->order[k];
+		const boot_cp_event_t *e = &cp->events[i];
+		uint64_t pre = e->pre, post = e->post;
+		uint64_t at;
+
+		for (size_t j = 0; j < n; j++) {
+			if (strcmp(wi[j].stage, e->name) != 0)
+				continue;
+			/* Take the speedup out of the work that ends here */
+			if (pre) {
+				pre = (pre > wi[j].faster) ? pre - wi[j].faster : 0;
+			} else {
+				post = (post > wi[j].faster) ? post - wi[j].faster : 0;
+			}
+		}
+		if (e->pred < 0 && e->dep < 0)
+			at = e->time - e->pre + pre; /* Core start is fixed */
+		else
+			at = (e->pred >= 0) ? t[e->pred] + pre : 0;
+		if (e->dep >= 0 && t[e->dep] + post > at)
+			at = t[e->dep] + post;
+		t[i] = at;
+	}
+	*ready_time = t[cp->ready];
+	free(t);
+	return 0;
+}
+
+/**
+ * @brief Prints the critical path and the work/wait split of each core.
+ *
+ * @param cp Analysis from boot_cp_analyze().
+ * @param unit Display unit of the times.
+ * @param fp Output stream.
+ */
+void boot_cp_print(const boot_cp_t *cp, boot_time_unit_t unit, FILE *fp)
+{
+	const boot_cp_event_t *r = &cp->events[cp->ready];
+	const char *un = boot_time_unit_name(unit);
+
+	fprintf(fp, "--------------------------------------------------------------------\n");
+	fprintf(fp, "                 Critical Path to %s %s\n", boot_cp_core_name(cp, r->core), r->name);
+	fprintf(fp, "--------------------------------------------------------------------\n");
+	for (int32_t k = 0; k < cp->path_len; k++) {
+		const boot_cp_event_t *e = &cp->events[cp->path[k]];
+		uint64_t from = (e->crit >= 0) ? cp->events[e->crit].time : e->time - e->work;
+
+		fprintf(fp, "%-4s %-30s = %6" PRIu64 " %s (+%3" PRIu64 " %s)",
+				boot_cp_core_name(cp, e->core), e->name,
+				boot_time_to_unit(e->time, unit), un,
+				boot_time_to_unit((e->time > from) ? e->time - from : 0, unit), un);
+		if (e->crit >= 0 && e->crit == e->dep)
+			fprintf(fp, " after %s %s", boot_cp_core_name(cp, cp->events[e->dep].core),
+					cp->events[e->dep].name);
+		fprintf(fp, "\n");
+	}
+	fprintf(fp, "System ready            : %" PRIu64 " %s\n",
+			boot_time_to_unit(r->time, unit), un);
+	fprintf(fp, "--------------------------------------------------------------------\n\n");
+	fprintf(fp, "--------------------------------------------------------------------\n");
+	fprintf(fp, "                 Core Time Split\n");
+	fprintf(fp, "--------------------------------------------------------------------\n");
+	for (int c = 0; c < cp->ncores; c++)
+		fprintf(fp, "%-4s: not started %6" PRIu64 " %s, work %6" PRIu64
+				" %s, waiting %6" PRIu64 " %s\n", boot_cp_core_name(cp, c),
+				boot_time_to_unit(cp->cores[c].off, unit), un,
+				boot_time_to_unit(cp->cores[c].work, unit), un,
+				boot_time_to_unit(cp->cores[c].wait, unit), un);
+	for (int32_t i = 0; i < cp->count; i++) {
+		const boot_cp_event_t *e = &cp->events[i];
+
+		if (e->wait)
+			fprintf(fp, "  %s %s waited %" PRIu64 " %s for %s %s\n",
+					boot_cp_core_name(cp, e->core), e->name,
+					boot_time_to_unit(e->wait, unit), un,
+					boot_cp_core_name(cp, cp->events[e->dep].core),
+					cp->events[e->dep].name);
+	}
+	fprintf(fp, "--------------------------------------------------------------------\n");
+}
+
+/**
+ * @brief Releases an analysis.
+ */
+void boot_cp_free(boot_cp_t *cp)
+{
+	free(cp->events);
+	free(cp->order);
+	free(cp->path);
+	memset(cp, 0, sizeof(*cp));
+}
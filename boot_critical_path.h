@@ -0,0 +1,135 @@
+/*
+ *  Copyright (C) 2025 Texas Instruments Incorporated
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions
+ *  are met:
+ *
+ *    Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *
+ *    Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the
+ *    distribution.
+ *
+ *    Neither the name of Texas Instruments Incorporated nor the names of
+ *    its contributors may be used to endorse or promote products derived
+ *    from this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ *  "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ *  LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ *  A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ *  OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ *  SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ *  LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ *  DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ *  THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ *  (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ *  OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/**
+ * \file boot_critical_path.h
+ * \brief Cross-core critical path analysis. The A53 and remote core
+ * timelines are merged into one event graph linked by the known sync points, each
+ * core's time is split into work and waiting, and what-if speedups are
+ * replayed through the graph.
+ */
+
+#ifndef BOOT_CRITICAL_PATH_H
+#define BOOT_CRITICAL_PATH_H
+
+/* ========================================================================== */
+/*                           Include Files                                    */
+/* ========================================================================== */
+#include <stdio.h>
+#include <stdint.h>
+#include <stddef.h>
+
+#include "boot_time_report.h"
+#include "boot_timeline.h"
+
+/* ========================================================================== */
+/*                           Macros & Typedefs                                */
+/* ========================================================================== */
+
+/* Cores are the timeline lanes: the A53, then the remote cores */
+#define BOOT_CP_CORE_A53	BOOT_LANE_A53
+#define BOOT_CP_CORES_MAX	BOOT_LANES_MAX
+
+/* ========================================================================== */
+/*                           Data Structures                                  */
+/* ========================================================================== */
+
+/**
+ * A sync point: the waiter stage on one core cannot complete before the
+ * source stage on another core has been reached. Cores are named "A53" or
+ * by their remote core label, e.g. "MCU".
+ */
+typedef struct {
+	const char *waiter_core;
+	const char *waiter;
+	const char *source_core;
+	const char *source;
+} boot_sync_dep_t;
+
+/**
+ * Hypothetical speedup of the stage ending at the named record.
+ */
+typedef struct {
+	const char *stage;
+	uint64_t faster; /* ns */
+} boot_what_if_t;
+
+/**
+ * One record of the merged timeline.
+ */
+typedef struct {
+	int core;
+	const char *name;
+	uint64_t time; /* Record time, ns */
+	int32_t pred; /* Previous event on the same core, or -1 */
+	int32_t dep; /* Cross-core event waited for, or -1 */
+	int32_t crit; /* Event that bounded this one, or -1 */
+	uint64_t work; /* Own work ending at this event */
+	uint64_t wait; /* Time idle waiting for dep */
+	uint64_t pre; /* Work done before the sync point */
+	uint64_t post; /* Work done after dep was reached */
+} boot_cp_event_t;
+
+typedef struct {
+	uint64_t off; /* Before the core's first record */
+	uint64_t work;
+	uint64_t wait;
+} boot_cp_core_t;
+
+typedef struct {
+	boot_cp_event_t *events;
+	int32_t count;
+	int32_t *order; /* Topological order of events */
+	int32_t ready; /* "System ready" event */
+	int32_t *path; /* Critical path, first event first */
+	int32_t path_len;
+	int ncores;
+	const char *core_names[BOOT_CP_CORES_MAX];
+	boot_cp_core_t cores[BOOT_CP_CORES_MAX];
+} boot_cp_t;
+
+/* ========================================================================== */
+/*                          Function Declarations                             */
+/* ========================================================================== */
+
+extern const boot_sync_dep_t boot_cp_default_deps[];
+extern const size_t boot_cp_default_ndeps;
+
+const char *boot_cp_core_name(const boot_cp_t *cp, int core);
+int boot_cp_analyze(const boot_time_ctx_t *ctx, const boot_sync_dep_t *deps,
+		size_t ndeps, const char *ready, boot_cp_t *cp);
+int boot_cp_what_if(const boot_cp_t *cp, const boot_what_if_t *wi, size_t n,
+		uint64_t *ready_time);
+void boot_cp_print(const boot_cp_t *cp, boot_time_unit_t unit, FILE *fp);
+void boot_cp_free(boot_cp_t *cp);
+
+#endif /* BOOT_CRITICAL_PATH_H */
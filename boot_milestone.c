@@ -0,0 +1,234 @@
+/*
+ *  Copyright (C) 2025 Texas Instruments Incorporated
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions
+ *  are met:
+ *
+ *    Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *
+ *    Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the
+ *    distribution.
+ *
+ *    Neither the name of Texas Instruments Incorporated nor the names of
+ *    its contributors may be used to endorse or promote products derived
+ *    from this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ *  "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ *  LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ *  A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ *  OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ *  SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ *  LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ *  DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ *  THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ *  (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ *  OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/**
+ * \file boot_milestone.c
+ * \brief Shared memory milestone ring.
+ *
+ * Writers claim a slot with a single atomic fetch-and-add on the ring head
+ * and publish it with a release store of its sequence number, so marking
+ * is wait-free: a vDSO clock read, one atomic add and a 64 byte store,
+ * with no system call once the ring is mapped. Readers copy a slot and
+ * keep it only if its sequence number did not change meanwhile, the same
+ * check a seqlock reader makes.
+ */
+
+/* ========================================================================== */
+/*                           Include Files                                    */
+/* ========================================================================== */
+
+#include <stdio.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+
+#include "boot_milestone.h"
+
+/* ========================================================================== */
+/*                          Global Variables                                  */
+/* ========================================================================== */
+
+/* Ring mapped by this process; set once, by whichever thread maps it first */
+static boot_milestone_ring_t *mark_ring;
+/* Set when the ring cannot be mapped, so later marks fail fast */
+static int mark_failed;
+
+
+/* ========================================================================== */
+/*                          Function Definitions                              */
+/* ========================================================================== */
+
+static boot_milestone_ring_t *map_ring(void)
+{
+	boot_milestone_ring_t *ring = MAP_FAILED;
+	struct stat st;
+	uint32_t zero = 0;
+	int fd;
+
+	fd = shm_open(BOOT_MILESTONE_SHM, O_RDWR | O_CREAT, 0666);
+	if (fd < 0)
+		return NULL;
+	/* Growing is idempotent, so racing first writers need no lock */
+	if (fstat(fd, &st) == 0 && (st.st_size >= (off_t)sizeof(*ring) ||
+				ftruncate(fd, sizeof(*ring)) == 0))
+		ring = mmap(NULL, sizeof(*ring), PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+	close(fd);
+	if (ring == MAP_FAILED)
+		return NULL;
+
+	if (__atomic_load_n(&ring->magic, __ATOMIC_ACQUIRE) != BOOT_MILESTONE_MAGIC) {
+		/* Every process writes the same values, so the race is benign */
+		ring->version = BOOT_MILESTONE_VERSION;
+		ring->nslots = BOOT_MILESTONE_SLOTS;
+		ring->slot_size = sizeof(boot_milestone_slot_t);
+		__atomic_compare_exchange_n(&ring->magic, &zero, BOOT_MILESTONE_MAGIC, 0,
+				__ATOMIC_RELEASE, __ATOMIC_RELAXED);
+	}
+	if (ring->magic != BOOT_MILESTONE_MAGIC || ring->version != BOOT_MILESTONE_VERSION ||
+			ring->nslots != BOOT_MILESTONE_SLOTS) {
+		munmap(ring, sizeof(*ring));
+		return NULL;
+	}
+	return ring;
+}
+
+/**
+ * @brief Maps the milestone ring ahead of the first boot_time_mark().
+ *
+ * Optional: boot_time_mark() maps the ring on first use. Calling this
+ * early in main() moves those few system calls off the startup path.
+ *
+ * @return int 0 on success, -1 if the ring cannot be mapped.
+ */
+int boot_time_mark_init(void)
+{
+	boot_milestone_ring_t *ring, *expected = NULL;
+
+	if (__atomic_load_n(&mark_ring, __ATOMIC_ACQUIRE))
+		return 0;
+	if (__atomic_load_n(&mark_failed, __ATOMIC_RELAXED))
+		return -1;
+	ring = map_ring();
+	if (!ring) {
+		__atomic_store_n(&mark_failed, 1, __ATOMIC_RELAXED);
+		return -1;
+	}
+	/* Another thread may have won; keep its mapping */
+	if (!__atomic_compare_exchange_n(&mark_ring, &expected, ring, 0,
+				__ATOMIC_ACQ_REL, __ATOMIC_ACQUIRE))
+		munmap(ring, sizeof(*ring));
+	return 0;
+}
+
+/**
+ * @brief Logs a boot milestone.
+ *
+ * Safe from any thread of any process and from signal handlers once the
+ * ring is mapped. The call never blocks: a milestone that cannot be
+ * logged is dropped.
+ *
+ * @param name Milestone name, truncated to BOOT_MILESTONE_NAME_MAX - 1
+ * characters.
+ * @return int 0 on success, -1 if the ring is unavailable.
+ */
+int boot_time_mark(const char *name)
+{
+	boot_milestone_ring_t *ring = __atomic_load_n(&mark_ring, __ATOMIC_ACQUIRE);
+	boot_milestone_slot_t *s;
+	struct timespec ts;
+	uint64_t ticket;
+	size_t len;
+
+	/* Time stamp first, so mapping the ring is not counted in it */
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+	if (!ring) {
+		if (boot_time_mark_init() < 0)
+			return -1;
+		ring = __atomic_load_n(&mark_ring, __ATOMIC_ACQUIRE);
+	}
+
+	ticket = __atomic_fetch_add(&ring->head, 1, __ATOMIC_RELAXED);
+	s = &ring->slots[ticket % BOOT_MILESTONE_SLOTS];
+	__atomic_store_n(&s->seq, 0, __ATOMIC_RELAXED);
+	__atomic_thread_fence(__ATOMIC_RELEASE);
+	s->time_ns = (uint64_t)ts.tv_sec * 1000000000u + ts.tv_nsec;
+	s->pid = getpid();
+	len = strnlen(name, BOOT_MILESTONE_NAME_MAX - 1);
+	memcpy(s->name, name, len);
+	s->name[len] = '\0';
+	__atomic_store_n(&s->seq, ticket + 1, __ATOMIC_RELEASE);
+	return 0;
+}
+
+/**
+ * @brief Reads the milestones of a ring, oldest first.
+ *
+ * Slots still being written, or overwritten while being copied, are
+ * skipped; the reader never waits for a writer.
+ *
+ * @param path BOOT_MILESTONE_PATH, or a saved copy of the ring.
+ * @param cb Called for every complete milestone.
+ * @param arg Passed to cb.
+ * @return int 0 on success, -1 if the ring cannot be read.
+ */
+int boot_milestone_read(const char *path, boot_milestone_cb_t cb, void *arg)
+{
+	const boot_milestone_ring_t *ring;
+	uint64_t head, first;
+	struct stat st;
+	int fd;
+
+	fd = open(path, O_RDONLY);
+	if (fd < 0) {
+		perror("Failed to open milestone ring");
+		return -1;
+	}
+	if (fstat(fd, &st) < 0 || st.st_size < (off_t)sizeof(*ring)) {
+		fprintf(stderr, "Milestone ring %s too small\n", path);
+		close(fd);
+		return -1;
+	}
+	ring = mmap(NULL, sizeof(*ring), PROT_READ, MAP_SHARED, fd, 0);
+	close(fd);
+	if (ring == MAP_FAILED) {
+		perror("mmap");
+		return -1;
+	}
+	if (ring->magic != BOOT_MILESTONE_MAGIC || ring->version != BOOT_MILESTONE_VERSION ||
+			ring->nslots != BOOT_MILESTONE_SLOTS ||
+			ring->slot_size != sizeof(boot_milestone_slot_t)) {
+		fprintf(stderr, "Unsupported milestone ring %s\n", path);
+		munmap((void *)ring, sizeof(*ring));
+		return -1;
+	}
+
+	head = __atomic_load_n(&ring->head, __ATOMIC_ACQUIRE);
+	first = (head > BOOT_MILESTONE_SLOTS) ? head - BOOT_MILESTONE_SLOTS : 0;
+	for (uint64_t t = first; t < head; t++) {
+		const boot_milestone_slot_t *s = &ring->slots[t % BOOT_MILESTONE_SLOTS];
+		boot_milestone_slot_t copy;
+
+		if (__atomic_load_n(&s->seq, __ATOMIC_ACQUIRE) != t + 1)
+			continue;
+		memcpy(&copy, s, sizeof(copy));
+		__atomic_thread_fence(__ATOMIC_ACQUIRE);
+		if (__atomic_load_n(&s->seq, __ATOMIC_RELAXED) != t + 1)
+			continue;
+		copy.name[BOOT_MILESTONE_NAME_MAX - 1] = '\0';
+		cb(arg, copy.name, copy.time_ns, copy.pid);
+	}
+	munmap((void *)ring, sizeof(*ring));
+	return 0;
+}
@@ -0,0 +1,113 @@
+/*
+ *  Copyright (C) 2025 Texas Instruments Incorporated
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions
+ *  are met:
+ *
+ *    Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *
+ *    Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the
+ *    distribution.
+ *
+ *    Neither the name of Texas Instruments Incorporated nor the names of
+ *    its contributors may be used to endorse or promote products derived
+ *    from this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ *  "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ *  LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ *  A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ *  OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ *  SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ *  LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ *  DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ *  THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ *  (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ *  OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/**
+ * \file boot_milestone.h
+ * \brief User-space boot milestones ("camera_ready", "first frame", ...)
+ * logged by applications into a shared memory ring and read back by the
+ * parser as another record source.
+ *
+ * Applications only need this header and boot_milestone.c (the small
+ * bootmark library); the call never takes a lock or waits for another
+ * writer.
+ */
+
+#ifndef BOOT_MILESTONE_H
+#define BOOT_MILESTONE_H
+
+/* ========================================================================== */
+/*                           Include Files                                    */
+/* ========================================================================== */
+#include <stdint.h>
+
+/* ========================================================================== */
+/*                           Macros & Typedefs                                */
+/* ========================================================================== */
+
+/* POSIX shared memory object of the ring, and where it shows up on Linux */
+#define BOOT_MILESTONE_SHM		"/boot_time_milestones"
+#define BOOT_MILESTONE_PATH		"/dev/shm/boot_time_milestones"
+
+#define BOOT_MILESTONE_MAGIC		0x4b4d5442 /* "BTMK" */
+#define BOOT_MILESTONE_VERSION		1
+/* Ring capacity; once full, the oldest milestones are overwritten */
+#define BOOT_MILESTONE_SLOTS		256
+/* Longest name kept, including the terminating NUL */
+#define BOOT_MILESTONE_NAME_MAX		44
+
+/* ========================================================================== */
+/*                           Data Structures                                  */
+/* ========================================================================== */
+
+/**
+ * One milestone, one cache line. seq is the writer's ticket + 1 once the
+ * slot is complete and 0 while it is being written, so a reader keeps a
+ * slot only when seq reads the same before and after copying it.
+ */
+typedef struct {
+	uint64_t seq;
+	uint64_t time_ns; /* CLOCK_MONOTONIC, the kernel time stamp clock */
+	uint32_t pid;
+	char name[BOOT_MILESTONE_NAME_MAX];
+} boot_milestone_slot_t;
+
+typedef struct {
+	uint32_t magic;
+	uint32_t version;
+	uint32_t nslots;
+	uint32_t slot_size;
+	uint64_t head; /* Next ticket; writers claim slots with one fetch-and-add */
+	uint8_t reserved[40];
+	boot_milestone_slot_t slots[BOOT_MILESTONE_SLOTS];
+} boot_milestone_ring_t;
+
+/**
+ * Called for each complete milestone in the ring, oldest first.
+ *
+ * @param arg Caller context.
+ * @param name Milestone name.
+ * @param time_ns CLOCK_MONOTONIC time of the milestone.
+ * @param pid Process that logged it.
+ */
+typedef void (*boot_milestone_cb_t)(void *arg, const char *name, uint64_t time_ns,
+		uint32_t pid);
+
+/* ========================================================================== */
+/*                          Function Declarations                             */
+/* ========================================================================== */
+
+int boot_time_mark_init(void);
+int boot_time_mark(const char *name);
+
+int boot_milestone_read(const char *path, boot_milestone_cb_t cb, void *arg);
+
+#endif /* BOOT_MILESTONE_H */
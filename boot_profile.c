@@ -0,0 +1,181 @@
+/*
+ *  Copyright (C) 2025 Texas Instruments Incorporated
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions
+ *  are met:
+ *
+ *    Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *
+ *    Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the
+ *    distribution.
+ *
+ *    Neither the name of Texas Instruments Incorporated nor the names of
+ *    its contributors may be used to endorse or promote products derived
+ *    from this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ *  "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ *  LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ *  A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ *  OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ *  SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ *  LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ *  DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ *  THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ *  (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ *  OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/**
+ * \file boot_profile.c
+ * \brief Self-profile of the parser's phases.
+ */
+
+/* ========================================================================== */
+/*                           Include Files                                    */
+/* ========================================================================== */
+
+#include <time.h>
+#include <sys/resource.h>
+
+#include "boot_profile.h"
+
+
+/* ========================================================================== */
+/*                          Function Definitions                              */
+/* ========================================================================== */
+
+static uint64_t clock_ns(clockid_t id)
+{
+	struct timespec t;
+
+	clock_gettime(id, &t);
+	return (uint64_t)t.tv_sec * 1000000000ull + t.tv_nsec;
+}
+
+/**
+ * @brief Starts timing a phase.
+ *
+ * @param prof Profile, or NULL when profiling is off.
+ * @param ctx Context whose counters the phase changes, or NULL.
+ */
+void boot_profile_begin(boot_profile_t *prof, const boot_time_ctx_t *ctx)
+{
+	if (!prof)
+		return;
+	prof->ctx = ctx;
+	if (ctx)
+		boot_time_io_stats(ctx, &prof->io0);
+	else
+		memset(&prof->io0, 0, sizeof(prof->io0));
+	prof->cpu0 = clock_ns(CLOCK_PROCESS_CPUTIME_ID);
+	prof->wall0 = clock_ns(CLOCK_MONOTONIC);
+}
+
+/**
+ * @brief Ends the phase started by boot_profile_begin() and records it.
+ *
+ * @param prof Profile, or NULL when profiling is off.
+ * @param name Phase name.
+ * @param bytes_written Output bytes of the phase, 0 if it wrote none.
+ */
+void boot_profile_end(boot_profile_t *prof, const char *name, uint64_t bytes_written)
+{
+	boot_profile_phase_t *ph;
+	boot_time_io_stats_t io = { 0 };
+	struct rusage ru;
+	uint64_t wall, cpu;
+
+	if (!prof)
+		return;
+	wall = clock_ns(CLOCK_MONOTONIC);
+	cpu = clock_ns(CLOCK_PROCESS_CPUTIME_ID);
+	if (prof->count == BOOT_PROFILE_PHASES_MAX)
+		return;
+	ph = &prof->phases[prof->count++];
+	snprintf(ph->name, sizeof(ph->name), "%s", name);
+	ph->wall_ns = wall - prof->wall0;
+	ph->cpu_ns = cpu - prof->cpu0;
+	if (prof->ctx)
+		boot_time_io_stats(prof->ctx, &io);
+	ph->bytes_read = io.bytes_read - prof->io0.bytes_read;
+	ph->lines = io.lines - prof->io0.lines;
+	/* Records only grow, except when a phase starts without a context */
+	ph->records = (io.records > prof->io0.records) ? io.records - prof->io0.records : 0;
+	ph->bytes_written = bytes_written;
+	ph->peak_rss_kb = (getrusage(RUSAGE_SELF, &ru) == 0) ? (uint64_t)ru.ru_maxrss : 0;
+}
+
+/**
+ * @brief Prints the phase breakdown with a total line.
+ */
+void boot_profile_print(const boot_profile_t *prof, FILE *fp)
+{
+	boot_profile_phase_t total = { .name = "Total" };
+
+	fprintf(fp, "--------------------------------------------------------------------\n");
+	fprintf(fp, "                 Parser Self-Profile\n");
+	fprintf(fp, "--------------------------------------------------------------------\n");
+	fprintf(fp, "%-14s %10s %10s %10s %10s %8s %8s %9s\n", "Phase", "Wall ms", "CPU ms",
+			"Read KB", "Write KB", "Lines", "Records", "RSS KB");
+	for (int i = 0; i <= prof->count; i++) {
+		const boot_profile_phase_t *ph = (i < prof->count) ? &prof->phases[i] : &total;
+
+		fprintf(fp, "%-14s %10.3f %10.3f %10.1f %10.1f %8" PRIu64 " %8" PRIu64
+				" %9" PRIu64 "\n", ph->name, ph->wall_ns / 1e6, ph->cpu_ns / 1e6,
+				ph->bytes_read / 1024.0, ph->bytes_written / 1024.0, ph->lines,
+				ph->records, ph->peak_rss_kb);
+		if (i == prof->count)
+			break;
+		total.wall_ns += ph->wall_ns;
+		total.cpu_ns += ph->cpu_ns;
+		total.bytes_read += ph->bytes_read;
+		total.bytes_written += ph->bytes_written;
+		total.lines += ph->lines;
+		total.records += ph->records;
+		if (ph->peak_rss_kb > total.peak_rss_kb)
+			total.peak_rss_kb = ph->peak_rss_kb;
+	}
+	fprintf(fp, "--------------------------------------------------------------------\n");
+}
+
+/**
+ * @brief Appends the profile to a JSON Lines file, one object per run.
+ *
+ * @param prof Profile.
+ * @param path Output file, created if missing.
+ * @param hostname Host the parser ran on.
+ * @return int 0 on success, -1 on failure.
+ */
+int boot_profile_append_json(const boot_profile_t *prof, const char *path,
+		const char *hostname)
+{
+	FILE *fp = fopen(path, "a");
+
+	if (!fp) {
+		perror("Failed to open profile output");
+		return -1;
+	}
+	fprintf(fp, "{\"host\":\"%s\",\"time\":%lld,\"phases\":[", hostname,
+			(long long)time(NULL));
+	for (int i = 0; i < prof->count; i++) {
+		const boot_profile_phase_t *ph = &prof->phases[i];
+
+		fprintf(fp, "%s{\"name\":\"%s\",\"wall_ns\":%" PRIu64 ",\"cpu_ns\":%" PRIu64
+				",\"bytes_read\":%" PRIu64 ",\"bytes_written\":%" PRIu64
+				",\"lines\":%" PRIu64 ",\"records\":%" PRIu64
+				",\"peak_rss_kb\":%" PRIu64 "}", i ? "," : "", ph->name,
+				ph->wall_ns, ph->cpu_ns, ph->bytes_read, ph->bytes_written,
+				ph->lines, ph->records, ph->peak_rss_kb);
+	}
+	fprintf(fp, "]}\n");
+	if (fclose(fp) != 0) {
+		perror("Failed to write profile output");
+		return -1;
+	}
+	return 0;
+}
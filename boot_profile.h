@@ -0,0 +1,91 @@
+/*
+ *  Copyright (C) 2025 Texas Instruments Incorporated
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions
+ *  are met:
+ *
+ *    Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *
+ *    Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the
+ *    distribution.
+ *
+ *    Neither the name of Texas Instruments Incorporated nor the names of
+ *    its contributors may be used to endorse or promote products derived
+ *    from this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ *  "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ *  LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ *  A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ *  OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ *  SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ *  LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ *  DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ *  THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ *  (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ *  OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/**
+ * \file boot_profile.h
+ * \brief Opt-in self-profile of the parser's own phases: wall and CPU
+ * time, bytes read and written, lines decoded, records produced and peak
+ * RSS. A NULL profile turns every call into a single test, so the probes
+ * stay compiled into production builds.
+ */
+
+#ifndef BOOT_PROFILE_H
+#define BOOT_PROFILE_H
+
+/* ========================================================================== */
+/*                           Include Files                                    */
+/* ========================================================================== */
+#include "boot_time_report.h"
+
+/* ========================================================================== */
+/*                           Macros & Typedefs                                */
+/* ========================================================================== */
+
+#define BOOT_PROFILE_PHASES_MAX		16
+#define BOOT_PROFILE_NAME_MAX		24
+
+/* ========================================================================== */
+/*                           Data Structures                                  */
+/* ========================================================================== */
+
+typedef struct {
+	char name[BOOT_PROFILE_NAME_MAX];
+	uint64_t wall_ns; /* CLOCK_MONOTONIC */
+	uint64_t cpu_ns; /* CLOCK_PROCESS_CPUTIME_ID, all threads */
+	uint64_t bytes_read;
+	uint64_t bytes_written;
+	uint64_t lines;
+	uint64_t records;
+	uint64_t peak_rss_kb; /* Process peak at the end of the phase */
+} boot_profile_phase_t;
+
+typedef struct {
+	boot_profile_phase_t phases[BOOT_PROFILE_PHASES_MAX];
+	int count;
+	/* Phase in progress */
+	const boot_time_ctx_t *ctx;
+	uint64_t wall0;
+	uint64_t cpu0;
+	boot_time_io_stats_t io0;
+} boot_profile_t;
+
+/* ========================================================================== */
+/*                          Function Declarations                             */
+/* ========================================================================== */
+
+void boot_profile_begin(boot_profile_t *prof, const boot_time_ctx_t *ctx);
+void boot_profile_end(boot_profile_t *prof, const char *name, uint64_t bytes_written);
+void boot_profile_print(const boot_profile_t *prof, FILE *fp);
+int boot_profile_append_json(const boot_profile_t *prof, const char *path,
+		const char *hostname);
+
+#endif /* BOOT_PROFILE_H */
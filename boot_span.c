@@ -0,0 +1,226 @@
+/*
+ *  Copyright (C) 2025 Texas Instruments Incorporated
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions
+ *  are met:
+ *
+ *    Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *
+ *    Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the
+ *    distribution.
+ *
+ *    Neither the name of Texas Instruments Incorporated nor the names of
+ *    its contributors may be used to endorse or promote products derived
+ *    from this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ *  "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ *  LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ *  A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ *  OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ *  SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ *  LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ *  DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ *  THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ *  (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ *  OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/**
+ * \file boot_span.c
+ * \brief Builds the span model of a parsed boot. Bootstage records are
+ * points in time, but several of them really describe intervals: known
+ * begin/end id pairs, accumulated stages that carry their own duration,
+ * and the boot phases delimited by the summary markers. The longest
+ * initcalls and probes of an initcall_debug kernel nest in the kernel phase.
+ */
+
+/* ========================================================================== */
+/*                           Include Files                                    */
+/* ========================================================================== */
+
+#include <stdlib.h>
+#include <string.h>
+
+#include "boot_span.h"
+
+/* ========================================================================== */
+/*                           Macros & Typedefs                                */
+/* ========================================================================== */
+
+typedef struct {
+	int begin;
+	int end;
+	const char *name;
+} span_pair_t;
+
+
+/* ========================================================================== */
+/*                          Global Variables                                  */
+/* ========================================================================== */
+
+/* Bootstage ids that open and close an interval */
+static const span_pair_t span_pairs[] = {
+	{ 172, 173, "TPL" },
+	{ 174, 175, "SPL image" },
+	{ 182, 183, "BOOTP" },
+	{ 184, BOOTSTAGE_BOOTM_HANDOFF, "bootm" },
+	{ 188, 189, "Kernel read" },
+	{ 190, 191, "Board init" },
+};
+
+#define SPAN_PAIRS	(sizeof(span_pairs) / sizeof(span_pairs[0]))
+
+static const char *const track_names[BOOT_TRACK_REMOTE] = {
+	[BOOT_TRACK_BOOTLOADER] = "SPL/U-Boot",
+	[BOOT_TRACK_KERNEL] = "Linux",
+	[BOOT_TRACK_USER] = "User space",
+};
+
+
+/* ========================================================================== */
+/*                          Function Definitions                              */
+/* ========================================================================== */
+
+/**
+ * @brief Returns the display name of a track; remote core tracks carry
+ * the core's label.
+ */
+const char *boot_track_name(const boot_time_ctx_t *ctx, boot_track_t track)
+{
+	const boot_remote_core_t *rc;
+
+	if (track < BOOT_TRACK_REMOTE)
+		return track_names[track];
+	rc = boot_time_remote_core(ctx, track - BOOT_TRACK_REMOTE);
+	return rc ? rc->label : "";
+}
+
+static int span_push(boot_span_list_t *l, const char *name, boot_span_kind_t kind,
+		boot_track_t track, int depth, uint64_t start, uint64_t dur)
+{
+	boot_span_t *s;
+
+	if (l->count == l->cap) {
+		size_t cap = l->cap ? l->cap * 2 : 64;
+		boot_span_t *n = realloc(l->spans, cap * sizeof(*n));
+		if (!n)
+			return -1;
+		l->spans = n;
+		l->cap = cap;
+	}
+	s = &l->spans[l->count++];
+	s->name = name;
+	s->kind = kind;
+	s->track = track;
+	s->depth = depth;
+	s->start = start;
+	s->dur = dur;
+	return 0;
+}
+
+static int phase(boot_span_list_t *l, const char *name, boot_track_t track,
+		uint64_t start, uint64_t end)
+{
+	if (end <= start)
+		return 0;
+	return span_push(l, name, BOOT_SPAN_PHASE, track, 0, start, end - start);
+}
+
+/**
+ * @brief Builds the spans of a parsed boot.
+ *
+ * Phases come first, followed by the pair, accumulated and instant spans
+ * in record order, then the kernel calls longest first. Every record yields an instant except accumulated
+ * stages, whose record time is the start of their span.
+ *
+ * @param ctx Parser context.
+ * @param out Receives the spans; release with boot_span_list_free().
+ * @return int 0 on success, -1 on allocation failure.
+ */
+int boot_time_spans(const boot_time_ctx_t *ctx, boot_span_list_t *out)
+{
+	const boot_summary_t *bs = boot_time_summary(ctx);
+	boot_record_columns_t c;
+	const boot_kernel_call_t *kcalls;
+	int nkcalls;
+	uint64_t open[SPAN_PAIRS];
+	int is_open[SPAN_PAIRS] = { 0 };
+	int err = 0;
+
+	memset(out, 0, sizeof(*out));
+
+	/* ---- phases ---- */
+	err |= phase(out, "SPL", BOOT_TRACK_BOOTLOADER, 0, bs->ustart_time);
+	err |= phase(out, "U-Boot", BOOT_TRACK_BOOTLOADER, bs->ustart_time, bs->uend_time);
+	if (bs->kend_time) {
+		err |= phase(out, "Kernel handoff", BOOT_TRACK_KERNEL, bs->uend_time, bs->kstart_time);
+		err |= phase(out, "Kernel", BOOT_TRACK_KERNEL, bs->kstart_time, bs->kend_time);
+	}
+	for (int r = 0; r < boot_time_remote_core_count(ctx); r++) {
+		boot_time_remote_records(ctx, r, &c);
+		if (c.count)
+			err |= phase(out, "Firmware", BOOT_TRACK_REMOTE + r, c.start_time[0],
+					c.start_time[c.count - 1]);
+	}
+
+	/* ---- bootloader and kernel records ---- */
+	boot_time_records(ctx, &c);
+	for (int i = 0; i < c.count && !err; i++) {
+		const char *name = boot_time_name(ctx, c.name[i]);
+		boot_track_t track = (c.id[i] == BOOTSTAGE_USER_MILESTONE) ? BOOT_TRACK_USER :
+			(c.id[i] >= BOOTSTAGE_KERNEL_START) ? BOOT_TRACK_KERNEL : BOOT_TRACK_BOOTLOADER;
+
+		if (c.duration[i]) {
+			err |= span_push(out, name, BOOT_SPAN_ACCUM, track, 1,
+					c.start_time[i], c.duration[i]);
+			continue;
+		}
+		for (size_t p = 0; p < SPAN_PAIRS; p++) {
+			if (c.id[i] == span_pairs[p].begin) {
+				open[p] = c.start_time[i];
+				is_open[p] = 1;
+			} else if (c.id[i] == span_pairs[p].end && is_open[p]) {
+				if (c.start_time[i] >= open[p])
+					err |= span_push(out, span_pairs[p].name, BOOT_SPAN_PAIR,
+							track, 1, open[p], c.start_time[i] - open[p]);
+				is_open[p] = 0;
+			}
+		}
+		err |= span_push(out, name, BOOT_SPAN_INSTANT, track, 1, c.start_time[i], 0);
+	}
+
+	/* ---- initcalls and probes ---- */
+	kcalls = boot_time_kernel_calls(ctx, &nkcalls, NULL);
+	for (int i = 0; i < nkcalls && !err; i++)
+		if (kcalls[i].start_time)
+			err |= span_push(out, boot_time_name(ctx, kcalls[i].name), BOOT_SPAN_CALL,
+					BOOT_TRACK_KERNEL, 1, kcalls[i].start_time, kcalls[i].duration);
+
+	/* ---- remote core records ---- */
+	for (int r = 0; r < boot_time_remote_core_count(ctx) && !err; r++) {
+		boot_time_remote_records(ctx, r, &c);
+		for (int i = 0; i < c.count && !err; i++)
+			err |= span_push(out, boot_time_name(ctx, c.name[i]), BOOT_SPAN_INSTANT,
+					BOOT_TRACK_REMOTE + r, 1, c.start_time[i], 0);
+	}
+
+	if (err) {
+		boot_span_list_free(out);
+		return -1;
+	}
+	return 0;
+}
+
+/**
+ * @brief Releases a span list.
+ */
+void boot_span_list_free(boot_span_list_t *list)
+{
+	free(list->spans);
+	memset(list, 0, sizeof(*list));
+}
@@ -0,0 +1,97 @@
+/*
+ *  Copyright (C) 2025 Texas Instruments Incorporated
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions
+ *  are met:
+ *
+ *    Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *
+ *    Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the
+ *    distribution.
+ *
+ *    Neither the name of Texas Instruments Incorporated nor the names of
+ *    its contributors may be used to endorse or promote products derived
+ *    from this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ *  "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ *  LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ *  A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ *  OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ *  SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ *  LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ *  DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ *  THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ *  (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ *  OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/**
+ * \file boot_span.h
+ * \brief Span model of a boot: instants, begin/end pairs, accumulated
+ * durations and the phases nesting them, placed on per-core tracks.
+ */
+
+#ifndef BOOT_SPAN_H
+#define BOOT_SPAN_H
+
+/* ========================================================================== */
+/*                           Include Files                                    */
+/* ========================================================================== */
+#include <stdint.h>
+#include <stddef.h>
+
+#include "boot_time_report.h"
+
+/* ========================================================================== */
+/*                           Macros & Typedefs                                */
+/* ========================================================================== */
+
+typedef enum {
+	BOOT_SPAN_INSTANT, /* A bootstage mark; dur is 0 */
+	BOOT_SPAN_PAIR, /* Between a begin and its end bootstage id */
+	BOOT_SPAN_ACCUM, /* Accumulated stage, e.g. BOOTSTAGE_ACCUM_DM_F */
+	BOOT_SPAN_PHASE, /* SPL, U-Boot, handoff, kernel or firmware phase */
+	BOOT_SPAN_CALL, /* Initcall or driver probe inside the kernel phase */
+} boot_span_kind_t;
+
+typedef enum {
+	BOOT_TRACK_BOOTLOADER, /* SPL and U-Boot on the A53 */
+	BOOT_TRACK_KERNEL, /* Linux on the A53 */
+	BOOT_TRACK_USER, /* User-space milestones and markers on the A53 */
+	BOOT_TRACK_REMOTE, /* Remote core n is on track BOOT_TRACK_REMOTE + n */
+	BOOT_TRACKS_MAX = BOOT_TRACK_REMOTE + BOOT_REMOTE_CORES_MAX,
+} boot_track_t;
+
+/* ========================================================================== */
+/*                           Data Structures                                  */
+/* ========================================================================== */
+
+typedef struct {
+	const char *name; /* Owned by the parser context or static */
+	boot_span_kind_t kind;
+	boot_track_t track;
+	int depth; /* 0 for phases, 1 for spans and marks inside them */
+	uint64_t start; /* ns */
+	uint64_t dur;
+} boot_span_t;
+
+typedef struct {
+	boot_span_t *spans;
+	size_t count;
+	size_t cap;
+} boot_span_list_t;
+
+/* ========================================================================== */
+/*                          Function Declarations                             */
+/* ========================================================================== */
+
+const char *boot_track_name(const boot_time_ctx_t *ctx, boot_track_t track);
+int boot_time_spans(const boot_time_ctx_t *ctx, boot_span_list_t *out);
+void boot_span_list_free(boot_span_list_t *list);
+
+#endif /* BOOT_SPAN_H */
@@ -0,0 +1,517 @@
+/*
+ *  Copyright (C) 2025 Texas Instruments Incorporated
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions
+ *  are met:
+ *
+ *    Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *
+ *    Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the
+ *    distribution.
+ *
+ *    Neither the name of Texas Instruments Incorporated nor the names of
+ *    its contributors may be used to endorse or promote products derived
+ *    from this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ *  "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ *  LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ *  A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ *  OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ *  SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ *  LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ *  DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ *  THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ *  (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ *  OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/**
+ * \file boot_time_bench.c
+ * \brief Per-phase timings of libboottime on a region image and a kernel
+ * log, usually made by boot_time_gen.
+ *
+ * Each phase (region decode, log scan, kernel log parse, clock sync and
+ * timeline merge, text, HTML and trace export) runs a number of times
+ * after one warm-up run. The tool prints percentiles and throughput, and
+ * can write them as "phase" lines that diff cleanly between commits and
+ * can be compared with a previous run through --baseline.
+ */
+
+/* ========================================================================== */
+/*                           Include Files                                    */
+/* ========================================================================== */
+
+#include <getopt.h>
+#include <time.h>
+#include <limits.h>
+#include <sys/stat.h>
+
+#include "boot_time_report.h"
+#include "kernel_log_scan.h"
+#include "boot_timeline.h"
+
+/* ========================================================================== */
+/*                           Macros & Typedefs                                */
+/* ========================================================================== */
+
+#define BENCH_RUNS_DEFAULT	20
+#define BENCH_PHASES_MAX	16
+#define BENCH_NAME_MAX		32
+
+/* ========================================================================== */
+/*                           Data Structures                                  */
+/* ========================================================================== */
+
+typedef struct {
+	const char *region_path;
+	const char *log_path;
+	void *region; /* Region image read into memory */
+	size_t region_len;
+	const char *log; /* Mapped kernel log */
+	size_t log_len;
+	int threads;
+	int calls; /* initcall_debug top, 0 to skip */
+	boot_remote_core_t remote[BOOT_REMOTE_CORES_MAX];
+	int nremote;
+	boot_time_ctx_t *ctx; /* Fully parsed boot for the later phases */
+	char out_dir[PATH_MAX]; /* Exports are written here and removed */
+} bench_t;
+
+typedef struct {
+	const char *name;
+	/* Runs the phase once; returns the bytes and items it handled, or -1 */
+	int (*run)(bench_t *b, uint64_t *bytes, uint64_t *items);
+	int needs_log;
+} bench_phase_t;
+
+typedef struct {
+	char name[BENCH_NAME_MAX];
+	uint64_t p50_ns;
+} bench_baseline_t;
+
+/* ========================================================================== */
+/*                          Function Definitions                              */
+/* ========================================================================== */
+
+static uint64_t now_ns(void)
+{
+	struct timespec t;
+
+	clock_gettime(CLOCK_MONOTONIC, &t);
+	return (uint64_t)t.tv_sec * 1000000000ull + t.tv_nsec;
+}
+
+static boot_time_ctx_t *bench_ctx(const bench_t *b)
+{
+	boot_time_ctx_t *ctx = boot_time_ctx_create();
+
+	if (!ctx)
+		return NULL;
+	boot_time_set_jobs(ctx, b->threads);
+	boot_time_set_log_index(ctx, BOOT_TIME_LOG_INDEX_NONE);
+	boot_time_set_kernel_calls(ctx, b->calls);
+	if (b->nremote)
+		boot_time_set_remote_cores(ctx, b->remote, b->nremote);
+	return ctx;
+}
+
+static uint64_t ctx_records(const boot_time_ctx_t *ctx)
+{
+	boot_record_columns_t cols;
+	uint64_t n;
+
+	boot_time_records(ctx, &cols);
+	n = cols.count;
+	for (int c = 0; c < boot_time_remote_core_count(ctx); c++) {
+		boot_time_remote_records(ctx, c, &cols);
+		n += cols.count;
+	}
+	return n;
+}
+
+static int phase_region(bench_t *b, uint64_t *bytes, uint64_t *items)
+{
+	boot_time_ctx_t *ctx = bench_ctx(b);
+	int ret;
+
+	if (!ctx)
+		return -1;
+	ret = boot_time_read_bootstage_buffer(ctx, b->region, b->region_len);
+	*bytes = 0;
+	*items = ctx_records(ctx);
+	boot_time_ctx_destroy(ctx);
+	return (ret == EXIT_SUCCESS) ? 0 : -1;
+}
+
+static int phase_scan(bench_t *b, uint64_t *bytes, uint64_t *items)
+{
+	kernel_log_scan_result_t res = { 0 };
+	int ret;
+
+	res.call_top = b->calls;
+	ret = kernel_log_scan_buffer(b->log, b->log_len, 0, b->threads, &res);
+	*bytes = b->log_len;
+	*items = res.count + res.call_lines;
+	kernel_log_scan_free(&res);
+	return ret;
+}
+
+static int phase_kernel_log(bench_t *b, uint64_t *bytes, uint64_t *items)
+{
+	boot_time_ctx_t *ctx = bench_ctx(b);
+
+	if (!ctx)
+		return -1;
+	boot_time_read_kernel_log(ctx, b->log_path);
+	*bytes = b->log_len;
+	*items = ctx_records(ctx);
+	boot_time_ctx_destroy(ctx);
+	return 0;
+}
+
+static int phase_merge(bench_t *b, uint64_t *bytes, uint64_t *items)
+{
+	boot_timeline_t tl;
+
+	boot_time_sync_clocks(b->ctx);
+	if (boot_time_timeline(b->ctx, &tl) < 0)
+		return -1;
+	*bytes = 0;
+	*items = tl.count;
+	boot_timeline_free(&tl);
+	return 0;
+}
+
+static int phase_text(bench_t *b, uint64_t *bytes, uint64_t *items)
+{
+	FILE *fp = fopen("/dev/null", "w");
+
+	if (!fp)
+		return -1;
+	boot_time_print_report(b->ctx, fp, "bench");
+	*bytes = ftello(fp);
+	*items = ctx_records(b->ctx);
+	fclose(fp);
+	return 0;
+}
+
+/* Size of an export, which is then removed */
+static int export_size(const char *path, uint64_t *bytes)
+{
+	struct stat st;
+
+	if (stat(path, &st) < 0)
+		return -1;
+	*bytes = st.st_size;
+	unlink(path);
+	return 0;
+}
+
+/* Path of an export in the output directory, -1 if it does not fit */
+static int export_path(const bench_t *b, const char *name, char *path, size_t len)
+{
+	int n = snprintf(path, len, "%s/%s", b->out_dir, name);
+
+	if (n < 0 || (size_t)n >= len) {
+		fprintf(stderr, "Export path in %s too long\n", b->out_dir);
+		return -1;
+	}
+	return 0;
+}
+
+static int phase_html(bench_t *b, uint64_t *bytes, uint64_t *items)
+{
+	char path[PATH_MAX];
+
+	if (export_path(b, "bench.html", path, sizeof(path)) < 0)
+		return -1;
+	if (boot_time_export_html(b->ctx, path, "bench") < 0)
+		return -1;
+	*items = ctx_records(b->ctx);
+	return export_size(path, bytes);
+}
+
+static int phase_trace(bench_t *b, uint64_t *bytes, uint64_t *items)
+{
+	char path[PATH_MAX];
+
+	if (export_path(b, "bench.json", path, sizeof(path)) < 0)
+		return -1;
+	if (boot_time_export_trace(b->ctx, path, "bench") < 0)
+		return -1;
+	*items = ctx_records(b->ctx);
+	return export_size(path, bytes);
+}
+
+static const bench_phase_t phases[] = {
+	{ "region_decode", phase_region, 0 },
+	{ "log_scan", phase_scan, 1 },
+	{ "kernel_log", phase_kernel_log, 1 },
+	{ "merge", phase_merge, 0 },
+	{ "text_export", phase_text, 0 },
+	{ "html_export", phase_html, 0 },
+	{ "trace_export", phase_trace, 0 },
+};
+#define BENCH_NPHASES	(sizeof(phases) / sizeof(phases[0]))
+
+static int cmp_u64(const void *a, const void *b)
+{
+	uint64_t x = *(const uint64_t *)a, y = *(const uint64_t *)b;
+
+	return (x > y) - (x < y);
+}
+
+/* Nearest rank percentile of sorted samples */
+static uint64_t percentile(const uint64_t *v, int n, int pct)
+{
+	int rank = (pct * n + 99) / 100;
+
+	return v[(rank > 0) ? rank - 1 : 0];
+}
+
+/* Reads the p50 of every phase line of a previous results file */
+static int load_baseline(const char *path, bench_baseline_t *base, int max)
+{
+	char line[512];
+	int n = 0;
+	FILE *fp = fopen(path, "r");
+
+	if (!fp) {
+		perror("Failed to open bench baseline");
+		return -1;
+	}
+	while (n < max && fgets(line, sizeof(line), fp)) {
+		const char *p = strstr(line, " p50_ns=");
+
+		if (strncmp(line, "phase ", 6) != 0 || !p ||
+				sscanf(line + 6, "%31s", base[n].name) != 1)
+			continue;
+		base[n].p50_ns = strtoull(p + 8, NULL, 10);
+		n++;
+	}
+	fclose(fp);
+	return n;
+}
+
+static const bench_baseline_t *find_baseline(const bench_baseline_t *base, int n,
+		const char *name)
+{
+	for (int i = 0; i < n; i++)
+		if (strcmp(base[i].name, name) == 0)
+			return &base[i];
+	return NULL;
+}
+
+static int load_inputs(bench_t *b)
+{
+	struct stat st;
+	FILE *fp;
+	int fd;
+
+	fp = fopen(b->region_path, "rb");
+	if (!fp || fstat(fileno(fp), &st) < 0) {
+		perror("Failed to open region image");
+		if (fp)
+			fclose(fp);
+		return -1;
+	}
+	b->region_len = st.st_size;
+	b->region = malloc(b->region_len ? b->region_len : 1);
+	if (!b->region || fread(b->region, 1, b->region_len, fp) != b->region_len) {
+		perror("Failed to read region image");
+		fclose(fp);
+		return -1;
+	}
+	fclose(fp);
+
+	if (!b->log_path)
+		return 0;
+	fd = open(b->log_path, O_RDONLY);
+	if (fd < 0 || fstat(fd, &st) < 0) {
+		perror("Failed to open kernel log");
+		if (fd >= 0)
+			close(fd);
+		return -1;
+	}
+	b->log_len = st.st_size;
+	b->log = (b->log_len == 0) ? "" :
+		mmap(NULL, b->log_len, PROT_READ, MAP_PRIVATE, fd, 0);
+	close(fd);
+	if (b->log == MAP_FAILED) {
+		perror("mmap");
+		return -1;
+	}
+	return 0;
+}
+
+static void usage(const char *prog)
+{
+	fprintf(stderr,
+		"Usage: %s -d <region image> [-l <kernel log>] [options]\n"
+		"  -d, --dump <file>   bootstage region image, e.g. from boot_time_gen\n"
+		"  -l, --log <file>    kernel log; log phases are skipped without one\n"
+		"  -n, --runs <n>      timed runs per phase after one warm-up (default %d)\n"
+		"  -j, --jobs <n>      log scan threads (default: all CPUs)\n"
+		"  -c, --initcalls <n>  also keep the n slowest initcalls (default 0)\n"
+		"      --remote-core <label@offset[:anchor id]>  remote core block; repeat\n"
+		"                      for each core (default MCU@0x80000:176)\n"
+		"  -o, --output <file>  also write the results, one line per phase\n"
+		"      --baseline <file>  compare the median of each phase with an\n"
+		"                      earlier --output file\n"
+		"  -h, --help          show this help\n",
+		prog, BENCH_RUNS_DEFAULT);
+}
+
+int main(int argc, char *argv[])
+{
+	static const struct option long_opts[] = {
+		{ "dump", required_argument, NULL, 'd' },
+		{ "log", required_argument, NULL, 'l' },
+		{ "runs", required_argument, NULL, 'n' },
+		{ "jobs", required_argument, NULL, 'j' },
+		{ "initcalls", required_argument, NULL, 'c' },
+		{ "remote-core", required_argument, NULL, 'M' },
+		{ "output", required_argument, NULL, 'o' },
+		{ "baseline", required_argument, NULL, 'B' },
+		{ "help", no_argument, NULL, 'h' },
+		{ NULL, 0, NULL, 0 }
+	};
+	bench_t b = { 0 };
+	bench_baseline_t base[BENCH_PHASES_MAX];
+	const char *out_path = NULL, *base_path = NULL;
+	const char *tmp = getenv("TMPDIR");
+	int runs = BENCH_RUNS_DEFAULT, nbase = 0;
+	uint64_t *samples;
+	FILE *out = NULL;
+	int opt, ret = EXIT_SUCCESS;
+
+	while ((opt = getopt_long(argc, argv, "d:l:n:j:c:o:h", long_opts, NULL)) != -1) {
+		switch (opt) {
+		case 'd':
+			b.region_path = optarg;
+			break;
+		case 'l':
+			b.log_path = optarg;
+			break;
+		case 'n':
+			runs = atoi(optarg);
+			break;
+		case 'j':
+			b.threads = atoi(optarg);
+			break;
+		case 'c':
+			b.calls = atoi(optarg);
+			break;
+		case 'M':
+			if (b.nremote == BOOT_REMOTE_CORES_MAX ||
+					boot_time_parse_remote_core(optarg, &b.remote[b.nremote]) < 0) {
+				fprintf(stderr, "Bad or too many --remote-core options\n");
+				return EXIT_FAILURE;
+			}
+			b.nremote++;
+			break;
+		case 'o':
+			out_path = optarg;
+			break;
+		case 'B':
+			base_path = optarg;
+			break;
+		case 'h':
+			usage(argv[0]);
+			return EXIT_SUCCESS;
+		default:
+			usage(argv[0]);
+			return EXIT_FAILURE;
+		}
+	}
+	if (!b.region_path || runs <= 0) {
+		usage(argv[0]);
+		return EXIT_FAILURE;
+	}
+	if (base_path && (nbase = load_baseline(base_path, base, BENCH_PHASES_MAX)) < 0)
+		return EXIT_FAILURE;
+	if (load_inputs(&b) < 0)
+		return EXIT_FAILURE;
+	snprintf(b.out_dir, sizeof(b.out_dir), "%s", tmp ? tmp : P_tmpdir);
+
+	/* The export phases share one fully parsed boot */
+	b.ctx = bench_ctx(&b);
+	samples = malloc(runs * sizeof(*samples));
+	if (!b.ctx || !samples) {
+		perror("malloc");
+		return EXIT_FAILURE;
+	}
+	boot_time_read_bootstage_buffer(b.ctx, b.region, b.region_len);
+	if (b.log_path)
+		boot_time_read_kernel_log(b.ctx, b.log_path);
+	boot_time_sync_clocks(b.ctx);
+
+	if (out_path) {
+		out = fopen(out_path, "w");
+		if (!out) {
+			perror("Failed to write bench results");
+			return EXIT_FAILURE;
+		}
+		fprintf(out, "# boot_time_bench region=%s log=%s log_bytes=%zu runs=%d jobs=%d\n",
+				b.region_path, b.log_path ? b.log_path : "-", b.log_len, runs, b.threads);
+	}
+
+	printf("%-14s %5s %10s %10s %10s %10s %10s %12s%s\n", "phase", "runs",
+			"min us", "p50 us", "p90 us", "p99 us", "max us", "throughput",
+			nbase ? "   vs base" : "");
+	for (size_t i = 0; i < BENCH_NPHASES; i++) {
+		const bench_phase_t *ph = &phases[i];
+		const bench_baseline_t *bl;
+		uint64_t bytes = 0, items = 0, p50;
+		char rate[32];
+
+		if (ph->needs_log && !b.log_path)
+			continue;
+		if (ph->run(&b, &bytes, &items) < 0) {
+			fprintf(stderr, "Phase %s failed\n", ph->name);
+			ret = EXIT_FAILURE;
+			continue;
+		}
+		for (int r = 0; r < runs; r++) {
+			uint64_t t0 = now_ns();
+			ph->run(&b, &bytes, &items);
+			samples[r] = now_ns() - t0;
+		}
+		qsort(samples, runs, sizeof(*samples), cmp_u64);
+		p50 = percentile(samples, runs, 50);
+		if (bytes)
+			snprintf(rate, sizeof(rate), "%.1f MB/s", bytes / (p50 / 1e9) / 1e6);
+		else
+			snprintf(rate, sizeof(rate), "%.2f M/s", items / (p50 / 1e9) / 1e6);
+		printf("%-14s %5d %10.1f %10.1f %10.1f %10.1f %10.1f %12s", ph->name, runs,
+				samples[0] / 1e3, p50 / 1e3, percentile(samples, runs, 90) / 1e3,
+				percentile(samples, runs, 99) / 1e3, samples[runs - 1] / 1e3, rate);
+		bl = find_baseline(base, nbase, ph->name);
+		if (bl && bl->p50_ns)
+			printf("   %+7.1f%%", 100.0 * ((double)p50 - bl->p50_ns) / bl->p50_ns);
+		printf("\n");
+		if (out)
+			fprintf(out, "phase %s runs=%d bytes=%" PRIu64 " items=%" PRIu64
+					" min_ns=%" PRIu64 " p50_ns=%" PRIu64 " p90_ns=%" PRIu64
+					" p99_ns=%" PRIu64 " max_ns=%" PRIu64 "\n",
+					ph->name, runs, bytes, items, samples[0], p50,
+					percentile(samples, runs, 90), percentile(samples, runs, 99),
+					samples[runs - 1]);
+	}
+
+	if (out && fclose(out) != 0) {
+		perror("Failed to write bench results");
+		ret = EXIT_FAILURE;
+	}
+	boot_time_ctx_destroy(b.ctx);
+	free(samples);
+	free(b.region);
+	if (b.log_len)
+		munmap((void *)b.log, b.log_len);
+	return ret;
+}
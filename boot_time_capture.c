@@ -0,0 +1,408 @@
+/*
+ *  Copyright (C) 2025 Texas Instruments Incorporated
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions
+ *  are met:
+ *
+ *    Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *
+ *    Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the
+ *    distribution.
+ *
+ *    Neither the name of Texas Instruments Incorporated nor the names of
+ *    its contributors may be used to endorse or promote products derived
+ *    from this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ *  "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ *  LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ *  A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ *  OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ *  SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ *  LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ *  DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ *  THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ *  (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ *  OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/**
+ * \file boot_time_capture.c
+ * \brief Minimal early boot capture tool, e.g. for an initramfs hook. It
+ * snapshots the valid bytes of the bootstage region and the kernel tracker
+ * lines into one capture file and exits; reports are made later from the
+ * file with boot_time_report_parser --capture. Nothing is allocated on the
+ * heap, and the tool is linked statically so it runs before the rootfs.
+ */
+
+/* ========================================================================== */
+/*                           Include Files                                    */
+/* ========================================================================== */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <errno.h>
+#include <time.h>
+#include <unistd.h>
+#include <fcntl.h>
+#include <sys/stat.h>
+
+#include "boot_time_report.h"
+#include "bootstage_source.h"
+#include "bootstage_layout.h"
+#include "boot_capture.h"
+#include "kernel_log_scan.h"
+#include "kmsg_source.h"
+
+/* ========================================================================== */
+/*                           Macros & Typedefs                                */
+/* ========================================================================== */
+
+#define CAPTURE_DEFAULT_PATH	"/run/boot_time" BOOT_CAPTURE_SUFFIX
+#define CAPTURE_OUT_BUF		(64u << 10)
+#define CAPTURE_LINE_MAX	1024
+
+typedef struct {
+	int fd;
+	off_t pos; /* File offset of out[0] */
+	size_t len;
+	int err;
+} capture_out_t;
+
+
+/* ========================================================================== */
+/*                          Global Variables                                  */
+/* ========================================================================== */
+
+static char out_buf[CAPTURE_OUT_BUF];
+static char in_buf[CAPTURE_OUT_BUF];
+
+
+/* ========================================================================== */
+/*                          Function Definitions                              */
+/* ========================================================================== */
+
+static void out_flush(capture_out_t *o)
+{
+	if (o->len && !o->err &&
+			pwrite(o->fd, out_buf, o->len, o->pos) != (ssize_t)o->len)
+		o->err = -1;
+	o->pos += o->len;
+	o->len = 0;
+}
+
+static void out_write(capture_out_t *o, const void *p, size_t n)
+{
+	if (o->len + n > sizeof(out_buf))
+		out_flush(o);
+	if (n > sizeof(out_buf)) {
+		if (!o->err && pwrite(o->fd, p, n, o->pos) != (ssize_t)n)
+			o->err = -1;
+		o->pos += n;
+		return;
+	}
+	memcpy(out_buf + o->len, p, n);
+	o->len += n;
+}
+
+static off_t out_tell(const capture_out_t *o)
+{
+	return o->pos + o->len;
+}
+
+static void put_section(capture_out_t *o, uint32_t type, uint32_t offset,
+		const void *p, uint32_t len)
+{
+	boot_capture_section_t sec = { type, offset, len, 0 };
+
+	out_write(o, &sec, sizeof(sec));
+	out_write(o, p, len);
+}
+
+/*
+ * Copies the bootstage header and records, and each remote core block with
+ * its records. Returns the number of region bytes captured; *map_failed is
+ * set when a range inside the region could not be mapped.
+ */
+static size_t capture_region(capture_out_t *o, bootstage_source_t *src,
+		const unsigned long *remote, int nremote, int *map_failed)
+{
+	bootstage_hdr_info_t hdr;
+	const void *p;
+	size_t total = 0, len;
+
+	/*
+	 * The record layout is left to the parser: enough is copied for the
+	 * widest one, and for the kernel records that may follow, up to the
+	 * end of the region.
+	 */
+	p = bootstage_source_map(src, 0, BOOTSTAGE_HDR_SIZE);
+	if (p && bootstage_parse_header(p, &hdr) == 0 && hdr.size) {
+		len = BOOTSTAGE_HDR_SIZE + ((size_t)hdr.count + BOOT_KERNEL_REGION_MAX) *
+			BOOTSTAGE_RECORD_STRIDE_MAX;
+		if (len > src->size)
+			len = src->size;
+		p = bootstage_source_map(src, 0, len);
+		if (p) {
+			put_section(o, BOOT_CAPTURE_REGION, 0, p, len);
+			total += len;
+		} else {
+			*map_failed = 1;
+		}
+	} else if (!p && bootstage_source_has(src, 0, BOOTSTAGE_HDR_SIZE)) {
+		*map_failed = 1;
+	} else {
+		fprintf(stderr, "No valid bootstage header, region not captured\n");
+	}
+
+	for (int i = 0; i < nremote; i++) {
+		const mcu_boot_stage_record_t *blk;
+
+		if (!bootstage_source_has(src, remote[i], sizeof(*blk)))
+			continue; /* Short dump without this block */
+		blk = bootstage_source_map(src, remote[i], sizeof(*blk));
+		if (!blk) {
+			*map_failed = 1;
+			continue;
+		}
+		len = MCU_BOOTRECORD_OFFSET +
+			(size_t)blk->record_count * sizeof(mcu_boot_record_profile_t);
+		p = bootstage_source_map(src, remote[i], len);
+		if (p) {
+			put_section(o, BOOT_CAPTURE_REGION, remote[i], p, len);
+			total += len;
+		} else if (bootstage_source_has(src, remote[i], len)) {
+			*map_failed = 1;
+		}
+	}
+	return total;
+}
+
+/*
+ * Writes one kernel line in dmesg format if it is kept. kmsg records
+ * "<prio>,<seq>,<ts_usec>,<flags>;<message>" are rewritten as
+ * "[<sec>.<usec>] <message>"; dmesg lines are kept as they are. Returns 1
+ * for the BOOTSTAGE_KERNEL_END tracker line.
+ */
+static int capture_line(capture_out_t *o, const char *p, size_t n, int all,
+		uint64_t *bytes)
+{
+	const char *msg = p, *semi = memchr(p, ';', n);
+	const char *tag = memmem(p, n, BOOT_TRACKER_TAG, BOOT_TRACKER_TAG_LEN);
+	char prefix[32];
+	size_t plen = 0;
+	int end = 0;
+
+	if (!all && !tag && !(memmem(p, n, KERNEL_LOG_CALL_TAG, KERNEL_LOG_CALL_TAG_LEN) &&
+				memmem(p, n, " usecs", 6)))
+		return 0;
+	if (tag) {
+		const char *id = memmem(tag, n - (tag - p), "ID:", 3);
+
+		end = id && strtol(id + 3, NULL, 10) == KMSG_STOP_ID;
+	}
+	if (n && *p >= '0' && *p <= '9' && semi) {
+		unsigned long long ts = 0;
+		const char *q = p;
+
+		/* Third field is the time stamp in microseconds */
+		for (int field = 0; field < 2 && q; field++) {
+			q = memchr(q, ',', semi - q);
+			if (q)
+				q++;
+		}
+		if (q)
+			ts = strtoull(q, NULL, 10);
+		plen = snprintf(prefix, sizeof(prefix), "[%5llu.%06llu] ",
+				ts / 1000000, ts % 1000000);
+		msg = semi + 1;
+	}
+	out_write(o, prefix, plen);
+	out_write(o, msg, n - (msg - p));
+	out_write(o, "\n", 1);
+	*bytes += plen + n - (msg - p) + 1;
+	return end;
+}
+
+/*
+ * Copies the kept kernel lines from /dev/kmsg (without blocking) or from a
+ * kmsg/dmesg dump. Returns the line bytes written, or -1.
+ */
+static int64_t capture_klog(capture_out_t *o, const char *path, int all, int *kernel_end)
+{
+	uint64_t bytes = 0;
+	struct stat st;
+	size_t have = 0;
+	int fd;
+
+	fd = open(path, O_RDONLY | O_NONBLOCK);
+	if (fd < 0 || fstat(fd, &st) < 0) {
+		perror("Failed to open kernel message source");
+		if (fd >= 0)
+			close(fd);
+		return -1;
+	}
+	for (;;) {
+		ssize_t n = read(fd, in_buf + have, sizeof(in_buf) - have);
+
+		if (n < 0) {
+			if (errno == EPIPE || errno == EINTR)
+				continue; /* Record overwritten while reading */
+			if (errno != EAGAIN)
+				perror("Failed to read kernel messages");
+			break;
+		}
+		if (n == 0)
+			break;
+		if (S_ISCHR(st.st_mode)) {
+			/* One record per read; only its first line is the message */
+			const char *eol = memchr(in_buf, '\n', n);
+
+			*kernel_end |= capture_line(o, in_buf, eol ? eol - in_buf : n, all, &bytes);
+			continue;
+		}
+		have += n;
+		for (;;) {
+			char *eol = memchr(in_buf, '\n', have);
+
+			if (!eol) {
+				if (have == sizeof(in_buf))
+					have = 0; /* Overlong line: drop it */
+				break;
+			}
+			*kernel_end |= capture_line(o, in_buf, eol - in_buf, all, &bytes);
+			have -= eol + 1 - in_buf;
+			memmove(in_buf, eol + 1, have);
+		}
+	}
+	if (have)
+		*kernel_end |= capture_line(o, in_buf, have, all, &bytes);
+	close(fd);
+	return bytes;
+}
+
+static void usage(const char *prog)
+{
+	fprintf(stderr,
+		"Usage: %s [options]\n"
+		"  -o <file>    capture file (default " CAPTURE_DEFAULT_PATH ")\n"
+		"  -d <file>    read the bootstage region from a raw dump instead of /dev/mem\n"
+		"  -k <file>    kernel messages: " KMSG_DEVICE " (default) or a kmsg/dmesg dump\n"
+		"  -r <offset>  remote core record block to capture; repeat for each core\n"
+		"               (default 0x%x)\n"
+		"  -a           keep every kernel line, e.g. for marker configs\n"
+		"  -v           report what was captured\n"
+		"  -h           show this help\n",
+		prog, MCU_BOOTSTAGE_START_OFFSET);
+}
+
+int main(int argc, char *argv[])
+{
+	const char *out_path = CAPTURE_DEFAULT_PATH;
+	const char *dump = NULL;
+	const char *kmsg = KMSG_DEVICE;
+	unsigned long remote[BOOT_REMOTE_CORES_MAX];
+	int nremote = 0, all = 0, verbose = 0, kernel_end = 0;
+	boot_capture_hdr_t hdr = { 0 };
+	boot_capture_section_t sec = { BOOT_CAPTURE_KLOG, 0, 0, 0 };
+	capture_out_t o = { 0 };
+	bootstage_source_t src;
+	struct timespec t0, t1;
+	off_t klog_at;
+	int64_t klog;
+	size_t region = 0;
+	int map_failed = 0;
+	int opt;
+
+	clock_gettime(CLOCK_MONOTONIC, &t0);
+	while ((opt = getopt(argc, argv, "o:d:k:r:avh")) != -1) {
+		switch (opt) {
+		case 'o':
+			out_path = optarg;
+			break;
+		case 'd':
+			dump = optarg;
+			break;
+		case 'k':
+			kmsg = optarg;
+			break;
+		case 'r':
+			if (nremote == BOOT_REMOTE_CORES_MAX) {
+				fprintf(stderr, "At most %d remote cores\n", BOOT_REMOTE_CORES_MAX);
+				return EXIT_FAILURE;
+			}
+			remote[nremote++] = strtoul(optarg, NULL, 0);
+			break;
+		case 'a':
+			all = 1;
+			break;
+		case 'v':
+			verbose = 1;
+			break;
+		case 'h':
+			usage(argv[0]);
+			return EXIT_SUCCESS;
+		default:
+			usage(argv[0]);
+			return EXIT_FAILURE;
+		}
+	}
+	if (!nremote)
+		remote[nremote++] = MCU_BOOTSTAGE_START_OFFSET;
+
+	o.fd = open(out_path, O_WRONLY | O_CREAT | O_TRUNC, 0644);
+	if (o.fd < 0) {
+		perror("Failed to create capture file");
+		return EXIT_FAILURE;
+	}
+	hdr.magic = BOOT_CAPTURE_MAGIC;
+	hdr.version = BOOT_CAPTURE_VERSION;
+	hdr.region_base = BOOTSTAGE_PRESERVED_ADDR;
+	hdr.region_size = BOOTSTAGE_SIZE;
+	hdr.capture_ns = (uint64_t)t0.tv_sec * 1000000000u + t0.tv_nsec;
+	out_write(&o, &hdr, sizeof(hdr));
+
+	if ((dump ? bootstage_source_open_file(&src, dump) :
+			bootstage_source_open_mem(&src, BOOTSTAGE_PRESERVED_ADDR, BOOTSTAGE_SIZE)) == 0) {
+		hdr.region_size = src.size;
+		region = capture_region(&o, &src, remote, nremote, &map_failed);
+		bootstage_source_close(&src);
+	}
+
+	/* The section length is known once the lines are written */
+	klog_at = out_tell(&o);
+	out_write(&o, &sec, sizeof(sec));
+	klog = capture_klog(&o, kmsg, all, &kernel_end);
+	out_flush(&o);
+	if (klog > 0) {
+		sec.len = klog;
+		if (pwrite(o.fd, &sec, sizeof(sec), klog_at) != sizeof(sec))
+			o.err = -1;
+	}
+	hdr.flags = (kernel_end ? BOOT_CAPTURE_KERNEL_END : 0) | (all ? BOOT_CAPTURE_ALL_LINES : 0);
+	if (pwrite(o.fd, &hdr, sizeof(hdr), 0) != sizeof(hdr))
+		o.err = -1;
+	if (close(o.fd) < 0 || o.err) {
+		perror("Failed to write capture file");
+		return EXIT_FAILURE;
+	}
+	if (map_failed) {
+		fprintf(stderr, "%s: part of the bootstage region could not be mapped\n", out_path);
+		return EXIT_FAILURE;
+	}
+
+	if (verbose) {
+		clock_gettime(CLOCK_MONOTONIC, &t1);
+		fprintf(stderr, "%s: %zu region bytes, %lld kernel line bytes%s in %ld us\n",
+				out_path, region, (long long)(klog > 0 ? klog : 0),
+				kernel_end ? " (kernel end seen)" : "",
+				(long)((t1.tv_sec - t0.tv_sec) * 1000000 +
+					(t1.tv_nsec - t0.tv_nsec) / 1000));
+	}
+	return EXIT_SUCCESS;
+}
@@ -0,0 +1,1548 @@
+/*
+ *  Copyright (C) 2025 Texas Instruments Incorporated
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions
+ *  are met:
+ *
+ *    Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *
+ *    Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the
+ *    distribution.
+ *
+ *    Neither the name of Texas Instruments Incorporated nor the names of
+ *    its contributors may be used to endorse or promote products derived
+ *    from this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ *  "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ *  LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ *  A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ *  OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ *  SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ *  LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ *  DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ *  THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ *  (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ *  OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/**
+ * \file boot_time_ctx.c
+ * \brief libboottime parser: collects bootloader, kernel and MCU boot
+ * records into a caller owned context.
+ */
+
+/* ========================================================================== */
+/*                           Include Files                                    */
+/* ========================================================================== */
+
+#include "boot_time_internal.h"
+#include "kernel_log_scan.h"
+#include "kernel_log_index.h"
+#include "kernel_log_stream.h"
+#include "kmsg_source.h"
+#include "boot_archive.h"
+#include "boot_milestone.h"
+#include "boot_capture.h"
+#include "boot_watch.h"
+
+/* ========================================================================== */
+/*                          Global Variables                                  */
+/* ========================================================================== */
+
+static const char *const bootstage_id_names[] = {
+    [0] = "START",
+    [1] = "CHECK_MAGIC",
+    [2] = "BOOTSTAGE_ID_CHECK_HEADER",
+    [3] = "BOOTSTAGE_ID_CHECK_CHECKSUM",
+    [4] = "BOOTSTAGE_ID_CHECK_ARCH",
+    [5] = "BOOTSTAGE_ID_CHECK_IMAGETYPE",
+    [6] = "BOOTSTAGE_ID_DECOMP_IMAGE",
+    [7] = "BOOTSTAGE_ID_DECOMP_UNIMPL",
+    [8] = "BOOTSTAGE_ID_CHECK_BOOT_OS",
+    [9] = "BOOTSTAGE_ID_CHECK_RAMDISK",
+    [10] = "BOOTSTAGE_ID_RD_MAGIC",
+    [11] = "BOOTSTAGE_ID_RD_HDR_CHECKSUM",
+    [12] = "BOOTSTAGE_ID_COPY_RAMDISK",
+    [13] = "BOOTSTAGE_ID_RAMDISK",
+    [14] = "BOOTSTAGE_ID_NO_RAMDISK",
+    [15] = "BOOTSTAGE_RUN_OS",
+    [30] = "BOOTSTAGE_ID_NEED_RESET",
+    [31] = "BOOTSTAGE_ID_POST_FAIL",
+    [32] = "BOOTSTAGE_ID_POST_FAIL_R",
+    [33] = "INIT_R",
+    [34] = "BOOTSTAGE_ID_BOARD_GLOBAL_DATA",
+    [35] = "BOOTSTAGE_ID_BOARD_INIT_SEQ",
+    [36] = "BOOTSTAGE_ID_BOARD_FLASH",
+    [37] = "BOOTSTAGE_ID_BOARD_FLASH_37",
+    [38] = "BOOTSTAGE_ID_BOARD_ENV",
+    [39] = "BOOTSTAGE_ID_BOARD_PCI",
+    [40] = "BOOTSTAGE_ID_BOARD_INTERRUPTS",
+    [41] = "BOOTSTAGE_ID_IDE_START",
+    [42] = "BOOTSTAGE_ID_IDE_ADDR",
+    [43] = "BOOTSTAGE_ID_IDE_BOOT_DEVICE",
+    [44] = "BOOTSTAGE_ID_IDE_TYPE",
+    [45] = "BOOTSTAGE_ID_IDE_PART",
+    [46] = "BOOTSTAGE_ID_IDE_PART_INFO",
+    [47] = "BOOTSTAGE_ID_IDE_PART_TYPE",
+    [48] = "BOOTSTAGE_ID_IDE_PART_READ",
+    [49] = "BOOTSTAGE_ID_IDE_FORMAT",
+    [50] = "BOOTSTAGE_ID_IDE_CHECKSUM",
+    [51] = "BOOTSTAGE_ID_IDE_READ",
+    [52] = "BOOTSTAGE_ID_NAND_PART",
+    [53] = "BOOTSTAGE_ID_NAND_SUFFIX",
+    [54] = "BOOTSTAGE_ID_NAND_BOOT_DEVICE",
+    [55] = "BOOTSTAGE_ID_NAND_AVAILABLE",
+    [57] = "BOOTSTAGE_ID_NAND_TYPE",
+    [58] = "BOOTSTAGE_ID_NAND_READ",
+    [60] = "BOOTSTAGE_ID_NET_CHECKSUM",
+    [64] = "BOOTSTAGE_NET_ETH_START",
+    [65] = "BOOTSTAGE_NET_ETH_INIT",
+    [80] = "BOOTSTAGE_ID_NET_START",
+    [81] = "BOOTSTAGE_ID_NET_NETLOOP_OK",
+    [82] = "BOOTSTAGE_ID_NET_LOADED",
+    [83] = "BOOTSTAGE_ID_NET_DONE_ERR",
+    [84] = "BOOTSTAGE_ID_NET_DONE",
+    [90] = "BOOTSTAGE_ID_FIT_FDT_START",
+    [100] = "BOOTSTAGE_ID_FIT_KERNEL_START",
+    [110] = "BOOTSTAGE_ID_FIT_CONFIG",
+    [111] = "BOOTSTAGE_ID_FIT_TYPE",
+    [112] = "BOOTSTAGE_ID_FIT_COMPRESSION",
+    [113] = "BOOTSTAGE_ID_FIT_OS",
+    [114] = "BOOTSTAGE_ID_FIT_LOADADDR",
+    [115] = "BOOTSTAGE_ID_OVERWRITTEN",
+    [120] = "BOOTSTAGE_ID_FIT_RD_START",
+    [130] = "BOOTSTAGE_ID_FIT_SETUP_START",
+    [140] = "BOOTSTAGE_ID_IDE_FIT_READ",
+    [141] = "BOOTSTAGE_ID_IDE_FIT_READ_OK",
+    [150] = "BOOTSTAGE_ID_NAND_FIT_READ",
+    [151] = "BOOTSTAGE_ID_NAND_FIT_READ_OK",
+    [160] = "BOOTSTAGE_ID_FIT_LOADABLE_START",
+    [170] = "BOOTSTAGE_ID_FIT_SPL_START",
+    [171] = "BOOTSTAGE_AWAKE",
+    [172] = "BOOTSTAGE_ID_START_TPL",
+    [173] = "BOOTSTAGE_ID_END_TPL",
+    [174] = "BOOTSTAGE_ID_START_SPL",
+    [175] = "BOOTSTAGE_ID_END_SPL",
+    [176] = "BOOTSTAGE_START_MCU",
+    [177] = "BOOTSTAGE_ID_END_VPL",
+    [178] = "BOOTSTAGE_START_UBOOT_F",
+    [179] = "BOOTSTAGE_START_UBOOT_R",
+    [180] = "BOOTSTAGE_USB_START",
+    [181] = "BOOTSTAGE_ETH_START",
+    [182] = "BOOTSTAGE_ID_BOOTP_START",
+    [183] = "BOOTSTAGE_ID_BOOTP_STOP",
+    [184] = "BOOTSTAGE_BOOTM_START",
+    [185] = "BOOTSTAGE_BOOTM_HANDOFF",
+    [186] = "BOOTSTAGE_MAIN_LOOP",
+    [187] = "BOOTSTAGE_ENTER_CLI_LOOP",
+    [188] = "BOOTSTAGE_KERNELREAD_START",
+    [189] = "BOOTSTAGE_KERNELREAD_STOP",
+    [190] = "BOOTSTAGE_ID_BOARD_INIT",
+    [191] = "BOOTSTAGE_ID_BOARD_INIT_DONE",
+    [192] = "BOOTSTAGE_ID_CPU_AWAKE",
+    [193] = "BOOTSTAGE_ID_MAIN_CPU_AWAKE",
+    [194] = "BOOTSTAGE_ID_MAIN_CPU_READY",
+    [195] = "BOOTSTAGE_ID_ACCUM_LCD",
+    [196] = "BOOTSTAGE_ID_ACCUM_SCSI",
+    [197] = "BOOTSTAGE_ID_ACCUM_SPI",
+    [198] = "BOOTSTAGE_ID_ACCUM_DECOMP",
+    [199] = "BOOTSTAGE_ID_ACCUM_OF_LIVE",
+    [200] = "BOOTSTAGE_ID_FPGA_INIT",
+    [201] = "BOOTSTAGE_ID_ACCUM_DM_SPL",
+    [202] = "BOOTSTAGE_ACCUM_DM_F",
+    [203] = "BOOTSTAGE_ACCUM_DM_R",
+    [204] = "BOOTSTAGE_ID_ACCUM_FSP_M",
+    [205] = "BOOTSTAGE_ID_ACCUM_FSP_S",
+    [206] = "BOOTSTAGE_ID_ACCUM_MMAP_SPI",
+    [207] = "BOOTSTAGE_ID_USER",
+    [208] = "BOOTSTAGE_ID_ALLOC",
+    [300] = "BOOTSTAGE_KERNEL_START",
+    [301] = "BOOTSTAGE_KERNEL_END",
+};
+
+/* The MCU block U-Boot releases at BOOTSTAGE_START_MCU */
+static const boot_remote_core_t default_remote_core = {
+	.label = "MCU",
+	.offset = MCU_BOOTSTAGE_START_OFFSET,
+	.anchor_id = BOOTSTAGE_START_MCU,
+	.freq_hz = BOOT_CLOCK_DEFAULT_HZ,
+};
+
+
+/* ========================================================================== */
+/*                          Function Definitions                              */
+/* ========================================================================== */
+
+/**
+ * @brief Returns the name of a bootstage id.
+ * 
+ * @param id Bootstage id.
+ * @return const char* Stage name, or "UNKNOWN_BOOTSTAGE_ID".
+ */
+const char* get_bootstage_id_name(int id) {
+	// Check if the ID is out of bounds or if the name is NULL.
+	if (id < 0 || (size_t)id >= sizeof(bootstage_id_names)/sizeof(bootstage_id_names[0])
+		|| bootstage_id_names[id] == NULL)
+		return "UNKNOWN_BOOTSTAGE_ID";
+	return bootstage_id_names[id];
+}
+
+/**
+ * @brief Allocates an empty parser context.
+ * 
+ * @return boot_time_ctx_t* New context, or NULL on allocation failure.
+ */
+boot_time_ctx_t *boot_time_ctx_create(void)
+{
+	boot_time_ctx_t *ctx = calloc(1, sizeof(boot_time_ctx_t));
+
+	if (!ctx)
+		return NULL;
+	arena_init(&ctx->arena);
+	strtab_init(&ctx->names, &ctx->arena);
+	record_table_init(&ctx->boot_records, &ctx->arena);
+	for (int i = 0; i < BOOT_REMOTE_CORES_MAX; i++)
+		record_table_init(&ctx->remote_records[i], &ctx->arena);
+	ctx->remote_cores[0] = default_remote_core;
+	ctx->remote_count = 1;
+	boot_clock_init(&ctx->kernel_clock, BOOT_CLOCK_DEFAULT_HZ, 0);
+	ctx->unit = BOOT_UNIT_MS;
+	return ctx;
+}
+
+/**
+ * @brief Releases a parser context and all its records.
+ */
+void boot_time_ctx_destroy(boot_time_ctx_t *ctx)
+{
+	if (!ctx)
+		return;
+	if (ctx->markers)
+		log_marker_free(ctx->markers);
+	free(ctx->markers);
+	arena_release(&ctx->arena);
+	free(ctx);
+}
+
+/**
+ * @brief Sets the number of threads used to scan large kernel logs.
+ * 
+ * @param nthreads Thread count, or <= 0 for one per online CPU.
+ */
+void boot_time_set_jobs(boot_time_ctx_t *ctx, int nthreads)
+{
+	ctx->scan_threads = nthreads;
+}
+
+/**
+ * @brief Selects the boot read from the kernel log.
+ * 
+ * @param boot 0 for the latest boot, -1 for the one before, and so on.
+ */
+void boot_time_set_boot(boot_time_ctx_t *ctx, int boot)
+{
+	ctx->boot_select = boot;
+}
+
+/**
+ * @brief Sets the kernel log index file.
+ * 
+ * @param index_path Index file, NULL for <log>.btidx, or
+ * BOOT_TIME_LOG_INDEX_NONE to scan the whole log without an index.
+ */
+void boot_time_set_log_index(boot_time_ctx_t *ctx, const char *index_path)
+{
+	ctx->no_log_index = (index_path && !index_path[0]);
+	snprintf(ctx->log_index_path, sizeof(ctx->log_index_path), "%s",
+			index_path ? index_path : "");
+}
+
+/**
+ * @brief Sets the unit reports are printed in (default milliseconds).
+ */
+void boot_time_set_unit(boot_time_ctx_t *ctx, boot_time_unit_t unit)
+{
+	ctx->unit = unit;
+}
+
+/**
+ * @brief Returns the unit reports are printed in.
+ */
+boot_time_unit_t boot_time_unit(const boot_time_ctx_t *ctx)
+{
+	return ctx->unit;
+}
+
+/**
+ * @brief Replaces the table of remote core record blocks.
+ * 
+ * Must be called before the bootstage region is read. The default table
+ * holds the MCU block at MCU_BOOTSTAGE_START_OFFSET.
+ * 
+ * @param cores Record block descriptors, in report order.
+ * @param count Number of descriptors, at most BOOT_REMOTE_CORES_MAX.
+ * @return int 0 on success, -1 if count is out of range.
+ */
+int boot_time_set_remote_cores(boot_time_ctx_t *ctx, const boot_remote_core_t *cores,
+		int count)
+{
+	if (count < 0 || count > BOOT_REMOTE_CORES_MAX) {
+		fprintf(stderr, "At most %d remote cores are supported\n", BOOT_REMOTE_CORES_MAX);
+		return -1;
+	}
+	memcpy(ctx->remote_cores, cores, count * sizeof(*cores));
+	ctx->remote_count = count;
+	return 0;
+}
+
+/**
+ * @brief Parses a remote core descriptor of the form
+ * "<label>@<offset>[:<anchor id>[:<counter Hz>]]".
+ * 
+ * The offset is relative to the bootstage region and may be hex; the
+ * anchor defaults to BOOTSTAGE_START_MCU and the counter to 1 MHz.
+ * 
+ * @param spec Descriptor string, e.g. "R5F@0x84000:176:25000000".
+ * @param core Receives the descriptor.
+ * @return int 0 on success, -1 if spec is malformed.
+ */
+int boot_time_parse_remote_core(const char *spec, boot_remote_core_t *core)
+{
+	const char *at = strchr(spec, '@');
+	char *end;
+
+	if (!at || at == spec || at - spec >= BOOT_REMOTE_LABEL_MAX)
+		return -1;
+	memset(core, 0, sizeof(*core));
+	memcpy(core->label, spec, at - spec);
+	core->offset = strtoull(at + 1, &end, 0);
+	core->anchor_id = BOOTSTAGE_START_MCU;
+	if (end == at + 1)
+		return -1;
+	if (*end == ':') {
+		const char *id = end + 1;
+		core->anchor_id = strtol(id, &end, 0);
+		if (end == id)
+			return -1;
+	}
+	if (*end == ':') {
+		const char *hz = end + 1;
+		core->freq_hz = strtoull(hz, &end, 0);
+		if (end == hz)
+			return -1;
+	}
+	return *end ? -1 : 0;
+}
+
+/**
+ * @brief Sets where the kernel tracker clock starts on the common
+ * timebase.
+ * 
+ * Tracker time stamps are taken as time since power on unless the kernel
+ * clock is known to start elsewhere. Must be called before the kernel
+ * records are read.
+ * 
+ * @param epoch_ns Timebase time of kernel time stamp 0.
+ */
+void boot_time_set_kernel_epoch(boot_time_ctx_t *ctx, double epoch_ns)
+{
+	boot_clock_init(&ctx->kernel_clock, BOOT_CLOCK_DEFAULT_HZ, epoch_ns);
+}
+
+/**
+ * @brief Sets how many initcalls and probes are kept from the kernel log.
+ * 
+ * With an initcall_debug kernel, the scan that finds the tracker lines
+ * also times every initcall and driver probe and keeps the longest ones.
+ * 
+ * @param top Calls kept, 0 (the default) to skip them.
+ */
+void boot_time_set_kernel_calls(boot_time_ctx_t *ctx, int top)
+{
+	ctx->kernel_call_top = (top > 0) ? top : 0;
+}
+
+/**
+ * @brief Fixes the record layout of the bootstage region instead of
+ * detecting it, see bootstage_layout.h.
+ * 
+ * @param name Layout name, e.g. "le32", or "auto" to detect it (the
+ * default).
+ * @return int 0 on success, -1 if the layout is unknown.
+ */
+int boot_time_set_bootstage_layout(boot_time_ctx_t *ctx, const char *name)
+{
+	const bootstage_layout_t *layout = NULL;
+
+	if (strcmp(name, "auto") != 0) {
+		layout = bootstage_layout_find(name);
+		if (layout == NULL) {
+			fprintf(stderr, "Unknown bootstage layout %s, known layouts:\n", name);
+			bootstage_layout_list(stderr);
+			return -1;
+		}
+	}
+	ctx->bootstage_layout = layout;
+	return 0;
+}
+
+/**
+ * @brief Sets where the kernel appends its records in the bootstage
+ * region, see boot_time_read_bootstage().
+ * 
+ * @param offset Region offset of the area, BOOT_KERNEL_REGION_AFTER (the
+ * default) for right after the U-Boot records, or BOOT_KERNEL_REGION_NONE
+ * to always take the kernel records from the log.
+ */
+void boot_time_set_kernel_region(boot_time_ctx_t *ctx, size_t offset)
+{
+	ctx->kernel_region = offset;
+}
+
+/**
+ * @brief Loads a marker config; kernel log scans then also turn the lines
+ * it describes into records, see log_marker_t.
+ * 
+ * @param path Marker config file.
+ * @return int 0 on success, -1 on failure.
+ */
+int boot_time_set_markers(boot_time_ctx_t *ctx, const char *path)
+{
+	log_marker_set_t *set = malloc(sizeof(*set));
+
+	if (!set || log_marker_load(set, path) < 0) {
+		free(set);
+		return -1;
+	}
+	if (ctx->markers)
+		log_marker_free(ctx->markers);
+	free(ctx->markers);
+	ctx->markers = set;
+	return 0;
+}
+
+/**
+ * @brief Declares that a remote core stage and an A53 stage happened at
+ * the same instant.
+ * 
+ * boot_time_sync_clocks() fits each remote clock to its sync points.
+ * 
+ * @param core Remote core label, e.g. "MCU".
+ * @param stage Stage name in the remote core's records.
+ * @param ref_stage Stage name in the bootloader and kernel records.
+ * @return int 0 on success, -1 if the table is full.
+ */
+int boot_time_add_clock_sync(boot_time_ctx_t *ctx, const char *core,
+		const char *stage, const char *ref_stage)
+{
+	boot_clock_sync_t *s;
+
+	if (ctx->clock_sync_count == BOOT_CLOCK_SYNC_MAX) {
+		fprintf(stderr, "At most %d clock sync points are supported\n",
+				BOOT_CLOCK_SYNC_MAX);
+		return -1;
+	}
+	s = &ctx->clock_sync[ctx->clock_sync_count];
+	s->core = strtab_intern(&ctx->names, core, strlen(core));
+	s->stage = strtab_intern(&ctx->names, stage, strlen(stage));
+	s->ref = strtab_intern(&ctx->names, ref_stage, strlen(ref_stage));
+	if (s->core == STRTAB_NONE || s->stage == STRTAB_NONE || s->ref == STRTAB_NONE)
+		return -1;
+	ctx->clock_sync_count++;
+	return 0;
+}
+
+/**
+ * @brief Returns the boot summary.
+ */
+const boot_summary_t *boot_time_summary(const boot_time_ctx_t *ctx)
+{
+	return &ctx->boot_summary;
+}
+
+static void record_columns(const record_table_t *tab, boot_record_columns_t *out)
+{
+	out->start_time = tab->start_time;
+	out->delta_time = tab->delta_time;
+	out->name = tab->name;
+	out->id = tab->id;
+	out->duration = tab->duration;
+	out->count = tab->count;
+}
+
+/**
+ * @brief Returns the bootloader and kernel records.
+ * 
+ * The columns stay valid until the context is destroyed or more records
+ * are read into it.
+ * 
+ * @param out Receives the record columns.
+ */
+void boot_time_records(const boot_time_ctx_t *ctx, boot_record_columns_t *out)
+{
+	record_columns(&ctx->boot_records, out);
+}
+
+/**
+ * @brief Returns the records of the first remote core (the MCU by default).
+ * 
+ * @param out Receives the record columns.
+ */
+void boot_time_mcu_records(const boot_time_ctx_t *ctx, boot_record_columns_t *out)
+{
+	record_columns(&ctx->remote_records[0], out);
+}
+
+/**
+ * @brief Returns the number of remote cores configured.
+ */
+int boot_time_remote_core_count(const boot_time_ctx_t *ctx)
+{
+	return ctx->remote_count;
+}
+
+/**
+ * @brief Returns the descriptor of a remote core, or NULL for an unknown
+ * core.
+ */
+const boot_remote_core_t *boot_time_remote_core(const boot_time_ctx_t *ctx, int core)
+{
+	return (core >= 0 && core < ctx->remote_count) ? &ctx->remote_cores[core] : NULL;
+}
+
+/**
+ * @brief Returns the records of one remote core.
+ * 
+ * @param core Index into the remote core table.
+ * @param out Receives the record columns; empty for an unknown core.
+ */
+void boot_time_remote_records(const boot_time_ctx_t *ctx, int core,
+		boot_record_columns_t *out)
+{
+	if (core < 0 || core >= ctx->remote_count) {
+		memset(out, 0, sizeof(*out));
+		return;
+	}
+	record_columns(&ctx->remote_records[core], out);
+}
+
+/**
+ * @brief Returns an interned stage name.
+ * 
+ * @param idx Name index from boot_record_columns_t.name.
+ */
+const char *boot_time_name(const boot_time_ctx_t *ctx, uint32_t idx)
+{
+	return strtab_str(&ctx->names, idx);
+}
+
+/**
+ * @brief Returns the longest initcalls and probes, longest first.
+ * 
+ * @param count Receives the number of calls returned.
+ * @param seen If not NULL, receives the number of calls in the log.
+ */
+const boot_kernel_call_t *boot_time_kernel_calls(const boot_time_ctx_t *ctx, int *count,
+		uint64_t *seen)
+{
+	*count = ctx->kernel_call_count;
+	if (seen)
+		*seen = ctx->kernel_call_lines;
+	return ctx->kernel_calls;
+}
+
+/**
+ * @brief Returns the bytes read, lines decoded and records held so far.
+ *
+ * The counters are kept per source read, not per line, so they are always
+ * on. Differences between two calls give the work of one phase.
+ *
+ * @param ctx Parser context.
+ * @param out Receives the counters.
+ */
+void boot_time_io_stats(const boot_time_ctx_t *ctx, boot_time_io_stats_t *out)
+{
+	*out = ctx->io;
+	out->records = ctx->boot_records.count + ctx->kernel_call_count;
+	for (int c = 0; c < ctx->remote_count; c++)
+		out->records += ctx->remote_records[c].count;
+}
+
+/* Converts a timebase time to record units, clamping before power on */
+static uint64_t ns_to_unit(double ns)
+{
+	return (ns > 0) ? (uint64_t)(ns / BOOT_TIME_UNIT_NS + 0.5) : 0;
+}
+
+/*
+ * Interns the stage name and appends one record to a table.
+ */
+static int push_record(boot_time_ctx_t *ctx, record_table_t *tab,
+		uint64_t start_time, uint64_t delta_time, const char *name, size_t len,
+		int32_t id, uint64_t duration)
+{
+	uint32_t idx = strtab_intern(&ctx->names, name, len);
+
+	if (idx == STRTAB_NONE ||
+			record_table_push(tab, start_time, delta_time, idx, id, duration) < 0) {
+		fprintf(stderr, "Out of memory storing boot records\n");
+		return -1;
+	}
+	return 0;
+}
+
+/**
+ * @brief Appends one kernel record to the boot records.
+ * 
+ * The first kernel record after U-Boot handoff marks the kernel start and
+ * later ones move the kernel end forward. Records of the configured log
+ * markers leave the summary alone unless they carry one of its ids.
+ * 
+ * @param ctx Parser context.
+ * @param id Bootstage id of the record.
+ * @param name Stage name, or NULL for the name of the id.
+ * @param time_us Record time stamp in microseconds.
+ */
+static void add_kernel_boot_record(boot_time_ctx_t *ctx, int id, const char *name,
+		uint64_t time_us)
+{
+	uint64_t time = ns_to_unit(boot_clock_to_ns(&ctx->kernel_clock, time_us));
+	uint64_t delta = (ctx->prev_time == 0) ? 0 : (time - ctx->prev_time);
+
+	if (!name)
+		name = get_bootstage_id_name(id);
+	else if (time < ctx->prev_time)
+		delta = 0; /* Marker lines need not be in time order */
+	if (push_record(ctx, &ctx->boot_records, time, delta, name, strlen(name),
+			id, 0) < 0)
+		return;
+	ctx->prev_time = time;
+	ctx->boot_summary.count = ctx->boot_records.count;
+	if (id == BOOTSTAGE_USER_MILESTONE || id == BOOTSTAGE_LOG_MARKER)
+		return;
+	if(!ctx->kernel_record_count && time > ctx->boot_summary.uend_time)
+		ctx->boot_summary.kstart_time = ctx->prev_time;
+	else if(time > ctx->boot_summary.kstart_time)
+		ctx->boot_summary.kend_time = time;
+	ctx->kernel_record_count++;
+}
+
+/*
+ * Offset from printk time to tracker time. It is tied by the
+ * BOOTSTAGE_KERNEL_START line (or else the first tracker line) having both
+ * time stamps. Without any, printk time 0 is taken as the first tracker
+ * record.
+ */
+static int64_t printk_offset_us(const kernel_log_scan_result_t *res)
+{
+	const kernel_log_match_t *first = NULL, *anchor = NULL;
+
+	for (size_t i = 0; i < res->count; i++) {
+		const kernel_log_match_t *m = &res->matches[i];
+
+		if (m->marker != LOG_MARKER_TRACKER)
+			continue;
+		if (!first)
+			first = m;
+		if (m->ts_us == KERNEL_LOG_NO_TS)
+			continue;
+		if (!anchor || m->id == BOOTSTAGE_KERNEL_START)
+			anchor = m;
+		if (m->id == BOOTSTAGE_KERNEL_START)
+			break;
+	}
+	if (anchor)
+		return (int64_t)anchor->time_us - (int64_t)anchor->ts_us;
+	return first ? (int64_t)first->time_us : 0;
+}
+
+static int cmp_kernel_call(const void *a, const void *b)
+{
+	const kernel_log_call_t *x = a, *y = b;
+
+	if (x->dur_us != y->dur_us)
+		return (x->dur_us < y->dur_us) - (x->dur_us > y->dur_us);
+	return (x->offset > y->offset) - (x->offset < y->offset);
+}
+
+/*
+ * Places the initcalls and probes kept by the scan on the kernel clock.
+ * Their lines carry only printk time stamps.
+ */
+static void add_kernel_calls(boot_time_ctx_t *ctx, kernel_log_scan_result_t *res,
+		int64_t offset_us)
+{
+	ctx->kernel_calls = arena_alloc(&ctx->arena, res->call_count * sizeof(*ctx->kernel_calls));
+	if (!ctx->kernel_calls) {
+		fprintf(stderr, "Out of memory storing kernel calls\n");
+		return;
+	}
+	qsort(res->calls, res->call_count, sizeof(*res->calls), cmp_kernel_call);
+	for (size_t i = 0; i < res->call_count; i++) {
+		const kernel_log_call_t *c = &res->calls[i];
+		boot_kernel_call_t *k = &ctx->kernel_calls[ctx->kernel_call_count];
+
+		k->name = strtab_intern(&ctx->names, c->name, strlen(c->name));
+		if (k->name == STRTAB_NONE)
+			break;
+		k->probe = (c->kind == KERNEL_LOG_PROBE);
+		k->ret = c->ret;
+		k->start_time = 0;
+		k->duration = (uint64_t)c->dur_us * BOOT_TIME_NS_PER_US;
+		if (c->ts_us != KERNEL_LOG_NO_TS) {
+			int64_t end_us = (int64_t)c->ts_us + offset_us;
+			int64_t start_us = end_us - (int64_t)c->dur_us;
+			double end_ns = boot_clock_to_ns(&ctx->kernel_clock, end_us > 0 ? end_us : 0);
+			double start_ns = boot_clock_to_ns(&ctx->kernel_clock,
+					start_us > 0 ? start_us : 0);
+
+			k->start_time = ns_to_unit(start_ns);
+			k->duration = ns_to_unit(end_ns) - k->start_time;
+		}
+		ctx->kernel_call_count++;
+	}
+	ctx->kernel_call_lines = res->call_lines;
+}
+
+/*
+ * Adds the tracker and marker records and the kernel calls found by a scan
+ * of kernel log text.
+ */
+static void add_kernel_scan(boot_time_ctx_t *ctx, kernel_log_scan_result_t *res)
+{
+	int64_t offset_us = printk_offset_us(res);
+
+	ctx->printk_offset_us = offset_us;
+	ctx->io.bytes_read += res->bytes_scanned;
+	ctx->io.lines += res->count + res->call_lines;
+	for (size_t i = 0; i < res->count; i++) {
+		const kernel_log_match_t *m = &res->matches[i];
+		int64_t time_us = (int64_t)m->ts_us + offset_us;
+
+		if (m->marker == LOG_MARKER_TRACKER)
+			add_kernel_boot_record(ctx, m->id, NULL, m->time_us);
+		else
+			add_kernel_boot_record(ctx, m->id, ctx->markers->markers[m->marker].name,
+					m->time_us != KERNEL_LOG_NO_TS ? m->time_us :
+					(uint64_t)(time_us > 0 ? time_us : 0));
+	}
+	if (res->call_count)
+		add_kernel_calls(ctx, res, offset_us);
+}
+
+/*
+ * Takes the kernel records from the bootstage region instead of a log,
+ * unless the log is needed for more than them: an older boot, initcalls
+ * or marker lines. Returns 1 if the region records were used.
+ */
+static int kernel_from_region(boot_time_ctx_t *ctx)
+{
+	if (!ctx->region_kernel_count || ctx->boot_select ||
+			ctx->kernel_call_top || ctx->markers)
+		return 0;
+	for (uint32_t i = 0; i < ctx->region_kernel_count; i++)
+		add_kernel_boot_record(ctx, ctx->region_kernel[i].id, NULL,
+				ctx->region_kernel[i].time_us);
+	return 1;
+}
+
+/*
+ * Reads boot skip (0: the newest) counted back through the log's rotated
+ * segments, preceded by the log itself when it is not indexed (e.g.
+ * compressed).
+ */
+static int read_rotated_log(boot_time_ctx_t *ctx, const char *filename, int with_log,
+		uint32_t skip, kernel_log_scan_result_t *res)
+{
+	klog_segment_t *segs = malloc((KLOG_ROTATE_MAX + 1) * sizeof(*segs));
+	int n = 0, ret;
+
+	if (!segs)
+		return EXIT_FAILURE;
+	if (with_log && access(filename, R_OK) == 0) {
+		snprintf(segs[0].path, sizeof(segs[0].path), "%s", filename);
+		kernel_log_codec(filename, &segs[0].codec);
+		n = 1;
+	}
+	n += kernel_log_rotated_segments(filename, segs + n, KLOG_ROTATE_MAX);
+	ret = kernel_log_rotated_boot(segs, n, skip, res);
+	free(segs);
+	if (ret > 0)
+		fprintf(stderr, "Boot %d not found in %s or its rotated logs\n",
+				ctx->boot_select, filename);
+	if (ret == 0)
+		add_kernel_scan(ctx, res);
+	kernel_log_scan_free(res);
+	return ret ? EXIT_FAILURE : EXIT_SUCCESS;
+}
+
+/**
+ * @brief Reads kernel boot records from a log file.
+ * 
+ * This function parses the specified log file to extract kernel boot
+ * information, such as initialization times or errors encountered during
+ * startup. The boot selected with --boot is located through the sidecar
+ * index, or with indexing disabled by splitting the log's tracker lines
+ * in memory, and only its byte range is scanned by kernel_log_scan_file(),
+ * which also keeps the longest initcalls and probes when
+ * boot_time_set_kernel_calls() asked for them.
+ * 
+ * The log is not read at all when the kernel left its records in the
+ * bootstage region and only those are needed. A boot older than the log,
+ * e.g. after logrotate, is looked for in <log>.1, <log>.2.gz and so on,
+ * which are streamed and inflated on the fly, as is a compressed log.
+ * 
+ * @param ctx Parser context.
+ * @param filename The path to the log file containing kernel boot records.
+ * @return int EXIT_SUCCESS on success, EXIT_FAILURE otherwise.
+ */
+int boot_time_read_kernel_log(boot_time_ctx_t *ctx, const char *filename)
+{
+	kernel_log_scan_result_t res = { 0 };
+	uint32_t skip = -ctx->boot_select;
+	klog_index_boot_t boot;
+	klog_codec_t codec;
+	uint32_t count = 0;
+	int ret;
+
+	if (kernel_from_region(ctx))
+		return EXIT_SUCCESS;
+
+	res.call_top = ctx->kernel_call_top;
+	res.markers = ctx->markers;
+
+	/* Gone (rotated and not recreated yet) or compressed: stream it */
+	if (kernel_log_codec(filename, &codec) < 0 || codec != KLOG_CODEC_PLAIN)
+		return read_rotated_log(ctx, filename, 1, skip, &res);
+
+	/* Restrict the scan to the selected boot: through the index... */
+	if (!ctx->no_log_index) {
+		char path[PATH_MAX];
+
+		if (ctx->log_index_path[0])
+			snprintf(path, sizeof(path), "%s", ctx->log_index_path);
+		else
+			snprintf(path, sizeof(path), "%s%s", filename, KLOG_INDEX_SUFFIX);
+		ret = kernel_log_index_lookup(filename, path, ctx->boot_select,
+				ctx->scan_threads, &boot, &count);
+	} else {
+		/* ...or by splitting the tracker lines of the whole log in memory */
+		kernel_log_scan_result_t all = { 0 };
+
+		if (kernel_log_scan_file(filename, 0, 0, ctx->scan_threads, &all) < 0) {
+			kernel_log_scan_free(&all);
+			return EXIT_FAILURE;
+		}
+		ret = kernel_log_split_boots(&all, ctx->boot_select, &boot, &count);
+		/* Only the records are wanted: they are all in hand already */
+		if (ret == 0 && !res.call_top && !res.markers) {
+			ret = kernel_log_scan_copy(&res, &all, boot.start,
+					boot.end ? boot.end : UINT64_MAX);
+			res.bytes_scanned = all.bytes_scanned;
+			kernel_log_scan_free(&all);
+			if (ret < 0) {
+				kernel_log_scan_free(&res);
+				return EXIT_FAILURE;
+			}
+			add_kernel_scan(ctx, &res);
+			kernel_log_scan_free(&res);
+			return EXIT_SUCCESS;
+		}
+		kernel_log_scan_free(&all);
+	}
+	if (ret < 0)
+		return EXIT_FAILURE;
+	/* The boot was rotated out: continue counting in the older logs */
+	if (ret > 0)
+		return read_rotated_log(ctx, filename, 0, skip - count, &res);
+
+	if (kernel_log_scan_file(filename, boot.start, boot.end, ctx->scan_threads, &res) < 0) {
+		kernel_log_scan_free(&res);
+		return EXIT_FAILURE;
+	}
+	add_kernel_scan(ctx, &res);
+	kernel_log_scan_free(&res);
+	return EXIT_SUCCESS;
+}
+
+static void kmsg_boot_record(void *arg, int id, uint64_t time_us, uint64_t ts_us)
+{
+	boot_time_ctx_t *ctx = arg;
+
+	ctx->io.lines++;
+	/* Printk offset for the milestones, tied as in printk_offset_us() */
+	if (ts_us && (id == BOOTSTAGE_KERNEL_START || !ctx->kernel_record_count))
+		ctx->printk_offset_us = (int64_t)time_us - (int64_t)ts_us;
+	add_kernel_boot_record(ctx, id, NULL, time_us);
+}
+
+/**
+ * @brief Reads kernel boot records from /dev/kmsg or a kmsg/dmesg dump.
+ * 
+ * No syslog daemon is involved; reading stops at BOOTSTAGE_KERNEL_END.
+ * Like boot_time_read_kernel_log(), the region's kernel records are used
+ * instead when there are any. Only tracker records are read: initcalls and
+ * marker lines need the kernel log.
+ * 
+ * @param ctx Parser context.
+ * @param path KMSG_DEVICE or a dump file.
+ * @return int EXIT_SUCCESS on success, EXIT_FAILURE otherwise.
+ */
+int boot_time_read_kmsg(boot_time_ctx_t *ctx, const char *path)
+{
+	if (kernel_from_region(ctx))
+		return EXIT_SUCCESS;
+	if (kmsg_read_records(path, kmsg_boot_record, ctx) < 0)
+		return EXIT_FAILURE;
+	return EXIT_SUCCESS;
+}
+
+typedef struct {
+	boot_milestone_slot_t *v;
+	size_t count;
+	size_t cap;
+	int err;
+} milestone_list_t;
+
+static void collect_milestone(void *arg, const char *name, uint64_t time_ns, uint32_t pid)
+{
+	milestone_list_t *l = arg;
+
+	if (l->count == l->cap) {
+		size_t n = l->cap ? l->cap * 2 : BOOT_MILESTONE_SLOTS;
+		boot_milestone_slot_t *p = realloc(l->v, n * sizeof(*p));
+
+		if (!p) {
+			l->err = -1;
+			return;
+		}
+		l->v = p;
+		l->cap = n;
+	}
+	l->v[l->count].time_ns = time_ns;
+	l->v[l->count].pid = pid;
+	snprintf(l->v[l->count].name, sizeof(l->v[l->count].name), "%s", name);
+	l->count++;
+}
+
+static int cmp_milestone(const void *a, const void *b)
+{
+	const boot_milestone_slot_t *x = a, *y = b;
+
+	return (x->time_ns > y->time_ns) - (x->time_ns < y->time_ns);
+}
+
+/**
+ * @brief Reads user-space milestones logged with boot_time_mark().
+ * 
+ * Milestones are A53 records with id BOOTSTAGE_USER_MILESTONE, added in
+ * time order after the kernel records. Their CLOCK_MONOTONIC time stamps
+ * run on the printk clock, not the tracker's, so they are moved by the
+ * printk offset found while reading the kernel log and then placed
+ * through the kernel clock domain. Without log time stamps (region
+ * records), printk time is taken as tracker time.
+ * 
+ * @param ctx Parser context, with the kernel records already read.
+ * @param path BOOT_MILESTONE_PATH or a saved copy of the ring.
+ * @return int EXIT_SUCCESS on success, EXIT_FAILURE otherwise.
+ */
+int boot_time_read_milestones(boot_time_ctx_t *ctx, const char *path)
+{
+	milestone_list_t l = { 0 };
+	int ret = EXIT_FAILURE;
+
+	if (boot_milestone_read(path, collect_milestone, &l) < 0)
+		return EXIT_FAILURE;
+	if (l.err) {
+		fprintf(stderr, "Out of memory reading milestones\n");
+		goto out;
+	}
+	ctx->io.bytes_read += l.count * sizeof(*l.v);
+	ctx->io.lines += l.count;
+	/* Ring order is claim order; time stamps are taken just before */
+	qsort(l.v, l.count, sizeof(*l.v), cmp_milestone);
+	for (size_t i = 0; i < l.count; i++) {
+		int64_t sns = (int64_t)l.v[i].time_ns + ctx->printk_offset_us * BOOT_TIME_NS_PER_US;
+		uint64_t ns = (sns > 0) ? (uint64_t)sns : 0;
+		uint64_t time = ns_to_unit(boot_clock_to_ns(&ctx->kernel_clock,
+				ns / BOOT_TIME_NS_PER_US) + ns % BOOT_TIME_NS_PER_US);
+
+		if (push_record(ctx, &ctx->boot_records, time,
+				(time > ctx->prev_time) ? time - ctx->prev_time : 0,
+				l.v[i].name, strlen(l.v[i].name), BOOTSTAGE_USER_MILESTONE, 0) < 0)
+			goto out;
+		ctx->prev_time = time;
+	}
+	ctx->boot_summary.count = ctx->boot_records.count;
+	ret = EXIT_SUCCESS;
+out:
+	free(l.v);
+	return ret;
+}
+
+/*
+ * Index of the last bootloader record with the given bootstage id, or -1.
+ */
+static int32_t anchor_index(const boot_time_ctx_t *ctx, int id)
+{
+	for (uint32_t i = ctx->boot_records.count; i-- > 0; )
+		if (ctx->boot_records.id[i] == id)
+			return i;
+	return -1;
+}
+
+/*
+ * Time of the last bootloader record with the given bootstage id, or 0.
+ */
+static uint64_t anchor_time(const boot_time_ctx_t *ctx, int id)
+{
+	int32_t i = anchor_index(ctx, id);
+
+	return (i < 0) ? 0 : ctx->boot_records.start_time[i];
+}
+
+/*
+ * Recomputes the times of a remote core's records from their raw counter
+ * values through the core's clock domain.
+ */
+static void place_remote_records(boot_time_ctx_t *ctx, int core)
+{
+	record_table_t *tab = &ctx->remote_records[core];
+	const uint64_t *ticks = ctx->remote_ticks[core];
+
+	for (uint32_t i = 0; i < tab->count; i++) {
+		tab->start_time[i] = ns_to_unit(boot_clock_to_ns(&ctx->remote_clock[core], ticks[i]));
+		tab->delta_time[i] = (i == 0 || tab->start_time[i - 1] == 0) ? 0 :
+			tab->start_time[i] - tab->start_time[i - 1];
+	}
+}
+
+/*
+ * Parses the record block of one remote core. The core's first record,
+ * "<label>_AWAKE", is its release by the A53 and the profile times follow
+ * from there. A block read live through /dev/mem may still be written by
+ * the firmware, so it is copied with boot_watch_read_block() instead of
+ * being decoded in place.
+ */
+static int read_remote_core(boot_time_ctx_t *ctx, bootstage_source_t *src, int core)
+{
+	const boot_remote_core_t *rc = &ctx->remote_cores[core];
+	record_table_t *tab = &ctx->remote_records[core];
+	const mcu_boot_stage_record_t *hdr, *blk;
+	const mcu_boot_record_profile_t *rec;
+	uint64_t anchor = anchor_time(ctx, rc->anchor_id);
+	char awake[BOOT_REMOTE_LABEL_MAX + sizeof("_AWAKE")];
+	uint32_t count;
+	uint64_t *ticks;
+
+	if (!bootstage_source_has(src, rc->offset, sizeof(*hdr)))
+		return 0; /* Short dump without this block */
+	hdr = bootstage_source_map(src, rc->offset, sizeof(*hdr));
+	if (hdr == NULL)
+		return -1;
+
+#ifdef DEBUG
+	printf("Subsystem(%s) record id = %x\n", rc->label, hdr -> record_id);
+	printf("%s:%d record count = %d\n", rc->label, hdr -> record_id, hdr -> record_count);
+	printf("%s:%d record start time = %llu\n", rc->label, hdr -> record_id, hdr -> start_time);
+#endif
+	count = hdr->record_count;
+	blk = bootstage_source_map(src, rc->offset,
+			MCU_BOOTRECORD_OFFSET + (size_t)count * sizeof(*rec));
+	if (blk == NULL) {
+		if (!bootstage_source_has(src, rc->offset,
+					MCU_BOOTRECORD_OFFSET + (size_t)count * sizeof(*rec)))
+			fprintf(stderr, "%s records exceed region: count=%u\n", rc->label, count);
+		return -1;
+	}
+	rec = blk->profiles;
+	ctx->io.bytes_read += MCU_BOOTRECORD_OFFSET + (size_t)count * sizeof(*rec);
+	if (src->type == BOOTSTAGE_SOURCE_DEVMEM) {
+		mcu_boot_record_profile_t *copy;
+		mcu_boot_stage_record_t snap;
+		int n = -1;
+
+		copy = arena_alloc(&ctx->arena, ((size_t)count + 1) * sizeof(*copy));
+		if (!copy)
+			return -1;
+		for (int r = 0; r < BOOT_WATCH_RETRIES && n < 0; r++)
+			n = boot_watch_read_block(blk, count, 0, &snap, copy, count);
+		if (n < 0) {
+			fprintf(stderr, "%s record block keeps changing, skipped\n", rc->label);
+			n = 0;
+		}
+		rec = copy;
+		count = n;
+	}
+
+	ticks = arena_alloc(&ctx->arena, ((size_t)count + 1) * sizeof(*ticks));
+	if (!ticks)
+		return -1;
+	/* Until synced, the counter starts at the anchor */
+	boot_clock_init(&ctx->remote_clock[core], rc->freq_hz,
+			(double)anchor * BOOT_TIME_UNIT_NS);
+	memset(&ctx->remote_fit[core], 0, sizeof(ctx->remote_fit[core]));
+
+	snprintf(awake, sizeof(awake), "%s_AWAKE", rc->label);
+	ticks[0] = 0;
+	if (push_record(ctx, tab, 0, 0, awake, strlen(awake), RECORD_NO_ID, 0) < 0)
+		return -1;
+
+	for (uint32_t i = 0; i < count; i++) {
+		const mcu_boot_record_profile_t * record = &rec[i];
+
+		ticks[i + 1] = record->time;
+		/* Profile names are fixed width and not always NUL terminated */
+		if (push_record(ctx, tab, 0, 0,
+				record->name, strnlen(record->name, sizeof(record->name)),
+				RECORD_NO_ID, 0) < 0)
+			return -1;
+	}
+	ctx->remote_ticks[core] = ticks;
+	ctx->remote_ticks_cap[core] = count + 1;
+	place_remote_records(ctx, core);
+	return 0;
+}
+
+/**
+ * @brief Appends a remote core profile that appeared after the core's block
+ * was read.
+ *
+ * Used by boot_time_watch(). The record is placed through the core's clock
+ * domain like the ones read with the block.
+ *
+ * @param ctx Parser context.
+ * @param core Remote core index.
+ * @param name Profile name.
+ * @param len Length of name.
+ * @param ticks Raw profile counter value.
+ * @return int Index of the new record, -1 on failure.
+ */
+int boot_time_add_remote_profile(boot_time_ctx_t *ctx, int core, const char *name,
+		size_t len, uint64_t ticks)
+{
+	record_table_t *tab = &ctx->remote_records[core];
+	uint64_t *t = ctx->remote_ticks[core];
+
+	if (!t)
+		return -1;
+	if (tab->count == ctx->remote_ticks_cap[core]) {
+		uint32_t cap = tab->count ? tab->count * 2 : 16;
+
+		t = arena_alloc(&ctx->arena, (size_t)cap * sizeof(*t));
+		if (!t)
+			return -1;
+		memcpy(t, ctx->remote_ticks[core], tab->count * sizeof(*t));
+		ctx->remote_ticks[core] = t;
+		ctx->remote_ticks_cap[core] = cap;
+	}
+	t[tab->count] = ticks;
+	if (push_record(ctx, tab, 0, 0, name, len, RECORD_NO_ID, 0) < 0)
+		return -1;
+	place_remote_records(ctx, core);
+	if (core == 0)
+		ctx->boot_summary.mcu_reccount = tab->count;
+	return tab->count - 1;
+}
+
+/* First record of a table with the given interned name, or -1 */
+static int32_t find_record(const record_table_t *tab, uint32_t name)
+{
+	for (uint32_t i = 0; i < tab->count; i++)
+		if (tab->name[i] == name)
+			return i;
+	return -1;
+}
+
+/**
+ * @brief Fits every remote clock to its sync points and re-places the
+ * remote records on the common timebase.
+ * 
+ * Call after all sources have been read, since sync points may refer to
+ * kernel stages. A core without sync points keeps its anchor placement.
+ * The anchor release counts as one more sync point while a core has fewer
+ * than two of its own, so a single point alone does not decide the epoch.
+ * 
+ * @param ctx Parser context.
+ * @return int 0 on success.
+ */
+int boot_time_sync_clocks(boot_time_ctx_t *ctx)
+{
+	for (int c = 0; c < ctx->remote_count; c++) {
+		const boot_remote_core_t *rc = &ctx->remote_cores[c];
+		const record_table_t *tab = &ctx->remote_records[c];
+		boot_clock_point_t pts[BOOT_CLOCK_SYNC_MAX + 1];
+		int32_t anchor;
+		size_t n = 0;
+
+		if (!ctx->remote_ticks[c])
+			continue; /* Loaded from an archive, already placed */
+		for (int k = 0; k < ctx->clock_sync_count; k++) {
+			const boot_clock_sync_t *s = &ctx->clock_sync[k];
+			int32_t li, ri;
+
+			if (strcmp(strtab_str(&ctx->names, s->core), rc->label) != 0)
+				continue;
+			li = find_record(tab, s->stage);
+			ri = find_record(&ctx->boot_records, s->ref);
+			if (li < 0 || ri < 0) {
+				fprintf(stderr, "Clock sync %s:%s=%s not found, ignored\n", rc->label,
+						strtab_str(&ctx->names, s->stage),
+						strtab_str(&ctx->names, s->ref));
+				continue;
+			}
+			pts[n].ticks = ctx->remote_ticks[c][li];
+			pts[n].ref_ns = (double)ctx->boot_records.start_time[ri] * BOOT_TIME_UNIT_NS;
+			n++;
+		}
+		if (n == 0)
+			continue;
+		anchor = anchor_index(ctx, rc->anchor_id);
+		if (n < 2 && anchor >= 0) {
+			pts[n].ticks = 0;
+			pts[n].ref_ns = (double)ctx->boot_records.start_time[anchor] * BOOT_TIME_UNIT_NS;
+			n++;
+		}
+		/* Reference records carry the bootstage counter's resolution */
+		boot_clock_fit(&ctx->remote_clock[c], pts, n,
+				BOOT_CLOCK_NS_PER_SEC / BOOT_CLOCK_DEFAULT_HZ, &ctx->remote_fit[c]);
+		place_remote_records(ctx, c);
+	}
+	return 0;
+}
+
+static int kernel_region_record(const bootstage_rec_t *r)
+{
+	return r->id >= BOOTSTAGE_KERNEL_START && r->id < BOOTSTAGE_USER_MILESTONE &&
+		r->time_us != 0;
+}
+
+/*
+ * Decodes the records the kernel appended to the region. The area either
+ * continues the U-Boot records in their layout, right after hdr->count, or
+ * starts with a bootstage header of its own, in the kernel's own layout.
+ * Records are taken up to the first one that is not a kernel record, e.g.
+ * zeroed memory.
+ */
+static void read_kernel_region(boot_time_ctx_t *ctx, bootstage_source_t *src,
+		const bootstage_layout_t *layout, size_t after)
+{
+	size_t off = ctx->kernel_region ? ctx->kernel_region : after;
+	uint32_t n = BOOT_KERNEL_REGION_MAX, i;
+	bootstage_hdr_info_t hdr;
+	bootstage_rec_t *recs;
+	const uint8_t *raw;
+	size_t len;
+
+	if (ctx->kernel_region == BOOT_KERNEL_REGION_NONE ||
+			off >= src->size || src->size - off < BOOTSTAGE_HDR_SIZE)
+		return;
+	raw = bootstage_source_map(src, off, BOOTSTAGE_HDR_SIZE);
+	if (raw && bootstage_parse_header(raw, &hdr) == 0) {
+		off += BOOTSTAGE_HDR_SIZE;
+		len = (size_t)BOOT_KERNEL_REGION_MAX * BOOTSTAGE_RECORD_STRIDE_MAX;
+		if (len > src->size - off)
+			len = src->size - off;
+		raw = bootstage_source_map(src, off, len);
+		layout = raw ? bootstage_layout_detect(&hdr, raw, len, src->size - off) : NULL;
+		if (!layout)
+			return;
+		if (hdr.count < n)
+			n = hdr.count;
+	}
+	if (n > (src->size - off) / layout->stride)
+		n = (src->size - off) / layout->stride;
+	raw = bootstage_source_map(src, off, (size_t)n * layout->stride);
+	recs = arena_alloc(&ctx->arena, ((size_t)n + 1) * sizeof(*recs));
+	if (!raw || !recs)
+		return;
+	layout->decode(raw, n, recs);
+	for (i = 0; i < n && kernel_region_record(&recs[i]); i++)
+		;
+	ctx->region_kernel = recs;
+	ctx->region_kernel_count = i;
+	ctx->io.bytes_read += (size_t)n * layout->stride;
+}
+
+/**
+ * @brief Parses U-Boot and remote core stage records from a bootstage
+ * region source.
+ * 
+ * The header, the bootstage record array and the remote core record
+ * blocks are decoded in place; only the bytes covered by hdr->count and
+ * each block's record_count are mapped and read. A block missing from a
+ * short dump leaves its core without records. Kernel records appended to
+ * the region (see boot_time_set_kernel_region()) are kept for the next
+ * boot_time_read_kernel_log() or boot_time_read_kmsg().
+ *
+ * @param ctx Parser context.
+ * @param src Region source (/dev/mem, dump file or buffer).
+ * @return int EXIT_SUCCESS on success, EXIT_FAILURE otherwise.
+ */
+int boot_time_read_bootstage(boot_time_ctx_t *ctx, bootstage_source_t *src)
+{
+	const bootstage_layout_t *layout = ctx->bootstage_layout;
+	bootstage_hdr_info_t hdr;
+	bootstage_rec_t *records;
+	const uint8_t *raw;
+	size_t avail, len;
+
+	raw = bootstage_source_map(src, 0, BOOTSTAGE_HDR_SIZE);
+	if (raw == NULL) {
+		fprintf(stderr, "Bootstage region too small for header\n");
+		return EXIT_FAILURE;
+	}
+	if (bootstage_parse_header(raw, &hdr) < 0 || hdr.size == 0) {
+		uint32_t magic, size;
+
+		memcpy(&magic, raw + 12, sizeof(magic));
+		memcpy(&size, raw + 8, sizeof(size));
+		fprintf(stderr, "Invalid bootstage header: magic=0x%08x, size=0x%x\n",
+		magic, size);
+		return EXIT_FAILURE;
+	}
+	if (hdr.version != BOOTSTAGE_VERSION)
+		fprintf(stderr, "Unknown bootstage header version %u, decoding as version %u\n",
+				hdr.version, BOOTSTAGE_VERSION);
+#ifdef DEBUG
+	printf(" Version : %u\n", hdr.version);
+	printf(" Count : %u\n", hdr.count);
+	printf(" Size : 0x%x\n", hdr.size);
+	printf(" Endian : %s\n", hdr.big_endian ? "big" : "little");
+	printf(" Next ID : %u\n", hdr.next_id);
+#endif
+	/* The bootstage records follow immediately after the header */
+	avail = src->size - BOOTSTAGE_HDR_SIZE;
+	if (layout == NULL) {
+		len = (size_t)hdr.count * BOOTSTAGE_RECORD_STRIDE_MAX;
+		if (len > avail)
+			len = avail;
+		raw = bootstage_source_map(src, BOOTSTAGE_HDR_SIZE, len);
+		layout = raw ? bootstage_layout_detect(&hdr, raw, len, avail) : NULL;
+	} else if (layout->big_endian != hdr.big_endian) {
+		fprintf(stderr, "Bootstage layout %s does not match the %s endian header\n",
+				layout->name, hdr.big_endian ? "big" : "little");
+		return EXIT_FAILURE;
+	}
+	len = (size_t)hdr.count * (layout ? layout->stride : 0);
+	raw = layout ? bootstage_source_map(src, BOOTSTAGE_HDR_SIZE, len) : NULL;
+	if (raw == NULL) {
+		fprintf(stderr, "Bootstage records exceed region: count=%u\n", hdr.count);
+		return EXIT_FAILURE;
+	}
+#ifdef DEBUG
+	printf(" Layout : %s\n", layout->name);
+#endif
+	records = arena_alloc(&ctx->arena, ((size_t)hdr.count + 1) * sizeof(*records));
+	if (records == NULL)
+		return EXIT_FAILURE;
+	layout->decode(raw, hdr.count, records);
+	ctx->io.bytes_read += BOOTSTAGE_HDR_SIZE + len;
+
+	for (uint32_t i = 0; i < hdr.count; i++) {
+		const bootstage_rec_t *rec = &records[i];
+		const char *name = get_bootstage_id_name(rec->id);
+		uint64_t time = (rec->start_us ? rec->start_us : rec->time_us) * BOOT_TIME_NS_PER_US;
+		/* Accumulated stages carry their start in start_us and the total in time_us */
+		uint64_t accum = rec->start_us ? rec->time_us * BOOT_TIME_NS_PER_US : 0;
+		if (push_record(ctx, &ctx->boot_records, time,
+				(ctx->prev_time == 0) ? 0 : (time - ctx->prev_time),
+				name, strlen(name), rec->id, accum) < 0)
+			return EXIT_FAILURE;
+		ctx->prev_time = time;
+
+		if(rec->id == BOOTSTAGE_START_UBOOT)
+			ctx->boot_summary.ustart_time = ctx->prev_time;
+		if(rec->id == BOOTSTAGE_BOOTM_HANDOFF)
+			ctx->boot_summary.uend_time = ctx->prev_time;
+	}
+	ctx->boot_summary.count = ctx->boot_records.count;
+
+	/* Remote core (MCU/R5F/DSP) record blocks, each on its own anchor */
+	for (int c = 0; c < ctx->remote_count; c++)
+		if (read_remote_core(ctx, src, c) < 0)
+			return EXIT_FAILURE;
+	read_kernel_region(ctx, src, layout, BOOTSTAGE_HDR_SIZE + len);
+	ctx->boot_summary.mcu_start_time = anchor_time(ctx,
+			ctx->remote_count ? ctx->remote_cores[0].anchor_id : BOOTSTAGE_START_MCU);
+	ctx->boot_summary.mcu_reccount = ctx->remote_records[0].count;
+
+	return EXIT_SUCCESS;
+}
+
+/**
+ * @brief Reads U-Boot stage records from memory.
+ * 
+ * This function extracts boot stage information from the preserved
+ * bootstage region through /dev/mem.
+ * 
+ * @param ctx Parser context.
+ */
+int boot_time_read_bootstage_mem(boot_time_ctx_t *ctx)
+{
+	bootstage_source_t src;
+	int ret;
+
+	if (bootstage_source_open_mem(&src, BOOTSTAGE_PRESERVED_ADDR, BOOTSTAGE_SIZE) < 0)
+		return EXIT_FAILURE;
+	ret = boot_time_read_bootstage(ctx, &src);
+	bootstage_source_close(&src);
+	return ret;
+}
+
+/**
+ * @brief Reads U-Boot stage records from a raw dump of the bootstage region.
+ * 
+ * @param ctx Parser context.
+ * @param filename Path of a dump starting at BOOTSTAGE_PRESERVED_ADDR.
+ */
+int boot_time_read_bootstage_file(boot_time_ctx_t *ctx, const char *filename)
+{
+	bootstage_source_t src;
+	int ret;
+
+	if (bootstage_source_open_file(&src, filename) < 0)
+		return EXIT_FAILURE;
+	ret = boot_time_read_bootstage(ctx, &src);
+	bootstage_source_close(&src);
+	return ret;
+}
+
+/**
+ * @brief Reads U-Boot stage records from a copy of the bootstage region.
+ * 
+ * @param ctx Parser context.
+ * @param buf Region copy starting at BOOTSTAGE_PRESERVED_ADDR.
+ * @param len Length of buf.
+ */
+int boot_time_read_bootstage_buffer(boot_time_ctx_t *ctx, const void *buf, size_t len)
+{
+	bootstage_source_t src;
+	int ret;
+
+	bootstage_source_open_buffer(&src, buf, len);
+	ret = boot_time_read_bootstage(ctx, &src);
+	bootstage_source_close(&src);
+	return ret;
+}
+
+/**
+ * @brief Reads a boot from a capture file written by boot_time_capture.
+ * 
+ * The captured region bytes are parsed like a dump, and the captured
+ * kernel lines are scanned like a kernel log, so marker configs and
+ * initcall listings apply as well when the lines were captured.
+ * 
+ * @param ctx Parser context.
+ * @param path Capture file.
+ * @return int EXIT_SUCCESS on success, EXIT_FAILURE otherwise.
+ */
+int boot_time_read_capture(boot_time_ctx_t *ctx, const char *path)
+{
+	kernel_log_scan_result_t res = { 0 };
+	boot_capture_t cap;
+	int ret;
+
+	if (boot_capture_load(&cap, path) < 0)
+		return EXIT_FAILURE;
+	ret = boot_time_read_bootstage_buffer(ctx, cap.region, cap.hdr.region_size);
+	if (kernel_from_region(ctx)) {
+		boot_capture_free(&cap);
+		return ret;
+	}
+	res.call_top = ctx->kernel_call_top;
+	res.markers = ctx->markers;
+	if (kernel_log_scan_buffer(cap.klog, cap.klog_len, 0, ctx->scan_threads, &res) < 0)
+		ret = EXIT_FAILURE;
+	else
+		add_kernel_scan(ctx, &res);
+	kernel_log_scan_free(&res);
+	boot_capture_free(&cap);
+	return ret;
+}
+
+/**
+ * @brief Loads one boot back from a columnar boot archive.
+ * 
+ * @param ctx Parser context, normally empty.
+ * @param path Archive file.
+ * @param boot 0 for the latest archived boot, -1 for the one before, and
+ * so on.
+ * @return int EXIT_SUCCESS on success, EXIT_FAILURE otherwise.
+ */
+int boot_time_read_archive(boot_time_ctx_t *ctx, const char *path, int boot)
+{
+	const boot_archive_boot_t *b;
+	const boot_archive_core_t *cores;
+	boot_remote_core_t remote[BOOT_REMOTE_CORES_MAX];
+	const uint32_t *names;
+	const int32_t *ids;
+	uint64_t *start = NULL, *delta = NULL, *dur = NULL;
+	boot_archive_t ar;
+	int ret = EXIT_FAILURE;
+	int64_t idx;
+	uint32_t n, core_end;
+	int core = -1;
+
+	if (boot_archive_open(&ar, path) < 0)
+		return EXIT_FAILURE;
+	idx = (int64_t)ar.boot_count - 1 + boot;
+	if (boot > 0 || idx < 0) {
+		fprintf(stderr, "Boot %d not in archive (%u boots)\n", boot, ar.boot_count);
+		goto out;
+	}
+	b = &ar.boots[idx];
+	n = b->count + b->mcu_reccount;
+	names = boot_archive_record_names(&ar, idx);
+	ids = boot_archive_record_ids(&ar, idx);
+	cores = boot_archive_boot_cores(&ar, idx);
+	start = malloc((n ? n : 1) * sizeof(*start));
+	delta = malloc((n ? n : 1) * sizeof(*delta));
+	dur = malloc((n ? n : 1) * sizeof(*dur));
+	if (!start || !delta || !dur || !names || !ids || !cores ||
+			b->core_count > BOOT_REMOTE_CORES_MAX ||
+			boot_archive_decode(&ar, idx, start, delta, dur) < 0) {
+		fprintf(stderr, "Corrupt boot %" PRId64 " in archive %s\n", idx, path);
+		goto out;
+	}
+
+	for (uint32_t i = 0; i < b->core_count; i++) {
+		memset(&remote[i], 0, sizeof(remote[i]));
+		snprintf(remote[i].label, sizeof(remote[i].label), "%s",
+				boot_archive_name(&ar, cores[i].label));
+		remote[i].offset = cores[i].offset;
+		remote[i].anchor_id = cores[i].anchor_id;
+	}
+	boot_time_set_remote_cores(ctx, remote, b->core_count);
+
+	core_end = b->count;
+	for (uint32_t i = 0; i < n; i++) {
+		const char *name = boot_archive_name(&ar, names[i]);
+
+		/* Remote records follow core by core */
+		while (i == core_end && core + 1 < (int)b->core_count)
+			core_end += cores[++core].count;
+		if (push_record(ctx, (core < 0) ? &ctx->boot_records : &ctx->remote_records[core],
+				start[i], delta[i], name, strlen(name), ids[i], dur[i]) < 0)
+			goto out;
+	}
+	ctx->boot_summary.ustart_time = b->ustart_time;
+	ctx->boot_summary.mcu_start_time = b->mcu_start_time;
+	ctx->boot_summary.uend_time = b->uend_time;
+	ctx->boot_summary.kstart_time = b->kstart_time;
+	ctx->boot_summary.kend_time = b->kend_time;
+	ctx->boot_summary.count = ctx->boot_records.count;
+	ctx->boot_summary.mcu_reccount = ctx->remote_records[0].count;
+	ret = EXIT_SUCCESS;
+out:
+	free(start);
+	free(delta);
+	free(dur);
+	boot_archive_close(&ar);
+	return ret;
+}
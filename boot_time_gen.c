@@ -0,0 +1,768 @@
+/*
+ *  Copyright (C) 2025 Texas Instruments Incorporated
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions
+ *  are met:
+ *
+ *    Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *
+ *    Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the
+ *    distribution.
+ *
+ *    Neither the name of Texas Instruments Incorporated nor the names of
+ *    its contributors may be used to endorse or promote products derived
+ *    from this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ *  "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ *  LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ *  A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ *  OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ *  SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ *  LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ *  DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ *  THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ *  (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ *  OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/**
+ * \file boot_time_gen.c
+ * \brief Synthetic boot data for benchmarks and parser development:
+ * bootstage region images, kernel logs from kilobytes to gigabytes in
+ * syslog, kmsg or dmesg format, user-space milestone rings and fleet
+ * corpora of many boots.
+ *
+ * Every boot follows the am62xx sample boot of the README, with each stage
+ * stretched or shrunk by up to --noise percent. Boot k of a seed is always
+ * the same boot, so "region --boots N" is the last boot of
+ * "log --boots N" with the same seed.
+ */
+
+/* ========================================================================== */
+/*                           Include Files                                    */
+/* ========================================================================== */
+
+#include <getopt.h>
+#include <stdarg.h>
+#include <limits.h>
+#include <sys/stat.h>
+
+#include "boot_time_report.h"
+#include "boot_milestone.h"
+#include "bootstage_layout.h"
+
+/* ========================================================================== */
+/*                           Macros & Typedefs                                */
+/* ========================================================================== */
+
+/* Output buffer of log writes */
+#define GEN_IO_BUF		(1 << 20)
+/* Log size of each fleet boot unless --size is given */
+#define GEN_FLEET_LOG_SIZE	(64 << 10)
+
+typedef enum {
+	GEN_FMT_SYSLOG,
+	GEN_FMT_KMSG,
+	GEN_FMT_DMESG,
+} gen_format_t;
+
+/* ========================================================================== */
+/*                           Data Structures                                  */
+/* ========================================================================== */
+
+typedef struct {
+	int id;
+	uint32_t ms; /* Start in the sample boot */
+	uint32_t accum_ms; /* Accumulated duration, 0 for marks */
+} gen_stage_t;
+
+typedef struct {
+	const char *name;
+	uint32_t us; /* Ticks since the core's release, at 1 MHz */
+} gen_profile_t;
+
+typedef struct {
+	uint64_t seed;
+	unsigned noise; /* Percent each stage may deviate from the sample */
+	unsigned outliers; /* Percent of boots with one stage three times slower */
+	unsigned boots;
+	uint64_t size; /* Log bytes */
+	unsigned calls; /* initcall_debug lines per boot */
+	unsigned extra_records; /* Added U-Boot and remote core records */
+	int kernel_records; /* Kernel start/end records follow the U-Boot ones */
+	uint64_t printk_offset_us; /* Tracker time at printk time 0 */
+	gen_format_t format;
+	const bootstage_layout_t *layout; /* NULL: this host's struct layout */
+	boot_remote_core_t remote[BOOT_REMOTE_CORES_MAX];
+	int nremote;
+} gen_opts_t;
+
+/* Times of one synthetic boot, in microseconds since power on */
+typedef struct {
+	uint64_t stage_us[16];
+	uint64_t accum_us[16];
+	uint64_t mcu_us[16]; /* Profile ticks since release */
+	uint64_t kernel_start_us;
+	uint64_t kernel_end_us;
+} gen_boot_t;
+
+/* ========================================================================== */
+/*                          Global Variables                                  */
+/* ========================================================================== */
+
+static const gen_stage_t uboot_stages[] = {
+	{ 171, 0, 0 }, /* BOOTSTAGE_AWAKE */
+	{ 178, 843, 0 },
+	{ 202, 843, 61 }, /* BOOTSTAGE_ACCUM_DM_F */
+	{ 179, 1951, 0 },
+	{ 203, 1951, 48 }, /* BOOTSTAGE_ACCUM_DM_R */
+	{ 64, 2032, 0 },
+	{ 65, 2053, 0 },
+	{ 186, 2055, 0 },
+	{ 176, 2661, 0 }, /* BOOTSTAGE_START_MCU */
+	{ 184, 2959, 0 },
+	{ 15, 3016, 0 },
+	{ 185, 3016, 0 }, /* BOOTSTAGE_BOOTM_HANDOFF */
+};
+#define GEN_NSTAGES	(sizeof(uboot_stages) / sizeof(uboot_stages[0]))
+/* Extra U-Boot records go after BOOTSTAGE_MAIN_LOOP */
+#define GEN_EXTRA_AFTER	7
+
+static const gen_profile_t mcu_profiles[] = {
+	{ "BOARD_PERIPHERALS_INIT", 0 },
+	{ "MAIN_TASK_CREATE", 140 },
+	{ "FIRST_TASK", 910 },
+	{ "DRIVERS_OPEN", 1020 },
+	{ "BOARD_DRIVERS_OPEN", 1250 },
+	{ "IPC_SYNC_FOR_LINUX", 3974000 },
+	{ "IPC_REGISTER_CLIENT", 3974120 },
+	{ "IPC_SUSPEND_TASK", 3974200 },
+	{ "IPC_RECEIVE_TASK", 3974350 },
+	{ "IPC_SYNC_ALL", 4125000 },
+};
+#define GEN_NPROFILES	(sizeof(mcu_profiles) / sizeof(mcu_profiles[0]))
+/* Extra profiles go after BOARD_DRIVERS_OPEN */
+#define GEN_EXTRA_PROFILES_AFTER	5
+
+/* Kernel start and end in the sample boot */
+#define GEN_KERNEL_START_MS	3478
+#define GEN_KERNEL_END_MS	6000
+
+/* User-space milestones, in microseconds after the kernel end */
+static const gen_profile_t milestones[] = {
+	{ "basic-system", 310000 },
+	{ "multi-user", 870000 },
+	{ "first-frame", 1420000 },
+};
+#define GEN_NMILESTONES	(sizeof(milestones) / sizeof(milestones[0]))
+
+static const char *const filler[] = {
+	"usb 1-1: new high-speed USB device number 2 using xhci-hcd",
+	"EXT4-fs (mmcblk1p2): mounted filesystem with ordered data mode. Quota mode: none.",
+	"remoteproc remoteproc0: powering up 78000000.r5f",
+	"davinci_mdio 8000f00.mdio: davinci mdio revision 9.7, bus freq 1000000",
+	"am65-cpsw-nuss 8000000.ethernet eth0: Link is Up - 1Gbps/Full - flow control rx/tx",
+	"mmc0: new HS200 MMC card at address 0001",
+	"random: crng init done",
+	"audit: type=1334 audit(1697450401.123:2): prog-id=5 op=LOAD",
+	"NET: Registered PF_INET6 protocol family",
+	"platform 30200000.dss: Fixed dependency cycle(s) with /bus@f0000/i2c@20000000/bridge@3b",
+	"k3-dsp 7e000000.dsp: configured DSP for remoteproc mode",
+	"systemd[1]: Started Load Kernel Modules.",
+};
+#define GEN_NFILLER	(sizeof(filler) / sizeof(filler[0]))
+
+static const char *const initcalls[] = {
+	"inet_init", "clk_disable_unused", "regulator_init_complete", "deferred_probe_initcall",
+	"ti_sci_init", "omap_i2c_init_driver", "sdhci_am654_driver_init",
+	"am65_cpsw_nuss_driver_init", "k3_r5_rproc_driver_init", "tidss_platform_driver_init",
+};
+#define GEN_NINITCALLS	(sizeof(initcalls) / sizeof(initcalls[0]))
+
+static const char *const probe_devices[] = {
+	"fd00000.gpu", "30200000.dss", "8000000.ethernet", "fa10000.mmc", "20000000.i2c",
+	"78000000.r5f", "2b300050.target-module", "f900000.dwc3-usb",
+};
+#define GEN_NPROBES	(sizeof(probe_devices) / sizeof(probe_devices[0]))
+
+
+/* ========================================================================== */
+/*                          Function Definitions                              */
+/* ========================================================================== */
+
+static uint64_t rng_next(uint64_t *s)
+{
+	/* xorshift64* */
+	*s ^= *s >> 12;
+	*s ^= *s << 25;
+	*s ^= *s >> 27;
+	return *s * 0x2545f4914f6cdd1dull;
+}
+
+static void rng_seed(uint64_t *s, uint64_t seed, uint64_t stream)
+{
+	*s = (seed + 1) * 0x9e3779b97f4a7c15ull ^ (stream + 1) * 0xbf58476d1ce4e5b9ull;
+	if (*s == 0)
+		*s = 1;
+	rng_next(s);
+}
+
+/* Uniform in [0, n) */
+static uint64_t rng_below(uint64_t *s, uint64_t n)
+{
+	return n ? rng_next(s) % n : 0;
+}
+
+/* d stretched or shrunk by up to pct percent */
+static uint64_t jitter(uint64_t *s, uint64_t d, unsigned pct)
+{
+	int64_t span = (int64_t)(d * pct / 100);
+
+	if (span == 0)
+		return d;
+	return d + (int64_t)rng_below(s, 2 * span + 1) - span;
+}
+
+/*
+ * Builds boot k of the seed. Each stage keeps its place in the sample boot
+ * but every gap between stages is jittered on its own.
+ */
+static void gen_boot(const gen_opts_t *o, unsigned k, gen_boot_t *b)
+{
+	uint64_t s, t = 0, slow = GEN_NSTAGES;
+
+	rng_seed(&s, o->seed, k);
+	if (rng_below(&s, 100) < o->outliers)
+		slow = 1 + rng_below(&s, GEN_NSTAGES - 1);
+	for (size_t i = 0; i < GEN_NSTAGES; i++) {
+		uint64_t d = i ? (uboot_stages[i].ms - uboot_stages[i - 1].ms) * 1000ull : 0;
+
+		d = jitter(&s, d, o->noise);
+		if (i == slow)
+			d *= 3;
+		t += d;
+		b->stage_us[i] = t;
+		b->accum_us[i] = jitter(&s, uboot_stages[i].accum_ms * 1000ull, o->noise);
+	}
+	for (size_t i = 0; i < GEN_NPROFILES; i++) {
+		uint64_t d = i ? mcu_profiles[i].us - mcu_profiles[i - 1].us : 0;
+		b->mcu_us[i] = (i ? b->mcu_us[i - 1] : 0) + jitter(&s, d, o->noise);
+	}
+	b->kernel_start_us = t + jitter(&s,
+			(GEN_KERNEL_START_MS - uboot_stages[GEN_NSTAGES - 1].ms) * 1000ull, o->noise);
+	b->kernel_end_us = b->kernel_start_us + jitter(&s,
+			(GEN_KERNEL_END_MS - GEN_KERNEL_START_MS) * 1000ull, o->noise);
+}
+
+static void put_record(struct uboot_bootstage_record *r, int id, uint64_t us,
+		uint64_t accum_us)
+{
+	memset(r, 0, sizeof(*r));
+	r->id = id;
+	if (accum_us) {
+		r->start_us = us;
+		r->time_us = accum_us;
+	} else {
+		r->time_us = us;
+	}
+}
+
+static void put_field(uint8_t *p, int size, int big_endian, uint64_t v)
+{
+	for (int i = 0; i < size; i++)
+		p[big_endian ? size - 1 - i : i] = (uint8_t)(v >> (8 * i));
+}
+
+/*
+ * Rewrites the header and the first total records written with this host's
+ * struct layout in the byte order and record layout of another producer.
+ */
+static void encode_layout(uint8_t *region, const bootstage_layout_t *l, uint32_t total)
+{
+	static uint8_t out[BOOTSTAGE_SIZE];
+	const struct uboot_bootstage_hdr *hdr = (const struct uboot_bootstage_hdr *)region;
+	const struct uboot_bootstage_record *rec =
+		(const struct uboot_bootstage_record *)(region + sizeof(*hdr));
+	uint8_t *p = out + BOOTSTAGE_HDR_SIZE;
+	int be = l->big_endian;
+
+	put_field(out, 4, be, hdr->version);
+	put_field(out + 4, 4, be, hdr->count);
+	put_field(out + 8, 4, be, (uint64_t)hdr->count * l->stride);
+	put_field(out + 12, 4, be, hdr->magic);
+	put_field(out + 16, 4, be, hdr->next_id);
+	for (uint32_t i = 0; i < total; i++, p += l->stride) {
+		memset(p, 0, l->stride);
+		put_field(p, l->ulong_size, be, rec[i].time_us);
+		put_field(p + l->ulong_size, l->start_size, be, rec[i].start_us);
+		put_field(p + 2 * l->ulong_size + l->ptr_size, 4, be, (uint32_t)rec[i].flags);
+		put_field(p + 2 * l->ulong_size + l->ptr_size + 4, 4, be, (uint32_t)rec[i].id);
+	}
+	memset(region, 0, sizeof(*hdr) + (size_t)total * sizeof(*rec));
+	memcpy(region, out, p - out);
+}
+
+/*
+ * Writes the bootstage header and records followed by one record block per
+ * remote core.
+ */
+static int write_region(const char *path, const gen_opts_t *o, const gen_boot_t *b)
+{
+	static uint8_t region[BOOTSTAGE_SIZE];
+	struct uboot_bootstage_hdr *hdr = (struct uboot_bootstage_hdr *)region;
+	struct uboot_bootstage_record *rec =
+		(struct uboot_bootstage_record *)(region + sizeof(*hdr));
+	size_t max = BOOTSTAGE_SIZE;
+	uint32_t n = 0;
+	FILE *fp;
+
+	/* U-Boot records end where the first remote core block starts */
+	for (int c = 0; c < o->nremote; c++)
+		if (o->remote[c].offset < max)
+			max = o->remote[c].offset;
+	max = (max > sizeof(*hdr)) ? (max - sizeof(*hdr)) / sizeof(*rec) : 0;
+	if (max < GEN_NSTAGES + 2) {
+		fprintf(stderr, "No room for the U-Boot records before the remote cores\n");
+		return -1;
+	}
+	memset(region, 0, sizeof(region));
+	for (size_t i = 0; i < GEN_NSTAGES; i++) {
+		put_record(&rec[n++], uboot_stages[i].id, b->stage_us[i], b->accum_us[i]);
+		if (i != GEN_EXTRA_AFTER)
+			continue;
+		/* BOOTSTAGE_ID_USER marks spread over the gap to the next stage */
+		for (unsigned e = 0; e < o->extra_records && n < max - GEN_NSTAGES - 2; e++)
+			put_record(&rec[n++], 207, b->stage_us[i] +
+					(b->stage_us[i + 1] - b->stage_us[i]) * (e + 1) /
+					(o->extra_records + 1), 0);
+	}
+	hdr->version = BOOTSTAGE_VERSION;
+	hdr->count = n;
+	hdr->size = n * sizeof(*rec);
+	hdr->magic = BOOTSTAGE_MAGIC;
+	hdr->next_id = 300;
+	/* Appended by the kernel after hdr->count, which it leaves alone */
+	if (o->kernel_records) {
+		put_record(&rec[n], BOOTSTAGE_KERNEL_START, b->kernel_start_us, 0);
+		put_record(&rec[n + 1], BOOTSTAGE_KERNEL_END, b->kernel_end_us, 0);
+	}
+	if (o->layout)
+		encode_layout(region, o->layout, n + (o->kernel_records ? 2 : 0));
+
+	for (int c = 0; c < o->nremote; c++) {
+		const boot_remote_core_t *rc = &o->remote[c];
+		mcu_boot_stage_record_t *blk;
+		size_t end = BOOTSTAGE_SIZE, cap;
+		uint32_t count = 0;
+
+		for (int i = 0; i < o->nremote; i++)
+			if (o->remote[i].offset > rc->offset && o->remote[i].offset < end)
+				end = o->remote[i].offset;
+		if (rc->offset + MCU_BOOTRECORD_OFFSET > end) {
+			fprintf(stderr, "Remote core %s outside the region\n", rc->label);
+			return -1;
+		}
+		cap = (end - rc->offset - MCU_BOOTRECORD_OFFSET) / sizeof(mcu_boot_record_profile_t);
+		blk = (mcu_boot_stage_record_t *)(region + rc->offset);
+		blk->record_id = c + 1;
+		if (cap < GEN_NPROFILES) {
+			fprintf(stderr, "Remote core %s block too small\n", rc->label);
+			return -1;
+		}
+		for (size_t i = 0; i < GEN_NPROFILES; i++) {
+			mcu_boot_record_profile_t *p = &blk->profiles[count++];
+
+			snprintf(p->name, sizeof(p->name), "%s", mcu_profiles[i].name);
+			p->time = b->mcu_us[i];
+			if (i + 1 != GEN_EXTRA_PROFILES_AFTER)
+				continue;
+			for (unsigned e = 0; e < o->extra_records && count < cap - GEN_NPROFILES; e++) {
+				p = &blk->profiles[count++];
+				snprintf(p->name, sizeof(p->name), "TASK_%u", e);
+				p->time = b->mcu_us[i] + (b->mcu_us[i + 1] - b->mcu_us[i]) *
+					(e + 1) / (o->extra_records + 1);
+			}
+		}
+		blk->record_count = count;
+	}
+
+	fp = fopen(path, "wb");
+	if (!fp) {
+		perror(path);
+		return -1;
+	}
+	if (fwrite(region, sizeof(region), 1, fp) != 1 || fclose(fp) != 0) {
+		perror(path);
+		return -1;
+	}
+	return 0;
+}
+
+/* Appends one kernel message with the prefix of the log format */
+static void put_line(FILE *fp, const gen_opts_t *o, uint64_t ts_us, uint64_t *seq,
+		const char *fmt, ...)
+{
+	uint64_t sec, usec;
+	va_list ap;
+
+	/* Lines are stamped with printk time, the tracker values are not */
+	ts_us = (ts_us > o->printk_offset_us) ? ts_us - o->printk_offset_us : 0;
+	sec = ts_us / 1000000;
+	usec = ts_us % 1000000;
+
+	switch (o->format) {
+	case GEN_FMT_SYSLOG:
+		fprintf(fp, "Oct 16 %02u:%02u:%02u am62xx kernel: [%5" PRIu64 ".%06" PRIu64 "] ",
+				(unsigned)(10 + sec / 3600 % 14), (unsigned)(sec / 60 % 60),
+				(unsigned)(sec % 60), sec, usec);
+		break;
+	case GEN_FMT_KMSG:
+		fprintf(fp, "6,%" PRIu64 ",%" PRIu64 ",-;", (*seq)++, ts_us);
+		break;
+	case GEN_FMT_DMESG:
+		fprintf(fp, "[%5" PRIu64 ".%06" PRIu64 "] ", sec, usec);
+		break;
+	}
+	va_start(ap, fmt);
+	vfprintf(fp, fmt, ap);
+	va_end(ap);
+	fputc('\n', fp);
+}
+
+/*
+ * Writes about budget bytes of kernel log for one boot: the boot itself
+ * from BOOTSTAGE_KERNEL_START to BOOTSTAGE_KERNEL_END with its initcalls,
+ * then runtime messages until the budget is used up.
+ */
+static void write_boot_log(FILE *fp, const gen_opts_t *o, unsigned k, const gen_boot_t *b,
+		uint64_t budget, uint64_t *seq)
+{
+	uint64_t s, start = ftello(fp), ts = b->kernel_start_us;
+	uint64_t boot_us = b->kernel_end_us - b->kernel_start_us;
+	/* Roughly 100 bytes per line; a tenth of the lines belong to the boot */
+	uint64_t lines = budget / 100 + 1, boot_lines = lines / 10 + o->calls * 2 + 1;
+	uint64_t step = boot_us / boot_lines + 1;
+
+	rng_seed(&s, o->seed, k + 0x10000);
+	put_line(fp, o, ts, seq, "Booting Linux on physical CPU 0x0000000000 [0x410fd034]");
+	put_line(fp, o, ts, seq, "[BOOT TRACKER] ID:%d BOOTSTAGE_KERNEL_START = %" PRIu64,
+			BOOTSTAGE_KERNEL_START, b->kernel_start_us);
+	for (uint64_t i = 0; i < boot_lines && ts + step < b->kernel_end_us; i++) {
+		ts += 1 + rng_below(&s, 2 * step);
+		if (ts >= b->kernel_end_us)
+			break;
+		if (rng_below(&s, boot_lines) < o->calls) {
+			static const uint64_t scale[] = { 1, 10, 100, 1000 };
+			/* Durations spread over four orders of magnitude */
+			uint64_t dur = (1 + rng_below(&s, 9)) * scale[rng_below(&s, 4)];
+
+			if (rng_below(&s, 3)) {
+				const char *fn = initcalls[rng_below(&s, GEN_NINITCALLS)];
+				put_line(fp, o, ts, seq, "calling  %s+0x0/0x4c @ 1", fn);
+				put_line(fp, o, ts + dur, seq,
+						"initcall %s+0x0/0x4c returned 0 after %" PRIu64 " usecs", fn, dur);
+			} else {
+				put_line(fp, o, ts + dur, seq, "probe of %s returned %d after %" PRIu64 " usecs",
+						probe_devices[rng_below(&s, GEN_NPROBES)],
+						rng_below(&s, 8) ? 0 : -517, dur);
+			}
+			ts += dur;
+		} else {
+			put_line(fp, o, ts, seq, "%s", filler[rng_below(&s, GEN_NFILLER)]);
+		}
+	}
+	ts = b->kernel_end_us;
+	put_line(fp, o, ts, seq, "[BOOT TRACKER] ID:%d BOOTSTAGE_KERNEL_END = %" PRIu64,
+			BOOTSTAGE_KERNEL_END, b->kernel_end_us);
+	while ((uint64_t)ftello(fp) - start < budget) {
+		ts += 1 + rng_below(&s, 20000);
+		put_line(fp, o, ts, seq, "%s", filler[rng_below(&s, GEN_NFILLER)]);
+	}
+}
+
+/* Writes o->boots boots of about o->size / o->boots bytes each */
+static int write_log(const char *path, const gen_opts_t *o, unsigned first)
+{
+	static char iobuf[GEN_IO_BUF];
+	uint64_t seq = 0;
+	FILE *fp;
+
+	fp = fopen(path, "w");
+	if (!fp) {
+		perror(path);
+		return -1;
+	}
+	setvbuf(fp, iobuf, _IOFBF, sizeof(iobuf));
+	for (unsigned k = first; k < first + o->boots; k++) {
+		gen_boot_t b;
+
+		gen_boot(o, k, &b);
+		write_boot_log(fp, o, k, &b, o->size / o->boots, &seq);
+	}
+	if (ferror(fp) | (fclose(fp) != 0)) {
+		perror(path);
+		return -1;
+	}
+	return 0;
+}
+
+/*
+ * Writes a milestone ring of the boot as boot_time_mark() would leave it:
+ * a few user-space milestones after the kernel end, stamped with
+ * CLOCK_MONOTONIC, i.e. printk time.
+ */
+static int write_milestones(const char *path, const gen_opts_t *o, unsigned k,
+		const gen_boot_t *b)
+{
+	boot_milestone_ring_t *ring;
+	uint64_t s, t = b->kernel_end_us;
+	FILE *fp;
+	int ret = 0;
+
+	ring = calloc(1, sizeof(*ring));
+	if (!ring)
+		return -1;
+	ring->magic = BOOT_MILESTONE_MAGIC;
+	ring->version = BOOT_MILESTONE_VERSION;
+	ring->nslots = BOOT_MILESTONE_SLOTS;
+	ring->slot_size = sizeof(boot_milestone_slot_t);
+	rng_seed(&s, o->seed, k + 0x20000);
+	for (size_t i = 0; i < GEN_NMILESTONES; i++) {
+		boot_milestone_slot_t *m = &ring->slots[ring->head];
+		uint64_t d = milestones[i].us - (i ? milestones[i - 1].us : 0);
+
+		t += jitter(&s, d, o->noise);
+		m->time_ns = (t > o->printk_offset_us ? t - o->printk_offset_us : 0) * 1000;
+		m->pid = 1;
+		snprintf(m->name, sizeof(m->name), "%s", milestones[i].name);
+		m->seq = ++ring->head;
+	}
+
+	fp = fopen(path, "w");
+	if (!fp || fwrite(ring, sizeof(*ring), 1, fp) != 1)
+		ret = -1;
+	if (fp && fclose(fp) != 0)
+		ret = -1;
+	if (ret < 0)
+		perror(path);
+	free(ring);
+	return ret;
+}
+
+/* Writes <dir>/boot_<k>.bin and .log for every boot */
+static int write_fleet(const char *dir, gen_opts_t *o)
+{
+	unsigned boots = o->boots;
+	char path[PATH_MAX];
+
+	if (mkdir(dir, 0755) < 0 && errno != EEXIST) {
+		perror(dir);
+		return -1;
+	}
+	o->boots = 1;
+	for (unsigned k = 0; k < boots; k++) {
+		gen_boot_t b;
+
+		gen_boot(o, k, &b);
+		snprintf(path, sizeof(path), "%s/boot_%05u.bin", dir, k);
+		if (write_region(path, o, &b) < 0)
+			return -1;
+		snprintf(path, sizeof(path), "%s/boot_%05u.log", dir, k);
+		if (write_log(path, o, k) < 0)
+			return -1;
+	}
+	return 0;
+}
+
+/* Parses a byte count with an optional K, M or G suffix */
+static int parse_size(const char *s, uint64_t *size)
+{
+	char *end;
+	double v = strtod(s, &end);
+
+	if (end == s || v < 0)
+		return -1;
+	switch (*end) {
+	case 'K': case 'k': v *= 1 << 10; end++; break;
+	case 'M': case 'm': v *= 1 << 20; end++; break;
+	case 'G': case 'g': v *= 1 << 30; end++; break;
+	}
+	if (*end)
+		return -1;
+	*size = (uint64_t)v;
+	return 0;
+}
+
+static void usage(const char *prog)
+{
+	fprintf(stderr,
+		"Usage: %s <region|log|milestones|fleet> -o <output> [options]\n"
+		"  region              bootstage region image of the last boot\n"
+		"  log                 kernel log with --boots boots\n"
+		"  milestones          user-space milestone ring of the last boot\n"
+		"  fleet               directory of boot_<n>.bin/.log pairs, one per boot\n"
+		"  -o, --output <path>  output file, or directory for fleet\n"
+		"  -s, --seed <n>      random seed (default 1)\n"
+		"  -n, --noise <pct>   stage time deviation from the sample boot (default 5)\n"
+		"      --outliers <pct>  boots with one stage three times slower (default 0)\n"
+		"  -b, --boots <n>     boots in the log or fleet (default 1)\n"
+		"  -S, --size <bytes>  log size, K/M/G suffixes allowed (default 1M, fleet 64K\n"
+		"                      per boot)\n"
+		"  -f, --format <syslog|kmsg|dmesg>  log format (default syslog)\n"
+		"  -c, --initcalls <n>  initcall_debug lines per boot (default 0)\n"
+		"      --printk-offset <ms>  tracker time at which printk time stamps\n"
+		"                      start (default 0)\n"
+		"  -r, --records <n>   extra U-Boot and remote core records (default 0)\n"
+		"  -K, --kernel-records  append the kernel start/end records to the region,\n"
+		"                      as a kernel writing them there would\n"
+		"  -L, --layout <name>  bootstage record layout of another producer, e.g.\n"
+		"                      le32 or be64 (default: this host's)\n"
+		"      --remote-core <label@offset[:anchor id[:counter Hz]]>  remote core block;\n"
+		"                      repeat for each core (default MCU@0x80000:176, 1 MHz\n"
+		"                      counter)\n"
+		"  -h, --help          show this help\n",
+		prog);
+}
+
+int main(int argc, char *argv[])
+{
+	static const struct option long_opts[] = {
+		{ "output", required_argument, NULL, 'o' },
+		{ "seed", required_argument, NULL, 's' },
+		{ "noise", required_argument, NULL, 'n' },
+		{ "outliers", required_argument, NULL, 'O' },
+		{ "boots", required_argument, NULL, 'b' },
+		{ "size", required_argument, NULL, 'S' },
+		{ "format", required_argument, NULL, 'f' },
+		{ "initcalls", required_argument, NULL, 'c' },
+		{ "records", required_argument, NULL, 'r' },
+		{ "remote-core", required_argument, NULL, 'M' },
+		{ "layout", required_argument, NULL, 'L' },
+		{ "kernel-records", no_argument, NULL, 'K' },
+		{ "printk-offset", required_argument, NULL, 'P' },
+		{ "help", no_argument, NULL, 'h' },
+		{ NULL, 0, NULL, 0 }
+	};
+	gen_opts_t o = {
+		.seed = 1,
+		.noise = 5,
+		.boots = 1,
+		.format = GEN_FMT_SYSLOG,
+	};
+	const char *out = NULL, *mode;
+	int size_given = 0;
+	int opt, ret;
+
+	while ((opt = getopt_long(argc, argv, "o:s:n:b:S:f:c:r:L:Kh", long_opts, NULL)) != -1) {
+		switch (opt) {
+		case 'o':
+			out = optarg;
+			break;
+		case 's':
+			o.seed = strtoull(optarg, NULL, 0);
+			break;
+		case 'n':
+			o.noise = atoi(optarg);
+			break;
+		case 'O':
+			o.outliers = atoi(optarg);
+			break;
+		case 'b':
+			o.boots = atoi(optarg);
+			break;
+		case 'S':
+			if (parse_size(optarg, &o.size) < 0) {
+				fprintf(stderr, "Bad --size %s\n", optarg);
+				return EXIT_FAILURE;
+			}
+			size_given = 1;
+			break;
+		case 'f':
+			if (strcmp(optarg, "syslog") == 0)
+				o.format = GEN_FMT_SYSLOG;
+			else if (strcmp(optarg, "kmsg") == 0)
+				o.format = GEN_FMT_KMSG;
+			else if (strcmp(optarg, "dmesg") == 0)
+				o.format = GEN_FMT_DMESG;
+			else {
+				fprintf(stderr, "Unknown log format %s\n", optarg);
+				return EXIT_FAILURE;
+			}
+			break;
+		case 'c':
+			o.calls = atoi(optarg);
+			break;
+		case 'r':
+			o.extra_records = atoi(optarg);
+			break;
+		case 'K':
+			o.kernel_records = 1;
+			break;
+		case 'P':
+			o.printk_offset_us = strtoull(optarg, NULL, 0) * 1000;
+			break;
+		case 'L':
+			o.layout = bootstage_layout_find(optarg);
+			if (!o.layout) {
+				fprintf(stderr, "Unknown layout %s, known layouts:\n", optarg);
+				bootstage_layout_list(stderr);
+				return EXIT_FAILURE;
+			}
+			break;
+		case 'M':
+			if (o.nremote == BOOT_REMOTE_CORES_MAX ||
+					boot_time_parse_remote_core(optarg, &o.remote[o.nremote]) < 0) {
+				fprintf(stderr, "Bad or too many --remote-core options\n");
+				return EXIT_FAILURE;
+			}
+			o.nremote++;
+			break;
+		case 'h':
+			usage(argv[0]);
+			return EXIT_SUCCESS;
+		default:
+			usage(argv[0]);
+			return EXIT_FAILURE;
+		}
+	}
+	if (optind != argc - 1 || !out || o.boots == 0) {
+		usage(argv[0]);
+		return EXIT_FAILURE;
+	}
+	mode = argv[optind];
+	if (o.nremote == 0) {
+		snprintf(o.remote[0].label, sizeof(o.remote[0].label), "MCU");
+		o.remote[0].offset = MCU_BOOTSTAGE_START_OFFSET;
+		o.remote[0].anchor_id = BOOTSTAGE_START_MCU;
+		o.nremote = 1;
+	}
+
+	if (strcmp(mode, "region") == 0) {
+		gen_boot_t b;
+
+		gen_boot(&o, o.boots - 1, &b);
+		ret = write_region(out, &o, &b);
+	} else if (strcmp(mode, "milestones") == 0) {
+		gen_boot_t b;
+
+		gen_boot(&o, o.boots - 1, &b);
+		ret = write_milestones(out, &o, o.boots - 1, &b);
+	} else if (strcmp(mode, "log") == 0) {
+		if (!size_given)
+			o.size = 1 << 20;
+		ret = write_log(out, &o, 0);
+	} else if (strcmp(mode, "fleet") == 0) {
+		if (!size_given)
+			o.size = GEN_FLEET_LOG_SIZE;
+		ret = write_fleet(out, &o);
+	} else {
+		usage(argv[0]);
+		return EXIT_FAILURE;
+	}
+	return (ret < 0) ? EXIT_FAILURE : EXIT_SUCCESS;
+}
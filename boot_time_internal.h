@@ -0,0 +1,106 @@
+/*
+ *  Copyright (C) 2025 Texas Instruments Incorporated
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions
+ *  are met:
+ *
+ *    Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *
+ *    Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the
+ *    distribution.
+ *
+ *    Neither the name of Texas Instruments Incorporated nor the names of
+ *    its contributors may be used to endorse or promote products derived
+ *    from this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ *  "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ *  LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ *  A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ *  OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ *  SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ *  LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ *  DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ *  THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ *  (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ *  OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/**
+ * \file boot_time_internal.h
+ * \brief Private definition of the libboottime parser context.
+ */
+
+#ifndef BOOT_TIME_INTERNAL_H
+#define BOOT_TIME_INTERNAL_H
+
+/* ========================================================================== */
+/*                           Include Files                                    */
+/* ========================================================================== */
+#include <limits.h>
+
+#include "boot_time_report.h"
+#include "record_store.h"
+#include "log_marker.h"
+#include "bootstage_layout.h"
+
+/* ========================================================================== */
+/*                           Data Structures                                  */
+/* ========================================================================== */
+
+/* Remote stage and A53 stage recorded at the same instant */
+typedef struct {
+	uint32_t core; /* strtab_t index of the core label */
+	uint32_t stage;
+	uint32_t ref;
+} boot_clock_sync_t;
+
+struct boot_time_ctx {
+	arena_t arena; /* Backs the name table and record columns */
+	strtab_t names;
+	record_table_t boot_records;
+	record_table_t remote_records[BOOT_REMOTE_CORES_MAX];
+	boot_remote_core_t remote_cores[BOOT_REMOTE_CORES_MAX];
+	int remote_count;
+	uint64_t *remote_ticks[BOOT_REMOTE_CORES_MAX]; /* Raw profile counter values */
+	uint32_t remote_ticks_cap[BOOT_REMOTE_CORES_MAX];
+	boot_clock_domain_t remote_clock[BOOT_REMOTE_CORES_MAX];
+	boot_clock_fit_t remote_fit[BOOT_REMOTE_CORES_MAX];
+	boot_clock_domain_t kernel_clock;
+	boot_clock_sync_t clock_sync[BOOT_CLOCK_SYNC_MAX];
+	int clock_sync_count;
+	boot_summary_t boot_summary;
+	uint64_t prev_time;
+	int kernel_record_count;
+	boot_kernel_call_t *kernel_calls; /* Longest first */
+	int kernel_call_count;
+	uint64_t kernel_call_lines; /* Initcall and probe lines in the log */
+	int64_t printk_offset_us; /* Tracker time minus printk time */
+	boot_time_io_stats_t io; /* records is filled in by boot_time_io_stats() */
+	bootstage_rec_t *region_kernel; /* Kernel records found in the region */
+	uint32_t region_kernel_count;
+
+	/* Options */
+	int scan_threads;
+	int boot_select;
+	int no_log_index;
+	int kernel_call_top; /* 0: initcall and probe lines are not parsed */
+	log_marker_set_t *markers; /* NULL: tracker lines only */
+	const bootstage_layout_t *bootstage_layout; /* NULL: detected per region */
+	size_t kernel_region; /* Kernel record area, BOOT_KERNEL_REGION_AFTER/NONE */
+	boot_time_unit_t unit; /* Display unit of reports */
+	char log_index_path[PATH_MAX]; /* Empty: <log>.btidx */
+};
+
+/* ========================================================================== */
+/*                          Function Declarations                             */
+/* ========================================================================== */
+
+int boot_time_add_remote_profile(boot_time_ctx_t *ctx, int core, const char *name,
+		size_t len, uint64_t ticks);
+
+#endif /* BOOT_TIME_INTERNAL_H */
@@ -0,0 +1,709 @@
+/*
+ *  Copyright (C) 2025 Texas Instruments Incorporated
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions
+ *  are met:
+ *
+ *    Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *
+ *    Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the
+ *    distribution.
+ *
+ *    Neither the name of Texas Instruments Incorporated nor the names of
+ *    its contributors may be used to endorse or promote products derived
+ *    from this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ *  "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ *  LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ *  A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ *  OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ *  SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ *  LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ *  DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ *  THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ *  (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ *  OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/**
+ * \file boot_time_output.c
+ * \brief Text and HTML boot time reports generated from a parser context.
+ */
+
+/* ========================================================================== */
+/*                           Include Files                                    */
+/* ========================================================================== */
+
+#include <stdarg.h>
+
+#include "boot_time_internal.h"
+#include "boot_span.h"
+#include "boot_timeline.h"
+
+/* ========================================================================== */
+/*                           Macros & Typedefs                                */
+/* ========================================================================== */
+
+
+/*
+ * Growable output buffer. The whole report is assembled in memory and
+ * written with a single fwrite().
+ */
+typedef struct {
+	char *p;
+	size_t len;
+	size_t cap;
+	int err;
+} outbuf_t;
+
+/* ========================================================================== */
+/*                          Global Variables                                  */
+/* ========================================================================== */
+
+static const char *const unit_names[] = {
+	[BOOT_UNIT_NS] = "ns",
+	[BOOT_UNIT_US] = "us",
+	[BOOT_UNIT_MS] = "ms",
+};
+
+static const uint64_t unit_ns[] = {
+	[BOOT_UNIT_NS] = 1,
+	[BOOT_UNIT_US] = 1000,
+	[BOOT_UNIT_MS] = 1000000,
+};
+
+
+/* ========================================================================== */
+/*                          Function Definitions                              */
+/* ========================================================================== */
+
+/**
+ * @brief Parses a display unit name: "ns", "us" or "ms".
+ * 
+ * @return int 0 on success, -1 for an unknown unit.
+ */
+int boot_time_parse_unit(const char *s, boot_time_unit_t *unit)
+{
+	for (int u = 0; u < (int)(sizeof(unit_names) / sizeof(unit_names[0])); u++) {
+		if (strcmp(s, unit_names[u]) == 0) {
+			*unit = u;
+			return 0;
+		}
+	}
+	return -1;
+}
+
+/**
+ * @brief Parses a duration such as "12", "1.5ms", "300us" or "2s".
+ * 
+ * A number without a unit is taken as milliseconds.
+ * 
+ * @param s Duration text.
+ * @param ns Receives the duration in nanoseconds.
+ * @return int 0 on success, -1 if s is not a duration.
+ */
+int boot_time_parse_duration(const char *s, uint64_t *ns)
+{
+	boot_time_unit_t unit = BOOT_UNIT_MS;
+	double scale, v;
+	char *end;
+
+	v = strtod(s, &end);
+	if (end == s || v < 0)
+		return -1;
+	if (strcmp(end, "s") == 0)
+		scale = 1e9;
+	else if (*end && boot_time_parse_unit(end, &unit) < 0)
+		return -1;
+	else
+		scale = unit_ns[unit];
+	*ns = (uint64_t)(v * scale + 0.5);
+	return 0;
+}
+
+/**
+ * @brief Returns the short name of a display unit, e.g. "ms".
+ */
+const char *boot_time_unit_name(boot_time_unit_t unit)
+{
+	return unit_names[unit];
+}
+
+/**
+ * @brief Returns the length of a display unit in nanoseconds.
+ */
+uint64_t boot_time_unit_ns(boot_time_unit_t unit)
+{
+	return unit_ns[unit];
+}
+
+/**
+ * @brief Converts a record time to a display unit, rounding to nearest.
+ */
+uint64_t boot_time_to_unit(uint64_t ns, boot_time_unit_t unit)
+{
+	return (ns + unit_ns[unit] / 2) / unit_ns[unit];
+}
+
+static int ob_reserve(outbuf_t *ob, size_t n)
+{
+	size_t cap;
+	char *p;
+
+	if (ob->len + n <= ob->cap)
+		return 0;
+	if (ob->err)
+		return -1;
+	for (cap = ob->cap ? ob->cap : 16384; cap < ob->len + n; cap *= 2)
+		;
+	p = realloc(ob->p, cap);
+	if (!p) {
+		ob->err = -1;
+		return -1;
+	}
+	ob->p = p;
+	ob->cap = cap;
+	return 0;
+}
+
+static void ob_write(outbuf_t *ob, const char *s, size_t n)
+{
+	if (ob_reserve(ob, n) < 0)
+		return;
+	memcpy(ob->p + ob->len, s, n);
+	ob->len += n;
+}
+
+static void ob_puts(outbuf_t *ob, const char *s)
+{
+	ob_write(ob, s, strlen(s));
+}
+
+static void ob_printf(outbuf_t *ob, const char *fmt, ...)
+{
+	va_list ap;
+	int n;
+
+	va_start(ap, fmt);
+	n = vsnprintf(NULL, 0, fmt, ap);
+	va_end(ap);
+	if (n < 0 || ob_reserve(ob, n + 1) < 0)
+		return;
+	va_start(ap, fmt);
+	vsnprintf(ob->p + ob->len, n + 1, fmt, ap);
+	va_end(ap);
+	ob->len += n;
+}
+
+/* Decimal formatting without going through printf for the bulk arrays */
+static void ob_u64(outbuf_t *ob, uint64_t v)
+{
+	char tmp[20];
+	int n = 0;
+
+	do {
+		tmp[n++] = '0' + v % 10;
+		v /= 10;
+	} while (v);
+	if (ob_reserve(ob, n) < 0)
+		return;
+	while (n)
+		ob->p[ob->len++] = tmp[--n];
+}
+
+/* Nanoseconds as fractional microseconds, the Chrome trace time unit */
+static void ob_us(outbuf_t *ob, uint64_t ns)
+{
+	ob_u64(ob, ns / 1000);
+	if (ns % 1000)
+		ob_printf(ob, ".%03u", (unsigned)(ns % 1000));
+}
+
+/* HTML text; used for names placed directly in the markup */
+static void ob_html(outbuf_t *ob, const char *s)
+{
+	for (; *s; s++) {
+		switch (*s) {
+		case '<': ob_puts(ob, "&lt;"); break;
+		case '>': ob_puts(ob, "&gt;"); break;
+		case '&': ob_puts(ob, "&amp;"); break;
+		case '\'': ob_puts(ob, "&#39;"); break;
+		case '"': ob_puts(ob, "&quot;"); break;
+		default: ob_write(ob, s, 1); break;
+		}
+	}
+}
+
+/*
+ * JSON string safe to embed in a <script> element: '<' is escaped so a
+ * name can never close the element.
+ */
+static void ob_json_str(outbuf_t *ob, const char *s)
+{
+	ob_write(ob, "\"", 1);
+	for (; *s; s++) {
+		unsigned char c = *s;
+
+		if (c == '"' || c == '\\') {
+			char e[2] = { '\\', c };
+			ob_write(ob, e, 2);
+		} else if (c < 0x20 || c == '<' || c == '>' || c == '&') {
+			ob_printf(ob, "\\u%04x", c);
+		} else {
+			ob_write(ob, s, 1);
+		}
+	}
+	ob_write(ob, "\"", 1);
+}
+
+static void ob_u64_array(outbuf_t *ob, const uint64_t *v, uint32_t n)
+{
+	ob_write(ob, "[", 1);
+	for (uint32_t i = 0; i < n; i++) {
+		if (i)
+			ob_write(ob, ",", 1);
+		ob_u64(ob, v[i]);
+	}
+	ob_write(ob, "]", 1);
+}
+
+static void ob_u32_array(outbuf_t *ob, const uint32_t *v, uint32_t n)
+{
+	ob_write(ob, "[", 1);
+	for (uint32_t i = 0; i < n; i++) {
+		if (i)
+			ob_write(ob, ",", 1);
+		ob_u64(ob, v[i]);
+	}
+	ob_write(ob, "]", 1);
+}
+
+/* Writes the buffer to filename in one go and releases it */
+static int write_outbuf(outbuf_t *ob, const char *filename)
+{
+	FILE *fp;
+	int ret = 0;
+
+	if (ob->err) {
+		free(ob->p);
+		return -1;
+	}
+	fp = fopen(filename, "w");
+	if (!fp) {
+		free(ob->p);
+		return -1;
+	}
+	if (fwrite(ob->p, 1, ob->len, fp) != ob->len)
+		ret = -1;
+	if (fclose(fp) != 0)
+		ret = -1;
+	free(ob->p);
+	return ret;
+}
+
+static void html_lane(outbuf_t *ob, const char *name, const record_table_t *tab)
+{
+	ob_puts(ob, "{\"name\":");
+	ob_json_str(ob, name);
+	ob_puts(ob, ",\"s\":");
+	ob_u64_array(ob, tab->start_time, tab->count);
+	ob_puts(ob, ",\"d\":");
+	ob_u64_array(ob, tab->delta_time, tab->count);
+	ob_puts(ob, ",\"n\":");
+	ob_u32_array(ob, tab->name, tab->count);
+	ob_puts(ob, "}");
+}
+
+/*
+ * Stacked SVG bar of the summary split, rendered here so the report needs
+ * no charting library.
+ */
+static void html_summary_svg(outbuf_t *ob, const uint64_t *part, const char *const *label,
+		int nparts, uint64_t total, boot_time_unit_t unit)
+{
+	static const char *const colors[] = { "#4e79a7", "#f28e2b", "#e15759", "#76b7b2" };
+	double x = 0;
+
+	ob_puts(ob, "<svg class='split' viewBox='0 0 1000 46'>");
+	for (int i = 0; i < nparts && total; i++) {
+		double w = 1000.0 * part[i] / total;
+
+		ob_printf(ob, "<rect x='%.2f' y='0' width='%.2f' height='28' fill='%s'>"
+				"<title>%s: %" PRIu64 " %s</title></rect>",
+				x, w, colors[i % 4], label[i], boot_time_to_unit(part[i], unit),
+				boot_time_unit_name(unit));
+		if (w > 60)
+			ob_printf(ob, "<text x='%.2f' y='42'>%s</text>", x + 2, label[i]);
+		x += w;
+	}
+	ob_puts(ob, "</svg>");
+}
+
+/**
+ * @brief Exports the boot records to an HTML file.
+ * 
+ * The report is self-contained: records are embedded once as compact
+ * JSON, the summary chart is inline SVG and the stage view renders only
+ * the rows in sight, so it opens offline and stays fast with many
+ * thousands of records. Every core has its own lane, and the all lanes
+ * view lists the records in merged time order.
+ * 
+ * @param ctx Parser context holding the records.
+ * @param filename The name of the HTML file to export the report to.
+ * @param hostname Board name shown in the report title.
+ * @return int 0 on success, -1 if the file cannot be written.
+ */
+int boot_time_export_html(const boot_time_ctx_t *ctx, const char *filename,
+		const char *hostname)
+{
+	static const char *const split_label[] = {
+		"SPL", "U-Boot", "Kernel handoff", "Kernel"
+	};
+	const boot_summary_t *bs = &ctx->boot_summary;
+	const char *un = boot_time_unit_name(ctx->unit);
+	boot_timeline_t tl;
+	outbuf_t ob = { 0 };
+	uint64_t split[4];
+
+	if (boot_time_timeline(ctx, &tl) < 0)
+		return -1;
+
+	/* ---- summary numbers ---- */
+	split[0] = bs->ustart_time;
+	split[1] = (bs->uend_time >= bs->ustart_time) ? bs->uend_time - bs->ustart_time : 0;
+	split[2] = (bs->kstart_time >= bs->uend_time) ? bs->kstart_time - bs->uend_time : 0;
+	split[3] = (bs->kend_time >= bs->kstart_time) ? bs->kend_time - bs->kstart_time : 0;
+
+	ob_puts(&ob,
+		"<!doctype html><html><head>"
+		"<meta charset='utf-8'>"
+		"<meta name='viewport' content='width=device-width,initial-scale=1'>"
+		"<title>");
+	ob_html(&ob, hostname);
+	ob_puts(&ob, " Boot Time Report</title>"
+		"<style>"
+		"body{font:14px system-ui,Segoe UI,Arial;margin:16px;}"
+		"h1{font-size:18px;margin:0 0 10px 0}"
+		"table{border-collapse:collapse;font-size:12px}"
+		"th,td{border:1px solid #e3e8ee;padding:6px 8px;text-align:left}"
+		"th{background:#f7f9fc}"
+		".summary{max-width:560px;width:100%;margin:8px 0 16px 0}"
+		".split{width:100%;max-width:960px;font:12px sans-serif}"
+		".row{display:flex;gap:12px;align-items:center;flex-wrap:wrap;margin:12px 0}"
+		"#vp{height:70vh;overflow-y:auto;position:relative;border:1px solid #e3e8ee;font-size:12px}"
+		"#sp{position:relative}"
+		".r,.hd{display:grid;grid-template-columns:56px 90px 260px 90px 90px 1fr;"
+		"align-items:center;height:22px;position:absolute;left:0;right:0}"
+		".hd{position:sticky;top:0;background:#f7f9fc;z-index:1;font-weight:600}"
+		".r>span,.hd>span{padding:0 6px;overflow:hidden;white-space:nowrap;text-overflow:ellipsis}"
+		".r:nth-child(even){background:#fafbfd}"
+		".t{position:relative;height:14px}"
+		".b{position:absolute;height:14px;min-width:1px}"
+		".l0{background:#4e79a7}.l1{background:#f28e2b}.l2{background:#59a14f}.l3{background:#b07aa1}"
+		"</style></head><body><h1>");
+	ob_html(&ob, hostname);
+	ob_puts(&ob, " Boot Time Report</h1>");
+
+	/* ---- summary table and split chart ---- */
+	ob_printf(&ob,
+		"<table class='summary'>"
+		"<thead><tr><th colspan='2'>Boot Time Report Summary</th></tr></thead>"
+		"<tbody>"
+		"<tr><td>Device Power On</td><td>0 %s</td></tr>"
+		"<tr><td>SPL Time</td><td>%" PRIu64 " %s</td></tr>"
+		"<tr><td>U-BOOT Time</td><td>%" PRIu64 " %s</td></tr>"
+		"<tr><td>Kernel handoff time</td><td>%" PRIu64 " %s</td></tr>"
+		"<tr><td>Kernel Time</td><td>%" PRIu64 " %s</td></tr>"
+		"<tr><td><b>Total Boot Time</b></td><td><b>%" PRIu64 " %s</b></td></tr>"
+		"</tbody></table>", un,
+		boot_time_to_unit(split[0], ctx->unit), un,
+		boot_time_to_unit(split[1], ctx->unit), un,
+		boot_time_to_unit(split[2], ctx->unit), un,
+		boot_time_to_unit(split[3], ctx->unit), un,
+		boot_time_to_unit(bs->kend_time, ctx->unit), un);
+	html_summary_svg(&ob, split, split_label, 4,
+			split[0] + split[1] + split[2] + split[3], ctx->unit);
+
+	/* ---- stage view controls and viewport ---- */
+	ob_puts(&ob,
+		"<div class='row'>"
+		" <label><input type='radio' name='mode' value='abs' checked> Absolute</label>"
+		" <label><input type='radio' name='mode' value='dur'> Duration</label>"
+		" <select id='lane'><option value='-1'>All lanes</option></select>"
+		" <select id='unit'><option>ns</option><option>us</option><option>ms</option></select>"
+		" <span id='cnt'></span>"
+		"</div>"
+		"<div id='vp'><div class='hd'><span>#</span><span>Lane</span><span>Stage</span>"
+		"<span id='ha'></span><span id='hd'></span><span></span></div>"
+		"<div id='sp'></div></div>");
+
+	/* ---- records in nanoseconds, embedded once as JSON ---- */
+	ob_puts(&ob, "<script id='data' type='application/json'>{\"unit\":");
+	ob_json_str(&ob, un);
+	ob_puts(&ob, ",\"names\":[");
+	for (uint32_t i = 0; i < ctx->names.count; i++) {
+		if (i)
+			ob_write(&ob, ",", 1);
+		ob_json_str(&ob, strtab_str(&ctx->names, i));
+	}
+	ob_puts(&ob, "],\"lanes\":[");
+	html_lane(&ob, "A53", &ctx->boot_records);
+	for (int c = 0; c < ctx->remote_count; c++) {
+		ob_puts(&ob, ",");
+		html_lane(&ob, ctx->remote_cores[c].label, &ctx->remote_records[c]);
+	}
+	/* All lanes view: (lane, record) pairs in merged time order */
+	ob_puts(&ob, "],\"tl\":[");
+	for (size_t i = 0; i < tl.count; i++) {
+		if (i)
+			ob_write(&ob, ",", 1);
+		ob_u64(&ob, tl.entries[i].lane);
+		ob_write(&ob, ",", 1);
+		ob_u64(&ob, tl.entries[i].index);
+	}
+	boot_timeline_free(&tl);
+	ob_puts(&ob, "]}</script>\n");
+
+	/* ---- virtualised stage view: only rows in the viewport exist ---- */
+	ob_puts(&ob,
+		"<script>\n"
+		"const D=JSON.parse(document.getElementById('data').textContent);\n"
+		"const esc=s=>s.replace(/[&<>\"']/g,c=>'&#'+c.charCodeAt(0)+';');\n"
+		"const N=D.names, H=22;\n"
+		"const vp=document.getElementById('vp'), sp=document.getElementById('sp');\n"
+		"const sel=document.getElementById('lane'), cnt=document.getElementById('cnt');\n"
+		"const us=document.getElementById('unit'), U={ns:1,us:1e3,ms:1e6};\n"
+		"let mode='abs', rows=[], maxT=1, u=D.unit;\n"
+		"const fmt=v=>Math.round(v/U[u]);\n"
+		"function units(){u=us.value;document.getElementById('ha').textContent='Absolute ('+u+')';"
+		"document.getElementById('hd').textContent='Delta ('+u+')';draw();}\n"
+		"D.lanes.forEach((l,i)=>{const o=document.createElement('option');"
+		"o.value=i;o.textContent=l.name;sel.appendChild(o);"
+		"for(let k=0;k<l.s.length;k++)maxT=Math.max(maxT,l.s[k]+(l.d[k]<=l.s[k]?l.d[k]:0));});\n"
+		"function build(){const f=+sel.value;rows=[];"
+		"if(f<0)rows=D.tl.slice();else{const l=D.lanes[f];"
+		"for(let k=0;k<l.s.length;k++)rows.push(f,k);}"
+		"sp.style.height=(rows.length/2*H)+'px';cnt.textContent=(rows.length/2)+' records';draw();}\n"
+		"function draw(){const top=Math.max(0,vp.scrollTop-H);"
+		"const a=Math.floor(top/H), b=Math.min(rows.length/2,a+Math.ceil(vp.clientHeight/H)+2);"
+		"let h='';for(let j=a;j<b;j++){const li=rows[2*j],k=rows[2*j+1],l=D.lanes[li];"
+		"const s=l.s[k],d=l.d[k],x0=mode==='abs'?0:s,x1=mode==='abs'?s:s+d,n=esc(N[l.n[k]]);"
+		"h+='<div class=\"r\" style=\"top:'+(j*H)+'px\"><span>'+(j+1)+'</span><span>'+esc(l.name)+"
+		"'</span><span title=\"'+n+'\">'+n+'</span><span>'+fmt(s)+'</span><span>+'+fmt(d)+"
+		"'</span><span class=\"t\"><span class=\"b l'+(li%4)+'\" style=\"left:'+(100*x0/maxT)+"
+		"'%;width:'+(100*(x1-x0)/maxT)+'%\" title=\"'+fmt(x1-x0)+' '+u+'\"></span></span></div>';}"
+		"sp.innerHTML=h;}\n"
+		"vp.addEventListener('scroll',()=>requestAnimationFrame(draw));\n"
+		"window.addEventListener('resize',draw);\n"
+		"sel.addEventListener('change',build);\n"
+		"us.value=u;us.addEventListener('change',units);\n"
+		"document.querySelectorAll('input[name=\"mode\"]').forEach(r=>"
+		"r.addEventListener('change',e=>{mode=e.target.value;draw();}));\n"
+		"build();units();\n"
+		"</script></body></html>\n");
+
+	return write_outbuf(&ob, filename);
+}
+
+/**
+ * @brief Exports the boot as a Chrome Trace Event JSON file.
+ * 
+ * Every core gets its own track (thread). Phases, begin/end pairs and
+ * accumulated stages become complete events nested by time, and the
+ * individual bootstage marks become instant events. The file loads in
+ * chrome://tracing and in the Perfetto UI.
+ * 
+ * @param ctx Parser context holding the records.
+ * @param filename Trace file to write.
+ * @param hostname Board name used as the process name.
+ * @return int 0 on success, -1 on failure.
+ */
+int boot_time_export_trace(const boot_time_ctx_t *ctx, const char *filename,
+		const char *hostname)
+{
+	static const char *const cat[] = {
+		[BOOT_SPAN_INSTANT] = "mark",
+		[BOOT_SPAN_PAIR] = "pair",
+		[BOOT_SPAN_ACCUM] = "accum",
+		[BOOT_SPAN_PHASE] = "phase",
+		[BOOT_SPAN_CALL] = "initcall",
+	};
+	boot_span_list_t spans;
+	outbuf_t ob = { 0 };
+
+	if (boot_time_spans(ctx, &spans) < 0)
+		return -1;
+
+	/* The trace format knows only ms and ns as display units */
+	ob_printf(&ob, "{\"displayTimeUnit\":\"%s\",\"otherData\":{\"host\":",
+			ctx->unit == BOOT_UNIT_NS ? "ns" : "ms");
+	ob_json_str(&ob, hostname);
+	ob_puts(&ob, "},\"traceEvents\":[\n"
+		"{\"ph\":\"M\",\"pid\":1,\"name\":\"process_name\",\"args\":{\"name\":");
+	ob_json_str(&ob, hostname);
+	ob_puts(&ob, "}}");
+	for (int t = 0; t < BOOT_TRACK_REMOTE + ctx->remote_count; t++) {
+		ob_printf(&ob, ",\n{\"ph\":\"M\",\"pid\":1,\"tid\":%d,\"name\":\"thread_name\","
+				"\"args\":{\"name\":", t + 1);
+		ob_json_str(&ob, boot_track_name(ctx, t));
+		ob_printf(&ob, "}},\n{\"ph\":\"M\",\"pid\":1,\"tid\":%d,"
+				"\"name\":\"thread_sort_index\",\"args\":{\"sort_index\":%d}}",
+				t + 1, t);
+	}
+
+	for (size_t i = 0; i < spans.count; i++) {
+		const boot_span_t *sp = &spans.spans[i];
+
+		ob_puts(&ob, ",\n{\"name\":");
+		ob_json_str(&ob, sp->name);
+		ob_printf(&ob, ",\"cat\":\"%s\",\"pid\":1,\"tid\":%d,\"ts\":", cat[sp->kind],
+				sp->track + 1);
+		ob_us(&ob, sp->start);
+		if (sp->kind == BOOT_SPAN_INSTANT) {
+			ob_puts(&ob, ",\"ph\":\"i\",\"s\":\"t\"}");
+		} else {
+			ob_puts(&ob, ",\"ph\":\"X\",\"dur\":");
+			ob_us(&ob, sp->dur);
+			ob_puts(&ob, "}");
+		}
+	}
+	ob_puts(&ob, "\n]}\n");
+	boot_span_list_free(&spans);
+	return write_outbuf(&ob, filename);
+}
+
+static void print_records(FILE *fp, const boot_time_ctx_t *ctx, const record_table_t *tab,
+		int count)
+{
+	const char *un = boot_time_unit_name(ctx->unit);
+
+	for (int i = 0; i < count; i++)
+		fprintf(fp, "%-30s = %6" PRIu64 " %s (+%3" PRIu64 " %s)\n",
+				strtab_str(&ctx->names, tab->name[i]),
+				boot_time_to_unit(tab->start_time[i], ctx->unit), un,
+				boot_time_to_unit(tab->delta_time[i], ctx->unit), un);
+}
+
+/**
+ * @brief Prints the collected boot records.
+ * 
+ * This function outputs the gathered boot records to the console or another
+ * output stream for verification or analysis. Times are shown in the
+ * display unit set with boot_time_set_unit().
+ * 
+ * @param ctx Parser context holding the records.
+ * @param fp Output stream.
+ * @param hostname Board name shown in the report title.
+ */
+void boot_time_print_report(const boot_time_ctx_t *ctx, FILE *fp, const char *hostname)
+{
+	const boot_summary_t *bs = &ctx->boot_summary;
+	const char *un = boot_time_unit_name(ctx->unit);
+
+	fprintf(fp, "--------------------------------------------------------------------\n");
+	fprintf(fp, "                 %s Boot Time Report \n", hostname);
+	fprintf(fp, "--------------------------------------------------------------------\n");
+
+	fprintf(fp, "Device Power On         : %u %s\n", 0, un);
+	fprintf(fp, "SPL Time		: %" PRIu64 " %s\n",
+			boot_time_to_unit(bs->ustart_time, ctx->unit), un);
+	fprintf(fp, "U-Boot Time		: %" PRIu64 " %s\n",
+			boot_time_to_unit(bs->uend_time - bs->ustart_time, ctx->unit), un);
+	fprintf(fp, "Kernel handoff time	: %" PRIu64 " %s\n",
+			boot_time_to_unit(bs->kstart_time - bs->uend_time, ctx->unit), un);
+	fprintf(fp, "Kernel Time		: %" PRIu64 " %s\n",
+			boot_time_to_unit(bs->kend_time - bs->kstart_time, ctx->unit), un);
+	fprintf(fp, "Total Boot Time		: %" PRIu64 " %s\n",
+			boot_time_to_unit(bs->kend_time, ctx->unit), un);
+	fprintf(fp, "--------------------------------------------------------------------\n\n");
+	fprintf(fp, "--------------------------------------------------------------------\n");
+	fprintf(fp, "                 Bootloader and Kernel Boot Records\n");
+	fprintf(fp, "--------------------------------------------------------------------\n");
+	print_records(fp, ctx, &ctx->boot_records, bs->count);
+	for (int c = 0; c < ctx->remote_count; c++) {
+		fprintf(fp, "--------------------------------------------------------------------\n\n");
+		fprintf(fp, "--------------------------------------------------------------------\n");
+		fprintf(fp, "                 %s Boot Records \n", ctx->remote_cores[c].label);
+		fprintf(fp, "--------------------------------------------------------------------\n");
+		print_records(fp, ctx, &ctx->remote_records[c], ctx->remote_records[c].count);
+	}
+	fprintf(fp, "--------------------------------------------------------------------\n");
+}
+
+/**
+ * @brief Prints the clock domain of every source and how well each remote
+ * clock fits its sync points.
+ * 
+ * @param ctx Parser context.
+ * @param fp Output stream.
+ */
+void boot_time_print_clocks(const boot_time_ctx_t *ctx, FILE *fp)
+{
+	fprintf(fp, "--------------------------------------------------------------------\n");
+	fprintf(fp, "                 Clock Domains\n");
+	fprintf(fp, "--------------------------------------------------------------------\n");
+	fprintf(fp, "%-8s %12s %5s %12s %12s %12s\n", "Domain", "Counter Hz", "Sync",
+			"Epoch ms", "Drift ppm", "Error ms");
+	fprintf(fp, "%-8s %12u %5s %12.3f %12s %12s\n", "U-Boot", BOOT_CLOCK_DEFAULT_HZ,
+			"ref", 0.0, "-", "-");
+	fprintf(fp, "%-8s %12" PRIu64 " %5s %12.3f %12s %12s\n", "Kernel",
+			ctx->kernel_clock.freq_hz, "-", ctx->kernel_clock.epoch_ns / 1e6, "-", "-");
+	for (int c = 0; c < ctx->remote_count; c++) {
+		const boot_clock_domain_t *d = &ctx->remote_clock[c];
+		const boot_clock_fit_t *f = &ctx->remote_fit[c];
+
+		if (!ctx->remote_ticks[c])
+			continue;
+		if (f->points)
+			fprintf(fp, "%-8s %12" PRIu64 " %5d %12.3f %+12.2f %12.3f\n",
+					ctx->remote_cores[c].label, d->freq_hz, f->points,
+					d->epoch_ns / 1e6, d->drift_ppm, f->err_ns / 1e6);
+		else
+			fprintf(fp, "%-8s %12" PRIu64 " %5s %12.3f %12s %12s\n",
+					ctx->remote_cores[c].label, d->freq_hz, "-",
+					d->epoch_ns / 1e6, "-", "-");
+	}
+	fprintf(fp, "--------------------------------------------------------------------\n");
+}
+
+/**
+ * @brief Prints the longest initcalls and probes of an initcall_debug
+ * kernel, longest first.
+ * 
+ * @param ctx Parser context.
+ * @param fp Output stream.
+ */
+void boot_time_print_kernel_calls(const boot_time_ctx_t *ctx, FILE *fp)
+{
+	const char *un = boot_time_unit_name(ctx->unit);
+	uint64_t seen;
+	int count;
+	const boot_kernel_call_t *k = boot_time_kernel_calls(ctx, &count, &seen);
+
+	fprintf(fp, "--------------------------------------------------------------------\n");
+	fprintf(fp, "                 Slowest Initcalls and Probes\n");
+	fprintf(fp, "--------------------------------------------------------------------\n");
+	if (!count) {
+		fprintf(fp, "No initcall_debug lines in the kernel log\n");
+		fprintf(fp, "--------------------------------------------------------------------\n");
+		return;
+	}
+	fprintf(fp, "%-8s %-30s %9s %9s %5s\n", "Kind", "Name", "Start", "Duration", "Ret");
+	for (int i = 0; i < count; i++) {
+		fprintf(fp, "%-8s %-30s ", k[i].probe ? "probe" : "initcall",
+				strtab_str(&ctx->names, k[i].name));
+		if (k[i].start_time)
+			fprintf(fp, "%6" PRIu64 " %s ", boot_time_to_unit(k[i].start_time, ctx->unit), un);
+		else
+			fprintf(fp, "%9s ", "-");
+		fprintf(fp, "%6" PRIu64 " %s %5d%s\n", boot_time_to_unit(k[i].duration, ctx->unit),
+				un, k[i].ret, k[i].ret == -517 ? " (deferred)" : "");
+	}
+	fprintf(fp, "%d of %" PRIu64 " initcalls and probes\n", count, seen);
+	fprintf(fp, "--------------------------------------------------------------------\n");
+}
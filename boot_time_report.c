@@ -33,14 +33,29 @@
 /**
  * \file boot_time_report.c
  * \brief Boot time record parser application for reading, parsing and
- * preparing final unified boot time report.
+ * preparing final unified boot time report. Thin command line client of
+ * libboottime.
  */
 
 /* ========================================================================== */
 /*                           Include Files                                    */
 /* ========================================================================== */
 
+#include <getopt.h>
+#include <time.h>
+#include <sys/stat.h>
+
 #include "boot_time_report.h"
+#include "kernel_log_scan.h"
+#include "kmsg_source.h"
+#include "fleet_batch.h"
+#include "boot_archive.h"
+#include "boot_critical_path.h"
+#include "boot_timeline.h"
+#include "boot_compare.h"
+#include "boot_milestone.h"
+#include "boot_watch.h"
+#include "boot_profile.h"
 
 
 /* ========================================================================== */
@@ -55,439 +70,844 @@ char hostname[128] = "";
 /* ========================================================================== */
 
 /**
- * @brief Retrieves the hostname of the current machine.
+ * @brief Measures tracker scan throughput on a synthetic log.
  * 
- * This function uses the `gethostname` system call to fetch the hostname
- * and store it in the provided buffer. If the operation fails, an error
- * message is printed to standard error.
+ * Builds a log of roughly size_mb MiB of ordinary kernel lines with a
+ * tracker line every 4096 lines, scans it repeatedly and reports GB/s.
  * 
- * @param hostname A buffer to store the hostname.
- * @param size The size of the hostname buffer.
- * @return int Returns 0 on success, or a non-zero value on failure.
+ * @param size_mb Size of the synthetic log in MiB.
+ * @param scan_threads Scanner thread count.
+ * @return int EXIT_SUCCESS on success, EXIT_FAILURE otherwise.
  */
-const char* get_bootstage_id_name(int id) {
-	// Check if the ID is out of bounds or if the name is NULL.
-	if (id < 0 || id >= sizeof(bootstage_id_names)/sizeof(bootstage_id_names[0])
-		|| bootstage_id_names[id] == NULL)
-		return "UNKNOWN_BOOTSTAGE_ID";
-	return bootstage_id_names[id];
+static int run_scan_bench(unsigned size_mb, int scan_threads)
+{
+	static const char filler[] =
+		"Oct 16 10:00:01 am62xx kernel: [    1.234567] usb 1-1: new high-speed USB device number 2 using xhci-hcd\n";
+	static const char tracker[] =
+		"Oct 16 10:00:01 am62xx kernel: [    1.234567] [BOOT TRACKER] ID:300 BOOTSTAGE_KERNEL_START = 3478000\n";
+	size_t len = (size_t)size_mb << 20, pos = 0, lines = 0;
+	char *buf = malloc(len);
+	double best = 0;
+	size_t found = 0;
+
+	if (!buf) {
+		perror("malloc");
+		return EXIT_FAILURE;
+	}
+	while (pos + sizeof(tracker) < len) {
+		const char *l = (++lines % 4096) ? filler : tracker;
+		size_t n = strlen(l);
+		memcpy(buf + pos, l, n);
+		pos += n;
+	}
+
+	for (int run = 0; run < 5; run++) {
+		kernel_log_scan_result_t res = { 0 };
+		struct timespec t0, t1;
+
+		clock_gettime(CLOCK_MONOTONIC, &t0);
+		kernel_log_scan_buffer(buf, pos, 0, scan_threads, &res);
+		clock_gettime(CLOCK_MONOTONIC, &t1);
+
+		double sec = (t1.tv_sec - t0.tv_sec) + (t1.tv_nsec - t0.tv_nsec) / 1e9;
+		double gbps = pos / sec / 1e9;
+		if (gbps > best)
+			best = gbps;
+		found = res.count;
+		kernel_log_scan_free(&res);
+	}
+
+	printf("scanned %zu bytes, %zu tracker lines, best %.2f GB/s\n", pos, found, best);
+	free(buf);
+	return EXIT_SUCCESS;
 }
 
 /**
- * @brief Exports the boot records to an HTML file.
- * 
- * This function generates an HTML report containing the boot records and
- * saves it to the specified file. The report includes the number of boot
- * records collected.
+ * @brief Parses a fleet of captured boots and prints per-stage statistics.
  * 
- * @param filename The name of the HTML file to export the report to.
- * @param record_count The number of boot records to include in the report.
+ * @param path Directory of dumps and logs, or a manifest.
+ * @param json_file JSON output file ("-" for stdout), or NULL.
+ * @param nthreads Worker thread count.
+ * @param remote Remote core table, or NULL for the default.
+ * @param nremote Number of remote cores, 0 for the default.
+ * @param unit Display unit of the statistics.
+ * @return int EXIT_SUCCESS on success, EXIT_FAILURE otherwise.
  */
-void export_html(const char *filename, int count)
+static int run_fleet(const char *path, const char *json_file, int nthreads,
+		const boot_remote_core_t *remote, int nremote, boot_time_unit_t unit)
 {
-	// Open the file for writing.
-	FILE *fp = fopen(filename, "w");
-	if (!fp) return;
-
-	int mcu_count = boot_summary.mcu_reccount;
-
-	/* ---- summary numbers ---- */
-	unsigned dev_power_on = 0;
-	unsigned spl_time     = boot_summary.ustart_time;
-	unsigned uboot_time   = (boot_summary.uend_time   >= boot_summary.ustart_time)
-		? (boot_summary.uend_time   - boot_summary.ustart_time) : 0;
-	unsigned handoff_time = (boot_summary.kstart_time >= boot_summary.uend_time)
-		? (boot_summary.kstart_time - boot_summary.uend_time)   : 0;
-	unsigned kernel_time  = (boot_summary.kend_time   >= boot_summary.kstart_time)
-		? (boot_summary.kend_time   - boot_summary.kstart_time) : 0;
-	unsigned total_time   = boot_summary.kend_time;
-
-	fprintf(fp,
-		"<!doctype html><html><head>"
-		"<meta charset='utf-8'>"
-		"<meta name='viewport' content='width=device-width,initial-scale=1'>"
-		"<title>%s Boot Time Report</title>"
-		"<style>"
-		"body{font:14px system-ui,Segoe UI,Arial;margin:16px;}"
-		"h1{font-size:18px;margin:0 0 10px 0}"
-		"h3{margin:18px 0 8px 0}"
-		"table{border-collapse:collapse;width:100%%;font-size:12px}"
-		"th,td{border:1px solid #e3e8ee;padding:6px 8px;text-align:left}"
-		"th{background:#f7f9fc}"
-		".row{display:flex;gap:12px;align-items:center;flex-wrap:wrap;margin:12px 0}"
-		".summary{max-width:560px;margin:8px 0 16px 0}"
-		".chartbox{height:720px;margin:6px 0 14px 0}"
-		"</style>"
-		"<script src='https://cdn.jsdelivr.net/npm/chart.js'></script>"
-		"</head><body>",
-		hostname
-	);
-
-	fprintf(fp, "<h1>%s Boot Time Report</h1>", hostname);
-
-	/* ---- summary table ---- */
-	fprintf(fp,
-		"<table class='summary'>"
-		"<thead><tr><th colspan='2'>Boot Time Report Summary</th></tr></thead>"
-		"<tbody>"
-		"<tr><td>Device Power On</td><td>%u ms</td></tr>"
-		"<tr><td>SPL Time</td><td>%u ms</td></tr>"
-		"<tr><td>U-BOOT Time</td><td>%u ms</td></tr>"
-		"<tr><td>Kernel handoff time</td><td>%u ms</td></tr>"
-		"<tr><td>Kernel Time</td><td>%u ms</td></tr>"
-		"<tr><td><b>Total Boot Time</b></td><td><b>%u ms</b></td></tr>"
-		"</tbody></table>",
-		dev_power_on, spl_time, uboot_time, handoff_time, kernel_time, total_time
-	);
-
-	/* ---- combined chart controls + canvas ---- */
-	fprintf(fp,
-		"<div class='row'>"
-		" <label><input type='radio' name='mode' value='abs' checked> Absolute</label>"
-		" <label><input type='radio' name='mode' value='dur'> Duration</label>"
-		"</div>"
-		"<div class='chartbox'><canvas id='chartCombined'></canvas></div>"
-	);
-
-	/* ---- JS arrays (Linux + MCU) ---- */
-	fprintf(fp, "<script>\n");
-
-	fprintf(fp, "const linuxN=%d, mcuN=%d;\n", count, mcu_count);
-
-	/* labels (prefix so they’re visually grouped) */
-	fprintf(fp, "const labels=[");
-	for (int i = 0; i < count; ++i) {
-		/* minimal escaping of single quotes for safety */
-		const char *s = boot_records[i].name; char esc[256]; size_t oi=0;
-		for (size_t k=0; s && s[k] && oi+2<sizeof(esc); ++k) {
-			if (s[k]=='\''){esc[oi++]='\\';
-				esc[oi++]='\'';
-			} else
-				esc[oi++]=s[k];
-		}
-		esc[(oi<sizeof(esc))?oi:sizeof(esc)-1]='\0';
-		fprintf(fp, "'A53: %s'%s", esc, (i < count-1 || mcu_count>0) ? "," : "");
-	}
-	for (int i = 0; i < mcu_count; ++i) {
-		const char *s = mcu_boot_records[i].name; char esc[256]; size_t oi=0;
-		for (size_t k=0; s && s[k] && oi+2<sizeof(esc); ++k) {
-			if (s[k]=='\''){esc[oi++]='\\';
-				esc[oi++]='\'';}
-			else
-				esc[oi++]=s[k];
+	fleet_input_t in = { 0 };
+	fleet_result_t res;
+	int ret = EXIT_SUCCESS;
+
+	if (fleet_input_load(&in, path) < 0)
+		return EXIT_FAILURE;
+	if (nremote) {
+		in.remote = remote;
+		in.nremote = nremote;
+	}
+	if (in.count == 0) {
+		fprintf(stderr, "No bootstage dumps found in %s\n", path);
+		fleet_input_free(&in);
+		return EXIT_FAILURE;
+	}
+	if (fleet_analyze(&in, nthreads, &res) < 0) {
+		fleet_input_free(&in);
+		return EXIT_FAILURE;
+	}
+
+	if (!json_file || strcmp(json_file, "-") != 0)
+		fleet_print(&res, unit, stdout);
+	if (json_file) {
+		FILE *fp = strcmp(json_file, "-") ? fopen(json_file, "w") : stdout;
+		if (fp) {
+			fleet_export_json(&res, unit, fp);
+			if (fp != stdout)
+				fclose(fp);
+		} else {
+			perror("Failed to write fleet JSON");
+			ret = EXIT_FAILURE;
 		}
-		esc[(oi<sizeof(esc))?oi:sizeof(esc)-1]='\0';
-		fprintf(fp, "'MCU: %s'%s", esc, (i < mcu_count-1) ? "," : "");
-	}
-	fprintf(fp, "];\n");
-
-	/* Absolute values, padded with nulls in the opposite domain rows */
-	fprintf(fp, "const absLinux=[");
-	for (int i = 0; i < count; ++i)
-		fprintf(fp, "%u,", boot_records[i].start_time);
-	for (int i = 0; i < mcu_count; ++i)
-		fprintf(fp, "null%s", (i < mcu_count-1) ? "," : "");
-	fprintf(fp, "];\n");
-
-	fprintf(fp, "const absMCU=[");
-	for (int i = 0; i < count; ++i)
-		fprintf(fp, "null,");
-	for (int i = 0; i < mcu_count; ++i)
-		fprintf(fp, "%u%s", mcu_boot_records[i].start_time, (i < mcu_count-1)?"," :"");
-	fprintf(fp, "];\n");
-
-	/* Deltas (used to build duration windows) */
-	fprintf(fp, "const delLinux=[");
-	for (int i = 0; i < count; ++i)
-		fprintf(fp, "%u,", boot_records[i].delta_time);
-	for (int i = 0; i < mcu_count; ++i)
-		fprintf(fp, "null%s", (i < mcu_count-1) ? "," : "");
-	fprintf(fp, "];\n");
-
-	fprintf(fp, "const delMCU=[");
-	for (int i = 0; i < count; ++i)
-		fprintf(fp, "null,");
-	for (int i = 0; i < mcu_count; ++i)
-		fprintf(fp, "%u%s", mcu_boot_records[i].delta_time, (i < mcu_count-1)?"," :"");
-	fprintf(fp, "];\n");
-
-	/* ---- JS helpers + chart (Duration = [start, start+delta]) ---- */
-	fprintf(fp,
-		"const fmt=(v)=>v.toString()+\" ms\";\n"
-		/* Build duration windows anchored to true start_time (absolute) */
-		"function toWindows(absArr, delArr){"
-		"  const out=[];"
-		"  for(let i=0;i<absArr.length;i++){"
-		"    const s=absArr[i], d=delArr[i];"
-		"    if(s==null || d==null){ out.push(null); }"
-		"    else{ out.push([s, s + d]); }"
-		"  }"
-		"  return out;"
-		"}\n"
-		"let durLinux = toWindows(absLinux, delLinux);\n"
-		"let durMCU   = toWindows(absMCU,   delMCU);\n"
-
-		/* Value labels plugin (works for both absolute and window bars) */
-		"Chart.register({id:'valueOnBar',afterDatasetsDraw(c){"
-		" const ctx=c.ctx, x=c.scales.x, y=c.scales.y; ctx.save();"
-		" ctx.font='12px sans-serif'; ctx.fillStyle='#000'; ctx.textAlign='left'; ctx.textBaseline='middle';"
-		" c.data.datasets.forEach(ds=>{"
-		"   const D=ds.data;"
-		"   D.forEach((v,i)=>{ if(v==null) return;"
-		"     const val=(Array.isArray(v)?(v[1]-v[0]):v);"
-		"     const xp=x.getPixelForValue(Array.isArray(v)?v[1]:v);"
-		"     const yp=y.getPixelForValue(i);"
-		"     ctx.fillText(fmt(val), xp+6, yp);"
-		"   });"
-		" });"
-		" ctx.restore(); }});\n"
-
-		/* Build combined chart with two datasets */
-		"let mode='abs';\n"
-		"const ctx=document.getElementById('chartCombined').getContext('2d');\n"
-		"const chart=new Chart(ctx,{"
-		" type:'bar',"
-		" data:{"
-		"   labels:labels,"
-		"   datasets:["
-		"     {label:'A53 / Linux', data:absLinux.slice()},"
-		"     {label:'MCU',          data:absMCU.slice()}"
-		"   ]"
-		" },"
-		" options:{indexAxis:'y',responsive:true,maintainAspectRatio:false,"
-		"  scales:{x:{beginAtZero:true,title:{display:true,text:'Boot Time (ms)'}}},"
-		"  plugins:{legend:{display:true},tooltip:{enabled:true},valueOnBar:{}}"
-		" }});\n"
-
-		"function render(){"
-		"  chart.data.datasets[0].data = (mode==='abs') ? absLinux.slice() : durLinux.slice();"
-		"  chart.data.datasets[1].data = (mode==='abs') ? absMCU.slice()   : durMCU.slice();"
-		"  chart.options.parsing = (mode==='dur') ? {xAxisKey:undefined} : true;"
-		"  chart.update();"
-		"}\n"
-		"document.querySelectorAll('input[name=\"mode\"]').forEach(r=>{"
-		"  r.addEventListener('change',e=>{mode=e.target.value; render();});"
-		"});\n"
-		"render();\n"
-	);
-
-	/* ---- Optional tables ---- */
-	fprintf(fp,
-		"document.write('<h3>Bootloader & Linux Stages</h3>');\n"
-		"document.write('<table><thead><tr><th>#</th><th>Stage</th><th>Absolute (ms)</th><th>Delta (ms)</th></tr></thead><tbody>');\n"
-		"let idx=1; for(let i=0;i<labels.length;i++){"
-		"  if(absLinux[i]==null) continue;"
-		"  const name=labels[i].replace(/^A53: /,'');"
-		"  document.write('<tr><td>'+ (idx++) +'</td><td>'+name+'</td><td>'+absLinux[i]+'</td><td>'+delLinux[i]+'</td></tr>');"
-		"}"
-		"document.write('</tbody></table>');\n"
-		"if(mcuN>0){"
-		"  document.write('<h3>MCU Stages</h3>');"
-		"  document.write('<table><thead><tr><th>#</th><th>Stage</th><th>Absolute (ms)</th><th>Delta (ms)</th></tr></thead><tbody>');"
-		"  let j=1; for(let i=0;i<labels.length;i++){"
-		"    if(absMCU[i]==null) continue;"
-		"    const name=labels[i].replace(/^MCU: /,'');"
-		"    document.write('<tr><td>'+ (j++) +'</td><td>'+name+'</td><td>'+absMCU[i]+'</td><td>'+delMCU[i]+'</td></tr>');"
-		"  }"
-		"  document.write('</tbody></table>');"
-		"}\n"
-	);
-
-	fprintf(fp, "</script></body></html>\n");
-	fclose(fp);
+	}
+	fleet_result_free(&res);
+	fleet_input_free(&in);
+	return ret;
 }
 
 /**
- * @brief Prints the collected boot records.
+ * @brief Lists the boots of an archive, and prints one in full when a boot
+ * was selected with --boot.
  * 
- * This function outputs the gathered boot records to the console or another
- * output stream for verification or analysis.
+ * @param path Archive file.
+ * @param boot Boot to print in full, or 1 for none.
+ * @param unit Display unit of the times.
+ * @return int EXIT_SUCCESS on success, EXIT_FAILURE otherwise.
  */
-void print_boot_records()
+static int run_archive_dump(const char *path, int boot, boot_time_unit_t unit)
 {
-	printf("--------------------------------------------------------------------\n");
-	printf("                 %s Boot Time Report \n", hostname);
-	printf("--------------------------------------------------------------------\n");
-
-	printf("Device Power On         : %u ms\n", 0);
-	printf("SPL Time		: %u ms\n", boot_summary.ustart_time);
-	printf("U-Boot Time		: %u ms\n", (boot_summary.uend_time - boot_summary.ustart_time));
-	printf("Kernel handoff time	: %u ms\n", (boot_summary.kstart_time - boot_summary.uend_time));
-	printf("Kernel Time		: %u ms\n", (boot_summary.kend_time - boot_summary.kstart_time));
-	printf("Total Boot Time		: %u ms\n", boot_summary.kend_time);
-	printf("--------------------------------------------------------------------\n\n");
-	printf("--------------------------------------------------------------------\n");
-	printf("                 Bootloader and Kernel Boot Records\n");
-	printf("--------------------------------------------------------------------\n");
-	for(int i = 0; i < boot_summary.count; i++)
-		printf("%-30s = %6u ms (+%3u ms)\n", boot_records[i].name,
-				boot_records[i].start_time,
-				boot_records[i].delta_time);
-	printf("--------------------------------------------------------------------\n\n");
-	printf("--------------------------------------------------------------------\n");
-	printf("                 MCU Boot Records \n");
-	printf("--------------------------------------------------------------------\n");
-	for(int i = 0; i <  boot_summary.mcu_reccount; i++)
-		printf("%-30s = %6u ms (+%3u ms)\n", mcu_boot_records[i].name,
-				mcu_boot_records[i].start_time,
-				mcu_boot_records[i].delta_time);
-	printf("--------------------------------------------------------------------\n");
+	boot_time_ctx_t *ctx;
+	boot_archive_t ar;
+	int ret;
+
+	if (boot > 0) {
+		if (boot_archive_open(&ar, path) < 0)
+			return EXIT_FAILURE;
+		boot_archive_print(&ar, unit, stdout);
+		boot_archive_close(&ar);
+		return EXIT_SUCCESS;
+	}
+
+	ctx = boot_time_ctx_create();
+	if (!ctx) {
+		perror("boot_time_ctx_create");
+		return EXIT_FAILURE;
+	}
+	boot_time_set_unit(ctx, unit);
+	ret = boot_time_read_archive(ctx, path, boot);
+	if (ret == EXIT_SUCCESS)
+		boot_time_print_report(ctx, stdout, path);
+	boot_time_ctx_destroy(ctx);
+	return ret;
 }
 
 /**
- * @brief Reads kernel boot records from a log file.
- * 
- * This function parses the specified log file to extract kernel boot
- * information, such as initialization times or errors encountered during
- * startup.
- * 
- * @param filepath The path to the log file containing kernel boot records.
+ * @brief Compares boots against a baseline archive and checks the budget.
+ *
+ * @param ctx Parsed boot used as the candidate, or NULL.
+ * @param baseline Baseline archive, or NULL.
+ * @param candidate Archive of candidate boots used when ctx is NULL.
+ * @param budget_file Budget file, or NULL.
+ * @param unit Display unit of the times.
+ * @return int EXIT_SUCCESS when every budget is met, EXIT_FAILURE otherwise.
  */
-void read_kernel_boot_records(const char* filename) {
-	char line[512];
-	int index = 0;
+static int run_compare(const boot_time_ctx_t *ctx, const char *baseline,
+		const char *candidate, const char *budget_file, boot_time_unit_t unit)
+{
+	boot_budget_t budget = { 0 };
+	boot_compare_t cmp;
+	int ret = EXIT_FAILURE;
+
+	boot_compare_init(&cmp);
+	if (budget_file && boot_budget_load(&budget, budget_file) < 0)
+		goto out;
+	if (baseline && boot_compare_add_archive(&cmp, BOOT_COMPARE_BASELINE, baseline) < 0)
+		goto out;
+	if (ctx ? boot_compare_add_ctx(&cmp, BOOT_COMPARE_CANDIDATE, ctx) < 0 :
+			boot_compare_add_archive(&cmp, BOOT_COMPARE_CANDIDATE, candidate) < 0)
+		goto out;
+	ret = EXIT_SUCCESS;
+	if (baseline) {
+		printf("\n");
+		boot_compare_print(&cmp, unit, stdout);
+	}
+	if (budget_file) {
+		printf("\n");
+		if (boot_budget_check(&budget, &cmp, unit, stdout) > 0)
+			ret = EXIT_FAILURE;
+	}
+out:
+	boot_budget_free(&budget);
+	boot_compare_free(&cmp);
+	return ret;
+}
 
-	FILE *fp = fopen(filename, "r");
-	if (!fp) {
-		perror("Failed to open kernel log");
-		return;
+/**
+ * @brief Streams remote core records that appear after the region was read.
+ *
+ * @param ctx Parsed boot, read from src.
+ * @param src Region source, kept open for polling.
+ * @param opts Final stage, timeout and poll period.
+ * @param out_file Output file, or NULL for stdout.
+ * @return int EXIT_SUCCESS when the final stage was seen, or no final
+ * stage was given and the watch timed out; EXIT_FAILURE otherwise.
+ */
+static int run_watch(boot_time_ctx_t *ctx, bootstage_source_t *src,
+		const boot_watch_opts_t *opts, const char *out_file)
+{
+	FILE *fp = stdout;
+	int ret;
+
+	if (out_file) {
+		fp = fopen(out_file, "a");
+		if (!fp) {
+			perror("Failed to open watch output");
+			return EXIT_FAILURE;
+		}
+	}
+	ret = boot_time_watch(ctx, src, opts, fp);
+	if (fp != stdout)
+		fclose(fp);
+	if (ret > 0 && opts->until_stage) {
+		fprintf(stderr, "Timed out waiting for %s\n", opts->until_stage);
+		return EXIT_FAILURE;
 	}
+	return (ret < 0) ? EXIT_FAILURE : EXIT_SUCCESS;
+}
 
-	while (fgets(line, sizeof(line), fp)) {
-		char *tag = strstr(line, "[BOOT TRACKER]");
-		if (!tag)
-			continue;
+/* Size of a file the run wrote, 0 if it is missing */
+static uint64_t file_size(const char *path)
+{
+	struct stat st;
 
-		int id;
-		unsigned int time;
-		if (sscanf(line, "%*[^I]ID:%d%*[^=]=%u", &id, &time) != 2) {
-			continue;  // Failed to parse ID and time
-		}
+	return (stat(path, &st) == 0) ? (uint64_t)st.st_size : 0;
+}
 
-		unsigned int time_ms = (time / 1000);
-		unsigned int delta_us = (prev_time == 0) ? 0 : (time_ms - prev_time);
-		strcpy(boot_records[boot_summary.count].name, get_bootstage_id_name(id));
-		boot_records[boot_summary.count].start_time = time_ms;
-		boot_records[boot_summary.count].delta_time = delta_us;
-		prev_time = time_ms;
-		if(!index && time_ms > boot_summary.uend_time)
-			boot_summary.kstart_time = prev_time;
-		else if(time_ms > boot_summary.kstart_time)
-			boot_summary.kend_time = time_ms;
-		boot_summary.count++;
-		index ++;
-	}
-	fclose(fp);
+/* Output position of a stream, 0 when it is a terminal or pipe */
+static uint64_t stream_pos(FILE *fp)
+{
+	off_t pos = ftello(fp);
+
+	return (pos > 0) ? (uint64_t)pos : 0;
 }
 
-/**
- * @brief Reads U-Boot stage records from memory.
- * 
- * This function extracts boot stage information from memory, likely
- * related to the U-Boot bootloader. The data is used for diagnostic
- * or performance analysis purposes.
+/* Upper bound on --sync and --what-if options */
+#define CP_MAX_OPTS	32
+
+/*
+ * Splits "CORE:STAGE" in place. A missing core defaults to def_core.
  */
-int read_ubootstage_records_from_mem()
+static void split_core_stage(char *s, const char *def_core, const char **core,
+		const char **stage)
 {
-	int fd;
-	void *mapped;
-	uint8_t *buffer;
-
-	/* Open /dev/mem for read-only access */
-	fd = open("/dev/mem", O_RDONLY);
-	if (fd < 0) {
-		perror("Error opening /dev/mem");
-		return EXIT_FAILURE;
+	char *colon = strchr(s, ':');
+
+	if (colon) {
+		*colon = '\0';
+		*core = s;
+		*stage = colon + 1;
+	} else {
+		*core = def_core;
+		*stage = s;
 	}
-	/* Map the bootstage region into our process address space */
-	mapped = mmap(NULL, BOOTSTAGE_SIZE, PROT_READ, MAP_SHARED, fd, BOOTSTAGE_PRESERVED_ADDR);
-	if (mapped == MAP_FAILED) {
-		perror("mmap");
-		close(fd);
-		return EXIT_FAILURE;
+}
+
+/* Parses "CORE:STAGE=CORE:STAGE" in place */
+static int parse_sync_dep(char *s, boot_sync_dep_t *dep)
+{
+	char *eq = strchr(s, '=');
+
+	if (!eq)
+		return -1;
+	*eq = '\0';
+	split_core_stage(s, "MCU", &dep->waiter_core, &dep->waiter);
+	split_core_stage(eq + 1, "A53", &dep->source_core, &dep->source);
+	return 0;
+}
+
+/* Parses "CORE:STAGE=REF_STAGE" and adds it to the context's clock sync points */
+static int add_clock_sync(boot_time_ctx_t *ctx, char *s)
+{
+	char *colon = strchr(s, ':');
+	char *eq = colon ? strchr(colon, '=') : NULL;
+
+	if (!eq)
+		return -1;
+	*colon = '\0';
+	*eq = '\0';
+	return boot_time_add_clock_sync(ctx, s, colon + 1, eq + 1);
+}
+
+/* Parses "STAGE=TIME" in place, see boot_time_parse_duration() */
+static int parse_what_if(char *s, boot_what_if_t *wi)
+{
+	char *eq = strrchr(s, '=');
+
+	if (!eq)
+		return -1;
+	*eq = '\0';
+	wi->stage = s;
+	return boot_time_parse_duration(eq + 1, &wi->faster);
+}
+
+/**
+ * @brief Prints the cross-core critical path of the boot and the effect of
+ * the requested what-if speedups.
+ *
+ * @param ctx Parsed boot.
+ * @param deps Sync points, the built-in ones followed by --sync options.
+ * @param ndeps Number of deps.
+ * @param ready Stage that marks system ready, or NULL for the last record.
+ * @param wi What-if speedups.
+ * @param nwi Number of speedups.
+ */
+static void run_critical_path(const boot_time_ctx_t *ctx, const boot_sync_dep_t *deps,
+		size_t ndeps, const char *ready, const boot_what_if_t *wi, size_t nwi)
+{
+	boot_time_unit_t unit = boot_time_unit(ctx);
+	const char *un = boot_time_unit_name(unit);
+	boot_cp_t cp;
+	uint64_t base, t;
+
+	if (boot_cp_analyze(ctx, deps, ndeps, ready, &cp) < 0)
+		return;
+	printf("\n");
+	boot_cp_print(&cp, unit, stdout);
+	if (nwi && boot_cp_what_if(&cp, NULL, 0, &base) == 0) {
+		printf("\n--------------------------------------------------------------------\n");
+		printf("                 What-if\n");
+		printf("--------------------------------------------------------------------\n");
+		for (size_t i = 0; i < nwi; i++) {
+			if (boot_cp_what_if(&cp, &wi[i], 1, &t) == 0)
+				printf("%-30s -%5" PRIu64 " %s: ready at %6" PRIu64 " %s (-%" PRIu64 " %s)\n",
+						wi[i].stage, boot_time_to_unit(wi[i].faster, unit), un,
+						boot_time_to_unit(t, unit), un,
+						boot_time_to_unit(base - t, unit), un);
+		}
+		if (nwi > 1 && boot_cp_what_if(&cp, wi, nwi, &t) == 0)
+			printf("%-30s        : ready at %6" PRIu64 " %s (-%" PRIu64 " %s)\n",
+					"All of the above", boot_time_to_unit(t, unit), un,
+					boot_time_to_unit(base - t, unit), un);
+		printf("--------------------------------------------------------------------\n");
 	}
-	close(fd);
-	/* Allocate a local buffer and copy the mapped memory into it */
-	buffer = malloc(BOOTSTAGE_SIZE);
-	if (buffer == NULL) {
-		perror("malloc");
-		munmap(mapped, BOOTSTAGE_SIZE);
-		return EXIT_FAILURE;
+	boot_cp_free(&cp);
+}
+
+static void usage(const char *prog)
+{
+	fprintf(stderr,
+		"Usage: %s [options]\n"
+		"  -d, --dump <file>   read bootstage region from a raw dump instead of /dev/mem\n"
+		"  -l, --log <file>    kernel log to scan (default /var/log/messages)\n"
+		"  -k, --kmsg          read kernel records from " KMSG_DEVICE " instead of the log\n"
+		"      --kmsg-dump <file>  read kernel records from a saved kmsg/dmesg dump\n"
+		"      --capture <file>  analyze a boot_time_capture file instead of reading\n"
+		"                      the bootstage region and kernel log\n"
+		"      --bootstage-layout <name>  record layout of the U-Boot build that wrote\n"
+		"                      the region, e.g. le32 or be64 (default: auto)\n"
+		"      --kernel-region <offset|none>  kernel record area in the bootstage\n"
+		"                      region, used instead of the log when it holds\n"
+		"                      records (default: after the U-Boot records)\n"
+		"  -b, --boot <n>      boot to report: 0 latest (default), -1 previous, ...\n"
+		"      --milestones[=<file>]  add user-space milestones logged with\n"
+		"                      boot_time_mark() (default " BOOT_MILESTONE_PATH ")\n"
+		"      --mark <name>   log a user-space milestone now and exit\n"
+		"      --markers <file>  also turn the log lines described in a marker\n"
+		"                      config into records\n"
+		"      --initcalls[=<n>]  list the n slowest initcalls and probes of an\n"
+		"                      initcall_debug kernel log (default %d)\n"
+		"      --index <file>  kernel log index (default <log>.btidx)\n"
+		"      --no-index      scan the whole log without a boot index\n"
+		"  -j, --jobs <n>      threads used to scan large logs (default: all CPUs)\n"
+		"      --scan-bench <MiB>  report tracker scan throughput on a synthetic log\n"
+		"      --remote-core <label@offset[:anchor id[:counter Hz]]>  remote core record\n"
+		"                      block; repeat for each core (default MCU@0x80000:176,\n"
+		"                      1 MHz counter)\n"
+		"      --clock-sync <core:stage=a53 stage>  stages seen at the same instant;\n"
+		"                      fits the core's clock offset and drift (repeatable)\n"
+		"      --kernel-epoch <ms>  time since power on of kernel time stamp 0\n"
+		"      --watch[=<file>]  after reading the region, keep polling the remote\n"
+		"                      core blocks and stream new records to stdout or file\n"
+		"      --until <[core:]stage>  stop watching once this stage is recorded\n"
+		"      --watch-timeout <time>  stop watching after this long (default 60 s,\n"
+		"                      0 for none with --until); ms unless suffixed\n"
+		"      --watch-interval <time>  poll period of --watch (default 10 ms)\n"
+		"      --timeline      also print all cores' records merged in time order\n"
+		"      --trace <file>  also write a Chrome trace / Perfetto JSON timeline\n"
+		"      --archive <file>  append this boot to a columnar boot archive\n"
+		"      --archive-dump <file>  list archived boots, or print the one picked with --boot\n"
+		"      --fleet <dir|manifest>  per-stage statistics over many captured boots\n"
+		"      --fleet-json <file>  also write fleet statistics as JSON (- for stdout)\n"
+		"      --critical-path  print the cross-core critical path and wait times\n"
+		"      --sync <core:stage=core:stage>  add a sync point: waiter=source\n"
+		"      --ready <stage>  stage that marks system ready (default: last record)\n"
+		"      --what-if <stage=time>  replay the boot with a stage made faster;\n"
+		"                      time is in ms unless suffixed ns, us or ms\n"
+		"      --units <ns|us|ms>  unit of the reported times (default ms)\n"
+		"      --compare <archive>  compare with the baseline boots of an archive\n"
+		"      --candidate <archive>  compare the boots of this archive instead of\n"
+		"                      parsing the current boot\n"
+		"      --budget <file>  check stage and total time limits; exits with an\n"
+		"                      error on any violation\n"
+		"      --profile[=<file>]  print the time, I/O and memory of each parser\n"
+		"                      phase to stderr; also append them as JSON to file\n"
+		"  -h, --help          show this help\n",
+		prog, BOOT_KERNEL_CALLS_DEFAULT);
+}
+
+int main(int argc, char *argv[])
+{
+	static const struct option long_opts[] = {
+		{ "dump", required_argument, NULL, 'd' },
+		{ "log",  required_argument, NULL, 'l' },
+		{ "jobs", required_argument, NULL, 'j' },
+		{ "boot", required_argument, NULL, 'b' },
+		{ "kmsg", no_argument,       NULL, 'k' },
+		{ "kmsg-dump", required_argument, NULL, 'K' },
+		{ "index", required_argument, NULL, 'I' },
+		{ "no-index", no_argument,   NULL, 'N' },
+		{ "scan-bench", required_argument, NULL, 'B' },
+		{ "trace", required_argument, NULL, 'T' },
+		{ "archive", required_argument, NULL, 'A' },
+		{ "archive-dump", required_argument, NULL, 'D' },
+		{ "fleet", required_argument, NULL, 'F' },
+		{ "fleet-json", required_argument, NULL, 'J' },
+		{ "remote-core", required_argument, NULL, 'M' },
+		{ "timeline", no_argument,   NULL, 'U' },
+		{ "clock-sync", required_argument, NULL, 'Y' },
+		{ "kernel-epoch", required_argument, NULL, 'E' },
+		{ "critical-path", no_argument, NULL, 'C' },
+		{ "sync", required_argument, NULL, 'S' },
+		{ "ready", required_argument, NULL, 'R' },
+		{ "what-if", required_argument, NULL, 'W' },
+		{ "units", required_argument, NULL, 'Z' },
+		{ "milestones", optional_argument, NULL, 'X' },
+		{ "mark", required_argument, NULL, 'V' },
+		{ "initcalls", optional_argument, NULL, 'L' },
+		{ "markers", required_argument, NULL, 'O' },
+		{ "capture", required_argument, NULL, 'H' },
+		{ "compare", required_argument, NULL, 'P' },
+		{ "candidate", required_argument, NULL, 'Q' },
+		{ "budget", required_argument, NULL, 'G' },
+		{ "watch", optional_argument, NULL, 'w' },
+		{ "until", required_argument, NULL, 'u' },
+		{ "watch-timeout", required_argument, NULL, 't' },
+		{ "watch-interval", required_argument, NULL, 'i' },
+		{ "profile", optional_argument, NULL, 'p' },
+		{ "bootstage-layout", required_argument, NULL, 'a' },
+		{ "kernel-region", required_argument, NULL, 'e' },
+		{ "help", no_argument,       NULL, 'h' },
+		{ NULL, 0, NULL, 0 }
+	};
+	const char *dump_file = NULL;
+	const char *log_file = "/var/log/messages";
+	const char *kmsg_path = NULL;
+	const char *log_index_path = NULL;
+	const char *trace_path = NULL;
+	const char *archive_path = NULL;
+	const char *archive_dump = NULL;
+	const char *fleet_path = NULL;
+	const char *fleet_json = NULL;
+	int scan_threads = 0;
+	unsigned scan_bench_mb = 0;
+	int scan_bench = 0;
+	int boot_select = 0;
+	int boot_given = 0;
+	int no_log_index = 0;
+	boot_sync_dep_t deps[CP_MAX_OPTS];
+	boot_what_if_t what_if[CP_MAX_OPTS];
+	size_t ndeps = 0, nwhat_if = 0;
+	const char *ready_stage = NULL;
+	int critical_path = 0;
+	boot_remote_core_t remote[BOOT_REMOTE_CORES_MAX];
+	int nremote = 0;
+	int timeline = 0;
+	char *clock_sync[BOOT_CLOCK_SYNC_MAX];
+	int nclock_sync = 0;
+	double kernel_epoch_ms = 0;
+	int clocks = 0;
+	boot_time_unit_t unit = BOOT_UNIT_MS;
+	const char *compare_path = NULL;
+	const char *candidate_path = NULL;
+	const char *budget_path = NULL;
+	const char *milestone_path = NULL;
+	int kernel_calls = 0;
+	const char *marker_path = NULL;
+	const char *layout_name = NULL;
+	size_t kernel_region = BOOT_KERNEL_REGION_AFTER;
+	const char *capture_path = NULL;
+	boot_watch_opts_t watch_opts = {
+		.timeout_ns = BOOT_WATCH_TIMEOUT_DEFAULT,
+		.interval_ns = BOOT_WATCH_INTERVAL_DEFAULT,
+	};
+	const char *watch_file = NULL;
+	char *until = NULL;
+	int watch = 0;
+	bootstage_source_t src;
+	int src_open = 0;
+	boot_profile_t profile, *prof = NULL;
+	const char *profile_json = NULL;
+	uint64_t pos;
+	int ret = EXIT_SUCCESS;
+	boot_time_ctx_t *ctx;
+	int opt;
+
+	while ((opt = getopt_long(argc, argv, "d:l:j:b:kh", long_opts, NULL)) != -1) {
+		switch (opt) {
+		case 'd':
+			dump_file = optarg;
+			break;
+		case 'l':
+			log_file = optarg;
+			break;
+		case 'j':
+			scan_threads = atoi(optarg);
+			break;
+		case 'k':
+			kmsg_path = KMSG_DEVICE;
+			break;
+		case 'K':
+			kmsg_path = optarg;
+			break;
+		case 'b':
+			boot_select = atoi(optarg);
+			boot_given = 1;
+			break;
+		case 'I':
+			log_index_path = optarg;
+			break;
+		case 'N':
+			no_log_index = 1;
+			break;
+		case 'B':
+			scan_bench_mb = strtoul(optarg, NULL, 0);
+			scan_bench = 1;
+			break;
+		case 'T':
+			trace_path = optarg;
+			break;
+		case 'A':
+			archive_path = optarg;
+			break;
+		case 'D':
+			archive_dump = optarg;
+			break;
+		case 'F':
+			fleet_path = optarg;
+			break;
+		case 'J':
+			fleet_json = optarg;
+			break;
+		case 'M':
+			if (nremote == BOOT_REMOTE_CORES_MAX ||
+					boot_time_parse_remote_core(optarg, &remote[nremote]) < 0) {
+				fprintf(stderr, "Bad or too many --remote-core options\n");
+				return EXIT_FAILURE;
+			}
+			nremote++;
+			break;
+		case 'U':
+			timeline = 1;
+			break;
+		case 'Y':
+			if (nclock_sync == BOOT_CLOCK_SYNC_MAX) {
+				fprintf(stderr, "Too many --clock-sync options\n");
+				return EXIT_FAILURE;
+			}
+			clock_sync[nclock_sync++] = optarg;
+			clocks = 1;
+			break;
+		case 'E':
+			kernel_epoch_ms = strtod(optarg, NULL);
+			clocks = 1;
+			break;
+		case 'C':
+			critical_path = 1;
+			break;
+		case 'S':
+			if (ndeps == CP_MAX_OPTS || parse_sync_dep(optarg, &deps[ndeps]) < 0) {
+				fprintf(stderr, "Bad or too many --sync options\n");
+				return EXIT_FAILURE;
+			}
+			ndeps++;
+			critical_path = 1;
+			break;
+		case 'R':
+			ready_stage = optarg;
+			critical_path = 1;
+			break;
+		case 'W':
+			if (nwhat_if == CP_MAX_OPTS || parse_what_if(optarg, &what_if[nwhat_if]) < 0) {
+				fprintf(stderr, "Bad or too many --what-if options\n");
+				return EXIT_FAILURE;
+			}
+			nwhat_if++;
+			critical_path = 1;
+			break;
+		case 'Z':
+			if (boot_time_parse_unit(optarg, &unit) < 0) {
+				fprintf(stderr, "Unknown unit %s\n", optarg);
+				return EXIT_FAILURE;
+			}
+			break;
+		case 'P':
+			compare_path = optarg;
+			break;
+		case 'Q':
+			candidate_path = optarg;
+			break;
+		case 'G':
+			budget_path = optarg;
+			break;
+		case 'X':
+			milestone_path = optarg ? optarg : BOOT_MILESTONE_PATH;
+			break;
+		case 'L':
+			kernel_calls = optarg ? atoi(optarg) : BOOT_KERNEL_CALLS_DEFAULT;
+			if (kernel_calls <= 0) {
+				fprintf(stderr, "Bad --initcalls count %s\n", optarg);
+				return EXIT_FAILURE;
+			}
+			break;
+		case 'O':
+			marker_path = optarg;
+			break;
+		case 'a':
+			layout_name = optarg;
+			break;
+		case 'e':
+			if (strcmp(optarg, "none") == 0) {
+				kernel_region = BOOT_KERNEL_REGION_NONE;
+			} else {
+				char *end;
+
+				kernel_region = strtoul(optarg, &end, 0);
+				if (*end || kernel_region == 0) {
+					fprintf(stderr, "Bad --kernel-region %s\n", optarg);
+					return EXIT_FAILURE;
+				}
+			}
+			break;
+		case 'H':
+			capture_path = optarg;
+			break;
+		case 'w':
+			watch = 1;
+			watch_file = optarg;
+			break;
+		case 'u':
+			until = optarg;
+			watch = 1;
+			break;
+		case 't':
+			if (boot_time_parse_duration(optarg, &watch_opts.timeout_ns) < 0) {
+				fprintf(stderr, "Bad --watch-timeout %s\n", optarg);
+				return EXIT_FAILURE;
+			}
+			watch = 1;
+			break;
+		case 'i':
+			if (boot_time_parse_duration(optarg, &watch_opts.interval_ns) < 0 ||
+					watch_opts.interval_ns == 0) {
+				fprintf(stderr, "Bad --watch-interval %s\n", optarg);
+				return EXIT_FAILURE;
+			}
+			break;
+		case 'p':
+			memset(&profile, 0, sizeof(profile));
+			prof = &profile;
+			profile_json = optarg;
+			break;
+		case 'V':
+			if (boot_time_mark(optarg) < 0) {
+				fprintf(stderr, "Failed to log milestone %s\n", optarg);
+				return EXIT_FAILURE;
+			}
+			return EXIT_SUCCESS;
+		case 'h':
+			usage(argv[0]);
+			return EXIT_SUCCESS;
+		default:
+			usage(argv[0]);
+			return EXIT_FAILURE;
+		}
 	}
-	memcpy(buffer, mapped, BOOTSTAGE_SIZE);
-	munmap(mapped, BOOTSTAGE_SIZE);
 
-	/* Parse the header from our local buffer */
-	struct uboot_bootstage_hdr *hdr = (struct uboot_bootstage_hdr *)buffer;
-	if (hdr->magic != BOOTSTAGE_MAGIC || hdr->size == 0) {
-		fprintf(stderr, "Invalid bootstage header: magic=0x%08x, size=0x%x\n",
-		hdr->magic, hdr->size);
-		free(buffer);
+	/* After option parsing, so a -j given after it still applies */
+	if (scan_bench)
+		return run_scan_bench(scan_bench_mb, scan_threads);
+
+	if (kmsg_path && (kernel_calls || marker_path)) {
+		fprintf(stderr, "--initcalls and --markers need the kernel log, not --kmsg\n");
 		return EXIT_FAILURE;
 	}
-#ifdef DEBUG
-	printf(" Version : %u\n", hdr->version);
-	printf(" Count : %u\n", hdr->count);
-	printf(" Size : 0x%x\n", hdr->size);
-	printf(" Magic : 0x%08x\n", hdr->magic);
-	printf(" Next ID : %u\n", hdr->next_id);
-#endif
-	boot_summary.count = hdr->count;
-	/* The bootstage records follow immediately after the header */
-	struct uboot_bootstage_record *records =
-		(struct uboot_bootstage_record *)(buffer + sizeof(struct uboot_bootstage_hdr));
-
-	/* Loop through and print each record (limit to the lower of hdr->count and RECORD_COUNT) */
-	for (int i = 0; i < (int)hdr->count && i < RECORD_COUNT; i++) {
-		struct uboot_bootstage_record *rec = &records[i];
-		strcpy(boot_records[i].name, get_bootstage_id_name(rec->id));
-		uint64_t time_ms = ((records[i].start_us ? records[i].start_us : records[i].time_us) / 1000);
-		boot_records[i].delta_time = (prev_time == 0) ? 0 : (time_ms - prev_time);
-		boot_records[i].start_time = time_ms;
-		prev_time = time_ms;
-
-		if(rec->id == BOOTSTAGE_START_UBOOT)
-			boot_summary.ustart_time = prev_time;
-		if(rec->id == BOOTSTAGE_BOOTM_HANDOFF)
-			boot_summary.uend_time = prev_time;
-		if(rec->id == BOOTSTAGE_START_MCU)
-			 boot_summary.mcu_start_time = prev_time;
-	}
-
-	/* Other subsystem (MCU/DSP) boot record parsing */
-	mcu_boot_stage_record_t *mcuhdr = (mcu_boot_stage_record_t *)(buffer + MCU_BOOTSTAGE_START_OFFSET);
-	boot_summary.mcu_reccount = mcuhdr -> record_count + 1;
-
-#ifdef DEBUG
-	printf("Subsystem(MCU) record id = %x\n", mcuhdr -> record_id);
-	printf("MCU:%d record count = %d\n", mcuhdr -> record_id, mcuhdr -> record_count);
-	printf("MCU:%d record start time = %llu\n", mcuhdr -> record_id, mcuhdr -> start_time);
-#endif
-	uint64_t mcu_prev_time = boot_summary.mcu_start_time;
-	strcpy(mcu_boot_records[0].name, "MCU_AWAKE");
-	mcu_boot_records[0].start_time = boot_summary.mcu_start_time;
-	mcu_boot_records[0].delta_time = 0;
-
-	mcu_boot_record_profile_t *rec =  (mcu_boot_record_profile_t *)(buffer + MCU_BOOTSTAGE_START_OFFSET + MCU_BOOTRECORD_OFFSET);
-	for (int i = 0; i < (int)mcuhdr -> record_count; i++) {
-		mcu_boot_record_profile_t * record = &rec[i];
-		strcpy(mcu_boot_records[i+1].name, record -> name);
-		mcu_boot_records[i+1].start_time = (record -> time / 1000 + boot_summary.mcu_start_time);
-		mcu_boot_records[i+1].delta_time = (mcu_prev_time == 0) ? 0 : (mcu_boot_records[i+1].start_time - mcu_prev_time);
-		mcu_prev_time = mcu_boot_records[i+1].start_time;
-	}
-
-	free(buffer);
-}
+	if (watch) {
+		if (capture_path) {
+			fprintf(stderr, "--watch needs the live region or a dump, not --capture\n");
+			return EXIT_FAILURE;
+		}
+		if (until)
+			split_core_stage(until, NULL, &watch_opts.until_core,
+					&watch_opts.until_stage);
+		if (!watch_opts.until_stage && watch_opts.timeout_ns == 0) {
+			fprintf(stderr, "--watch-timeout 0 needs --until\n");
+			return EXIT_FAILURE;
+		}
+	}
+
+	if (fleet_path)
+		return run_fleet(fleet_path, fleet_json, scan_threads, remote, nremote, unit);
+	if (archive_dump)
+		return run_archive_dump(archive_dump, boot_given ? boot_select : 1, unit);
+	if (candidate_path)
+		return run_compare(NULL, compare_path, candidate_path, budget_path, unit);
 
-int main(void)
-{
 	if(gethostname(hostname, sizeof(hostname)) != 0)
 		perror("gethostname failed\n");
 
-	read_ubootstage_records_from_mem();
-	read_kernel_boot_records("/var/log/messages");
-	print_boot_records();
-	export_html("boot_time_report.html",  boot_summary.count);
-	return EXIT_SUCCESS;
+	ctx = boot_time_ctx_create();
+	if (!ctx) {
+		perror("boot_time_ctx_create");
+		return EXIT_FAILURE;
+	}
+	boot_time_set_jobs(ctx, scan_threads);
+	boot_time_set_unit(ctx, unit);
+	boot_time_set_boot(ctx, boot_select);
+	boot_time_set_log_index(ctx, no_log_index ? BOOT_TIME_LOG_INDEX_NONE : log_index_path);
+	if (nremote)
+		boot_time_set_remote_cores(ctx, remote, nremote);
+	boot_time_set_kernel_epoch(ctx, kernel_epoch_ms * 1e6);
+	boot_time_set_kernel_calls(ctx, kernel_calls);
+	boot_time_set_kernel_region(ctx, kernel_region);
+	if (layout_name && boot_time_set_bootstage_layout(ctx, layout_name) < 0) {
+		boot_time_ctx_destroy(ctx);
+		return EXIT_FAILURE;
+	}
+	if (marker_path && boot_time_set_markers(ctx, marker_path) < 0) {
+		boot_time_ctx_destroy(ctx);
+		return EXIT_FAILURE;
+	}
+	for (int i = 0; i < nclock_sync; i++) {
+		if (add_clock_sync(ctx, clock_sync[i]) < 0) {
+			fprintf(stderr, "Bad --clock-sync %s\n", clock_sync[i]);
+			boot_time_ctx_destroy(ctx);
+			return EXIT_FAILURE;
+		}
+	}
+
+	if (capture_path) {
+		boot_profile_begin(prof, ctx);
+		boot_time_read_capture(ctx, capture_path);
+		boot_profile_end(prof, "capture", 0);
+	} else {
+		boot_profile_begin(prof, ctx);
+		/* Kept open for --watch */
+		if (dump_file)
+			src_open = bootstage_source_open_file(&src, dump_file) == 0;
+		else
+			src_open = bootstage_source_open_mem(&src, BOOTSTAGE_PRESERVED_ADDR,
+					BOOTSTAGE_SIZE) == 0;
+		if (src_open)
+			boot_time_read_bootstage(ctx, &src);
+		boot_profile_end(prof, "region", 0);
+		boot_profile_begin(prof, ctx);
+		if (kmsg_path)
+			boot_time_read_kmsg(ctx, kmsg_path);
+		else
+			boot_time_read_kernel_log(ctx, log_file);
+		boot_profile_end(prof, kmsg_path ? "kmsg" : "kernel_log", 0);
+	}
+	if (milestone_path) {
+		boot_profile_begin(prof, ctx);
+		boot_time_read_milestones(ctx, milestone_path);
+		boot_profile_end(prof, "milestones", 0);
+	}
+	boot_profile_begin(prof, ctx);
+	boot_time_sync_clocks(ctx);
+	boot_profile_end(prof, "clock_sync", 0);
+	if (watch && !src_open)
+		ret = EXIT_FAILURE;
+	if (watch && src_open) {
+		boot_profile_begin(prof, ctx);
+		ret = run_watch(ctx, &src, &watch_opts, watch_file);
+		/* Late records may be clock sync points */
+		boot_time_sync_clocks(ctx);
+		boot_profile_end(prof, "watch", 0);
+	}
+	if (src_open)
+		bootstage_source_close(&src);
+
+	boot_profile_begin(prof, ctx);
+	pos = prof ? stream_pos(stdout) : 0;
+	boot_time_print_report(ctx, stdout, hostname);
+	if (clocks) {
+		printf("\n");
+		boot_time_print_clocks(ctx, stdout);
+	}
+	if (kernel_calls) {
+		printf("\n");
+		boot_time_print_kernel_calls(ctx, stdout);
+	}
+	if (timeline) {
+		printf("\n");
+		boot_time_print_timeline(ctx, stdout);
+	}
+	if (prof)
+		fflush(stdout);
+	boot_profile_end(prof, "text_report", prof ? stream_pos(stdout) - pos : 0);
+	if (critical_path) {
+		boot_sync_dep_t all[CP_MAX_OPTS + 8];
+		size_t n = 0;
+
+		boot_profile_begin(prof, ctx);
+		pos = prof ? stream_pos(stdout) : 0;
+		for (size_t i = 0; i < boot_cp_default_ndeps && n < CP_MAX_OPTS + 8 - ndeps; i++)
+			all[n++] = boot_cp_default_deps[i];
+		for (size_t i = 0; i < ndeps; i++)
+			all[n++] = deps[i];
+		run_critical_path(ctx, all, n, ready_stage, what_if, nwhat_if);
+		if (prof)
+			fflush(stdout);
+		boot_profile_end(prof, "critical_path", prof ? stream_pos(stdout) - pos : 0);
+	}
+	/* Before --archive, so a boot is never compared with itself */
+	if (compare_path || budget_path) {
+		boot_profile_begin(prof, ctx);
+		if (run_compare(ctx, compare_path, NULL, budget_path, unit) != EXIT_SUCCESS)
+			ret = EXIT_FAILURE;
+		boot_profile_end(prof, "compare", 0);
+	}
+	boot_profile_begin(prof, ctx);
+	boot_time_export_html(ctx, "boot_time_report.html", hostname);
+	boot_profile_end(prof, "html_export", prof ? file_size("boot_time_report.html") : 0);
+	if (trace_path) {
+		boot_profile_begin(prof, ctx);
+		if (boot_time_export_trace(ctx, trace_path, hostname) < 0)
+			fprintf(stderr, "Failed to write trace %s\n", trace_path);
+		boot_profile_end(prof, "trace_export", prof ? file_size(trace_path) : 0);
+	}
+	if (archive_path) {
+		pos = prof ? file_size(archive_path) : 0;
+		boot_profile_begin(prof, ctx);
+		if (boot_archive_append(archive_path, ctx, hostname, (uint64_t)time(NULL)) < 0)
+			fprintf(stderr, "Failed to append boot to %s\n", archive_path);
+		boot_profile_end(prof, "archive", prof ? file_size(archive_path) - pos : 0);
+	}
+	if (prof) {
+		fprintf(stderr, "\n");
+		boot_profile_print(prof, stderr);
+		if (profile_json && boot_profile_append_json(prof, profile_json, hostname) < 0)
+			ret = EXIT_FAILURE;
+	}
+	boot_time_ctx_destroy(ctx);
+	return ret;
 }
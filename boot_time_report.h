@@ -32,8 +32,9 @@
 
 /**
  * \file boot_time_report.h
- * \brief Boot time record parser application for reading, parsing and
- * preparing final unified boot time report.
+ * \brief libboottime: reentrant parser for reading, parsing and preparing
+ * the final unified boot time report. All state lives in a boot_time_ctx_t,
+ * so independent boots can be parsed concurrently on different threads.
  */
 
 #ifndef BOOT_TIME_REPORT_H
@@ -53,6 +54,9 @@
 #include <string.h>
 #include <inttypes.h>
 
+#include "bootstage_source.h"
+#include "boot_clock.h"
+
 /* ========================================================================== */
 /*                           Macros & Typedefs                                */
 /* ========================================================================== */
@@ -61,7 +65,19 @@
 #define BOOTSTAGE_SIZE			0x90000
 #define MCU_BOOTSTAGE_START_OFFSET	0x80000
 #define MCU_BOOTRECORD_OFFSET		0x10
-#define RECORD_COUNT 			256
+/* Remote cores (MCU, R5F, DSP, ...) whose record blocks can be parsed */
+#define BOOT_REMOTE_CORES_MAX		8
+#define BOOT_REMOTE_LABEL_MAX		16
+#if BOOTSTAGE_SOURCE_MAX_VIEWS < 6 + 3 * BOOT_REMOTE_CORES_MAX
+#error "BOOTSTAGE_SOURCE_MAX_VIEWS too small for BOOT_REMOTE_CORES_MAX"
+#endif
+/* Clock sync points accepted per boot */
+#define BOOT_CLOCK_SYNC_MAX		32
+/* Longest initcalls and probes kept by default, see boot_time_set_kernel_calls() */
+#define BOOT_KERNEL_CALLS_DEFAULT	20
+/* Unit of record times, in nanoseconds */
+#define BOOT_TIME_UNIT_NS		1u
+#define BOOT_TIME_NS_PER_US		1000u
 
 /* ========================================================================== */
 /*                           Data Structures                                  */
@@ -81,10 +97,11 @@ struct uboot_bootstage_hdr {
 	uint32_t next_id; // Next bootstage id to be used /
 } __attribute__((packed));
 
+/* 64-bit producer layout ("le64"); bootstage_layout.h decodes the others */
 struct uboot_bootstage_record {
-	uint64_t time_us; // Originally 'ulong time_us' in U-Boot (32-bit) /
+	uint64_t time_us; // 'ulong time_us' in U-Boot, 32-bit on 32-bit builds /
 	uint64_t start_us; // Start time in microseconds /
-	const char *name; // 32-bit pointer to the stage name /
+	const char *name; // Stage name in U-Boot's address space /
 	int flags; // Bootstage flags /
 	int id; // Bootstage id
 } __attribute__((packed));
@@ -112,12 +129,47 @@ typedef struct
     mcu_boot_record_profile_t profiles[0];
 } mcu_boot_stage_record_t;
 
+/**
+ * Units reports are printed in. Records always hold nanoseconds and are
+ * converted only on output.
+ */
+typedef enum {
+	BOOT_UNIT_NS,
+	BOOT_UNIT_US,
+	BOOT_UNIT_MS,
+} boot_time_unit_t;
+
+/**
+ * Read-only column view of a record table. Names are indices into the
+ * context's interned name table, see boot_time_name(). Times are in
+ * nanoseconds since power on.
+ */
 typedef struct {
-	uint64_t start_time;
-	uint64_t delta_time;
-	char name[64];
-} boot_record_t;
+	const uint64_t *start_time;
+	const uint64_t *delta_time;
+	const uint32_t *name;
+	const int32_t *id; /* Bootstage id, or -1 for MCU profiles */
+	const uint64_t *duration; /* Accumulated stage duration, 0 for marks */
+	int count;
+} boot_record_columns_t;
+
+/**
+ * Record block of one remote core in the bootstage region. Profile times
+ * in the block count freq_hz ticks from the bootstage record with
+ * anchor_id, the point at which the A53 released the core, until clock
+ * sync points say otherwise.
+ */
+typedef struct {
+	char label[BOOT_REMOTE_LABEL_MAX]; /* e.g. "MCU", "R5F", "C7x" */
+	size_t offset; /* mcu_boot_stage_record_t block in the region */
+	int anchor_id;
+	uint64_t freq_hz; /* Profile counter frequency, 0 for 1 MHz */
+} boot_remote_core_t;
 
+/**
+ * Boot summary, times in nanoseconds. mcu_start_time and mcu_reccount
+ * describe the first remote core.
+ */
 typedef struct {
 	uint64_t ustart_time;
 	uint64_t mcu_start_time;
@@ -128,116 +180,27 @@ typedef struct {
 	int mcu_reccount;
 } boot_summary_t;
 
-const char* bootstage_id_names[] = {
-    [0] = "START",
-    [1] = "CHECK_MAGIC",
-    [2] = "BOOTSTAGE_ID_CHECK_HEADER",
-    [3] = "BOOTSTAGE_ID_CHECK_CHECKSUM",
-    [4] = "BOOTSTAGE_ID_CHECK_ARCH",
-    [5] = "BOOTSTAGE_ID_CHECK_IMAGETYPE",
-    [6] = "BOOTSTAGE_ID_DECOMP_IMAGE",
-    [7] = "BOOTSTAGE_ID_DECOMP_UNIMPL",
-    [8] = "BOOTSTAGE_ID_CHECK_BOOT_OS",
-    [9] = "BOOTSTAGE_ID_CHECK_RAMDISK",
-    [10] = "BOOTSTAGE_ID_RD_MAGIC",
-    [11] = "BOOTSTAGE_ID_RD_HDR_CHECKSUM",
-    [12] = "BOOTSTAGE_ID_COPY_RAMDISK",
-    [13] = "BOOTSTAGE_ID_RAMDISK",
-    [14] = "BOOTSTAGE_ID_NO_RAMDISK",
-    [15] = "BOOTSTAGE_RUN_OS",
-    [30] = "BOOTSTAGE_ID_NEED_RESET",
-    [31] = "BOOTSTAGE_ID_POST_FAIL",
-    [32] = "BOOTSTAGE_ID_POST_FAIL_R",
-    [33] = "INIT_R",
-    [34] = "BOOTSTAGE_ID_BOARD_GLOBAL_DATA",
-    [35] = "BOOTSTAGE_ID_BOARD_INIT_SEQ",
-    [36] = "BOOTSTAGE_ID_BOARD_FLASH",
-    [37] = "BOOTSTAGE_ID_BOARD_FLASH_37",
-    [38] = "BOOTSTAGE_ID_BOARD_ENV",
-    [39] = "BOOTSTAGE_ID_BOARD_PCI",
-    [40] = "BOOTSTAGE_ID_BOARD_INTERRUPTS",
-    [41] = "BOOTSTAGE_ID_IDE_START",
-    [42] = "BOOTSTAGE_ID_IDE_ADDR",
-    [43] = "BOOTSTAGE_ID_IDE_BOOT_DEVICE",
-    [44] = "BOOTSTAGE_ID_IDE_TYPE",
-    [45] = "BOOTSTAGE_ID_IDE_PART",
-    [46] = "BOOTSTAGE_ID_IDE_PART_INFO",
-    [47] = "BOOTSTAGE_ID_IDE_PART_TYPE",
-    [48] = "BOOTSTAGE_ID_IDE_PART_READ",
-    [49] = "BOOTSTAGE_ID_IDE_FORMAT",
-    [50] = "BOOTSTAGE_ID_IDE_CHECKSUM",
-    [51] = "BOOTSTAGE_ID_IDE_READ",
-    [52] = "BOOTSTAGE_ID_NAND_PART",
-    [53] = "BOOTSTAGE_ID_NAND_SUFFIX",
-    [54] = "BOOTSTAGE_ID_NAND_BOOT_DEVICE",
-    [55] = "BOOTSTAGE_ID_NAND_AVAILABLE",
-    [57] = "BOOTSTAGE_ID_NAND_TYPE",
-    [58] = "BOOTSTAGE_ID_NAND_READ",
-    [60] = "BOOTSTAGE_ID_NET_CHECKSUM",
-    [64] = "BOOTSTAGE_NET_ETH_START",
-    [65] = "BOOTSTAGE_NET_ETH_INIT",
-    [80] = "BOOTSTAGE_ID_NET_START",
-    [81] = "BOOTSTAGE_ID_NET_NETLOOP_OK",
-    [82] = "BOOTSTAGE_ID_NET_LOADED",
-    [83] = "BOOTSTAGE_ID_NET_DONE_ERR",
-    [84] = "BOOTSTAGE_ID_NET_DONE",
-    [90] = "BOOTSTAGE_ID_FIT_FDT_START",
-    [100] = "BOOTSTAGE_ID_FIT_KERNEL_START",
-    [110] = "BOOTSTAGE_ID_FIT_CONFIG",
-    [111] = "BOOTSTAGE_ID_FIT_TYPE",
-    [112] = "BOOTSTAGE_ID_FIT_COMPRESSION",
-    [113] = "BOOTSTAGE_ID_FIT_OS",
-    [114] = "BOOTSTAGE_ID_FIT_LOADADDR",
-    [115] = "BOOTSTAGE_ID_OVERWRITTEN",
-    [120] = "BOOTSTAGE_ID_FIT_RD_START",
-    [130] = "BOOTSTAGE_ID_FIT_SETUP_START",
-    [140] = "BOOTSTAGE_ID_IDE_FIT_READ",
-    [141] = "BOOTSTAGE_ID_IDE_FIT_READ_OK",
-    [150] = "BOOTSTAGE_ID_NAND_FIT_READ",
-    [151] = "BOOTSTAGE_ID_NAND_FIT_READ_OK",
-    [160] = "BOOTSTAGE_ID_FIT_LOADABLE_START",
-    [170] = "BOOTSTAGE_ID_FIT_SPL_START",
-    [171] = "BOOTSTAGE_AWAKE",
-    [172] = "BOOTSTAGE_ID_START_TPL",
-    [173] = "BOOTSTAGE_ID_END_TPL",
-    [174] = "BOOTSTAGE_ID_START_SPL",
-    [175] = "BOOTSTAGE_ID_END_SPL",
-    [176] = "BOOTSTAGE_START_MCU",
-    [177] = "BOOTSTAGE_ID_END_VPL",
-    [178] = "BOOTSTAGE_START_UBOOT_F",
-    [179] = "BOOTSTAGE_START_UBOOT_R",
-    [180] = "BOOTSTAGE_USB_START",
-    [181] = "BOOTSTAGE_ETH_START",
-    [182] = "BOOTSTAGE_ID_BOOTP_START",
-    [183] = "BOOTSTAGE_ID_BOOTP_STOP",
-    [184] = "BOOTSTAGE_BOOTM_START",
-    [185] = "BOOTSTAGE_BOOTM_HANDOFF",
-    [186] = "BOOTSTAGE_MAIN_LOOP",
-    [187] = "BOOTSTAGE_ENTER_CLI_LOOP",
-    [188] = "BOOTSTAGE_KERNELREAD_START",
-    [189] = "BOOTSTAGE_KERNELREAD_STOP",
-    [190] = "BOOTSTAGE_ID_BOARD_INIT",
-    [191] = "BOOTSTAGE_ID_BOARD_INIT_DONE",
-    [192] = "BOOTSTAGE_ID_CPU_AWAKE",
-    [193] = "BOOTSTAGE_ID_MAIN_CPU_AWAKE",
-    [194] = "BOOTSTAGE_ID_MAIN_CPU_READY",
-    [195] = "BOOTSTAGE_ID_ACCUM_LCD",
-    [196] = "BOOTSTAGE_ID_ACCUM_SCSI",
-    [197] = "BOOTSTAGE_ID_ACCUM_SPI",
-    [198] = "BOOTSTAGE_ID_ACCUM_DECOMP",
-    [199] = "BOOTSTAGE_ID_ACCUM_OF_LIVE",
-    [200] = "BOOTSTAGE_ID_FPGA_INIT",
-    [201] = "BOOTSTAGE_ID_ACCUM_DM_SPL",
-    [202] = "BOOTSTAGE_ACCUM_DM_F",
-    [203] = "BOOTSTAGE_ACCUM_DM_R",
-    [204] = "BOOTSTAGE_ID_ACCUM_FSP_M",
-    [205] = "BOOTSTAGE_ID_ACCUM_FSP_S",
-    [206] = "BOOTSTAGE_ID_ACCUM_MMAP_SPI",
-    [207] = "BOOTSTAGE_ID_USER",
-    [208] = "BOOTSTAGE_ID_ALLOC",
-    [300] = "BOOTSTAGE_KERNEL_START",
-    [301] = "BOOTSTAGE_KERNEL_END",
-};
+/**
+ * One initcall or driver probe timed by an initcall_debug kernel. Times are
+ * in nanoseconds since power on; start_time is 0 if the log line had no
+ * printk time stamp.
+ */
+typedef struct {
+	uint32_t name; /* Function or device, see boot_time_name() */
+	int probe; /* 1 for a driver probe, 0 for an initcall */
+	int ret; /* Return value, -517 (-EPROBE_DEFER) for a deferred probe */
+	uint64_t start_time;
+	uint64_t duration;
+} boot_kernel_call_t;
+
+/**
+ * Work done by a context since it was created, see boot_time_io_stats().
+ */
+typedef struct {
+	uint64_t bytes_read; /* Region, log and milestone bytes read */
+	uint64_t lines; /* Tracker, marker, initcall and milestone lines decoded */
+	uint64_t records; /* Boot, remote core and kernel call records held */
+} boot_time_io_stats_t;
 
 enum boot_markers {
 	BOOTSTAGE_START_UBOOT = 178,
@@ -245,15 +208,86 @@ enum boot_markers {
 	BOOTSTAGE_BOOTM_HANDOFF = 185,
 	BOOTSTAGE_KERNEL_START = 300,
 	BOOTSTAGE_KERNEL_END,
+	BOOTSTAGE_USER_MILESTONE, /* boot_time_mark() from user space */
+	BOOTSTAGE_LOG_MARKER, /* Kernel log line matched by a marker config */
 };
 
+/**
+ * Opaque parser context holding the records and summary of one boot.
+ */
+typedef struct boot_time_ctx boot_time_ctx_t;
+
+/*
+ * Offsets of the kernel record area for boot_time_set_kernel_region(): right
+ * after the U-Boot records (the default), or none
+ */
+#define BOOT_KERNEL_REGION_AFTER	0
+#define BOOT_KERNEL_REGION_NONE		SIZE_MAX
+/* Records read from the kernel record area */
+#define BOOT_KERNEL_REGION_MAX		64
+
+/* Empty index path passed to boot_time_set_log_index() to disable indexing */
+#define BOOT_TIME_LOG_INDEX_NONE	""
+
 /* ========================================================================== */
 /*                          Function Declarations                             */
 /* ========================================================================== */
 
-boot_record_t boot_records[RECORD_COUNT];
-boot_record_t mcu_boot_records[RECORD_COUNT];
-boot_summary_t boot_summary;
-uint64_t prev_time = 0;
+const char* get_bootstage_id_name(int id);
+
+boot_time_ctx_t *boot_time_ctx_create(void);
+void boot_time_ctx_destroy(boot_time_ctx_t *ctx);
+void boot_time_set_jobs(boot_time_ctx_t *ctx, int nthreads);
+void boot_time_set_boot(boot_time_ctx_t *ctx, int boot);
+void boot_time_set_log_index(boot_time_ctx_t *ctx, const char *index_path);
+void boot_time_set_unit(boot_time_ctx_t *ctx, boot_time_unit_t unit);
+boot_time_unit_t boot_time_unit(const boot_time_ctx_t *ctx);
+int boot_time_set_remote_cores(boot_time_ctx_t *ctx, const boot_remote_core_t *cores,
+		int count);
+int boot_time_parse_remote_core(const char *spec, boot_remote_core_t *core);
+void boot_time_set_kernel_epoch(boot_time_ctx_t *ctx, double epoch_ns);
+void boot_time_set_kernel_calls(boot_time_ctx_t *ctx, int top);
+int boot_time_set_markers(boot_time_ctx_t *ctx, const char *path);
+int boot_time_set_bootstage_layout(boot_time_ctx_t *ctx, const char *name);
+void boot_time_set_kernel_region(boot_time_ctx_t *ctx, size_t offset);
+int boot_time_add_clock_sync(boot_time_ctx_t *ctx, const char *core,
+		const char *stage, const char *ref_stage);
+int boot_time_sync_clocks(boot_time_ctx_t *ctx);
+
+int boot_time_read_bootstage(boot_time_ctx_t *ctx, bootstage_source_t *src);
+int boot_time_read_bootstage_mem(boot_time_ctx_t *ctx);
+int boot_time_read_bootstage_file(boot_time_ctx_t *ctx, const char *filename);
+int boot_time_read_bootstage_buffer(boot_time_ctx_t *ctx, const void *buf, size_t len);
+int boot_time_read_kernel_log(boot_time_ctx_t *ctx, const char *filename);
+int boot_time_read_kmsg(boot_time_ctx_t *ctx, const char *path);
+int boot_time_read_milestones(boot_time_ctx_t *ctx, const char *path);
+int boot_time_read_archive(boot_time_ctx_t *ctx, const char *path, int boot);
+int boot_time_read_capture(boot_time_ctx_t *ctx, const char *path);
+
+const boot_summary_t *boot_time_summary(const boot_time_ctx_t *ctx);
+void boot_time_records(const boot_time_ctx_t *ctx, boot_record_columns_t *out);
+void boot_time_mcu_records(const boot_time_ctx_t *ctx, boot_record_columns_t *out);
+int boot_time_remote_core_count(const boot_time_ctx_t *ctx);
+const boot_remote_core_t *boot_time_remote_core(const boot_time_ctx_t *ctx, int core);
+void boot_time_remote_records(const boot_time_ctx_t *ctx, int core,
+		boot_record_columns_t *out);
+const char *boot_time_name(const boot_time_ctx_t *ctx, uint32_t idx);
+const boot_kernel_call_t *boot_time_kernel_calls(const boot_time_ctx_t *ctx, int *count,
+		uint64_t *seen);
+
+void boot_time_io_stats(const boot_time_ctx_t *ctx, boot_time_io_stats_t *out);
+
+int boot_time_parse_unit(const char *s, boot_time_unit_t *unit);
+int boot_time_parse_duration(const char *s, uint64_t *ns);
+const char *boot_time_unit_name(boot_time_unit_t unit);
+uint64_t boot_time_unit_ns(boot_time_unit_t unit);
+uint64_t boot_time_to_unit(uint64_t ns, boot_time_unit_t unit);
+void boot_time_print_report(const boot_time_ctx_t *ctx, FILE *fp, const char *hostname);
+void boot_time_print_clocks(const boot_time_ctx_t *ctx, FILE *fp);
+void boot_time_print_kernel_calls(const boot_time_ctx_t *ctx, FILE *fp);
+int boot_time_export_html(const boot_time_ctx_t *ctx, const char *filename,
+		const char *hostname);
+int boot_time_export_trace(const boot_time_ctx_t *ctx, const char *filename,
+		const char *hostname);
 
 #endif /* BOOT_TIME_REPORT_H */
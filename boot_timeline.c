@@ -0,0 +1,245 @@
+/*
+ *  Copyright (C) 2025 Texas Instruments Incorporated
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions
+ *  are met:
+ *
+ *    Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *
+ *    Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the
+ *    distribution.
+ *
+ *    Neither the name of Texas Instruments Incorporated nor the names of
+ *    its contributors may be used to endorse or promote products derived
+ *    from this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ *  "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ *  LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ *  A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ *  OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ *  SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ *  LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ *  DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ *  THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ *  (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ *  OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/**
+ * \file boot_timeline.c
+ * \brief K-way merge of the per-core record lanes into one timeline.
+ *
+ * Each lane is already close to time order (only accumulated U-Boot
+ * stages, which carry their start time, step back), so a lane is put in
+ * order with an insertion sort over record indices, which is linear on
+ * nearly sorted input. The lanes are then merged through a binary min-heap
+ * of lane heads keyed by (time, lane), giving O(n log k) for n records on
+ * k cores with ties broken in favour of the A53.
+ */
+
+/* ========================================================================== */
+/*                           Include Files                                    */
+/* ========================================================================== */
+
+#include <stdlib.h>
+#include <string.h>
+#include <inttypes.h>
+
+#include "boot_timeline.h"
+
+/* ========================================================================== */
+/*                           Macros & Typedefs                                */
+/* ========================================================================== */
+
+typedef struct {
+	uint64_t time;
+	uint32_t lane;
+} lane_head_t;
+
+
+/* ========================================================================== */
+/*                          Function Definitions                              */
+/* ========================================================================== */
+
+/**
+ * @brief Returns the number of lanes: the A53 and every remote core.
+ */
+int boot_time_lane_count(const boot_time_ctx_t *ctx)
+{
+	return 1 + boot_time_remote_core_count(ctx);
+}
+
+/**
+ * @brief Returns the display name of a lane.
+ */
+const char *boot_time_lane_name(const boot_time_ctx_t *ctx, int lane)
+{
+	const boot_remote_core_t *rc;
+
+	if (lane == BOOT_LANE_A53)
+		return "A53";
+	rc = boot_time_remote_core(ctx, lane - 1);
+	return rc ? rc->label : "";
+}
+
+/**
+ * @brief Returns the record columns of a lane.
+ */
+void boot_time_lane_records(const boot_time_ctx_t *ctx, int lane,
+		boot_record_columns_t *out)
+{
+	if (lane == BOOT_LANE_A53)
+		boot_time_records(ctx, out);
+	else
+		boot_time_remote_records(ctx, lane - 1, out);
+}
+
+static int head_less(const lane_head_t *a, const lane_head_t *b)
+{
+	return a->time < b->time || (a->time == b->time && a->lane < b->lane);
+}
+
+static void sift_down(lane_head_t *heap, int n, int i)
+{
+	for (;;) {
+		int l = 2 * i + 1, m = i;
+		lane_head_t t;
+
+		if (l < n && head_less(&heap[l], &heap[m]))
+			m = l;
+		if (l + 1 < n && head_less(&heap[l + 1], &heap[m]))
+			m = l + 1;
+		if (m == i)
+			return;
+		t = heap[i];
+		heap[i] = heap[m];
+		heap[m] = t;
+		i = m;
+	}
+}
+
+/* Stable insertion sort of idx[0..n) by start time */
+static void sort_lane(const uint64_t *start, uint32_t *idx, uint32_t n)
+{
+	for (uint32_t i = 0; i < n; i++) {
+		uint32_t v = idx[i] = i, j = i;
+
+		while (j > 0 && start[idx[j - 1]] > start[v]) {
+			idx[j] = idx[j - 1];
+			j--;
+		}
+		idx[j] = v;
+	}
+}
+
+/**
+ * @brief Merges the records of every lane into one time ordered timeline.
+ *
+ * Records with equal times keep their lane order, A53 first, and their
+ * order within a lane.
+ *
+ * @param ctx Parsed boot.
+ * @param tl Receives the timeline; release with boot_timeline_free().
+ * @return int 0 on success, -1 on allocation failure.
+ */
+int boot_time_timeline(const boot_time_ctx_t *ctx, boot_timeline_t *tl)
+{
+	int nlanes = boot_time_lane_count(ctx);
+	boot_record_columns_t cols[BOOT_LANES_MAX];
+	uint32_t *order[BOOT_LANES_MAX] = { 0 };
+	uint32_t pos[BOOT_LANES_MAX] = { 0 };
+	lane_head_t heap[BOOT_LANES_MAX];
+	size_t total = 0;
+	int nheap = 0, ret = -1;
+
+	memset(tl, 0, sizeof(*tl));
+	for (int l = 0; l < nlanes; l++) {
+		boot_time_lane_records(ctx, l, &cols[l]);
+		total += cols[l].count;
+		order[l] = malloc((cols[l].count ? cols[l].count : 1) * sizeof(uint32_t));
+		if (!order[l])
+			goto out;
+		sort_lane(cols[l].start_time, order[l], cols[l].count);
+		if (cols[l].count) {
+			heap[nheap].time = cols[l].start_time[order[l][0]];
+			heap[nheap++].lane = l;
+		}
+	}
+	tl->entries = malloc((total ? total : 1) * sizeof(*tl->entries));
+	if (!tl->entries)
+		goto out;
+	for (int i = nheap / 2 - 1; i >= 0; i--)
+		sift_down(heap, nheap, i);
+
+	while (nheap) {
+		uint32_t l = heap[0].lane;
+
+		tl->entries[tl->count].lane = l;
+		tl->entries[tl->count++].index = order[l][pos[l]++];
+		if (pos[l] < (uint32_t)cols[l].count)
+			heap[0].time = cols[l].start_time[order[l][pos[l]]];
+		else
+			heap[0] = heap[--nheap];
+		sift_down(heap, nheap, 0);
+	}
+	ret = 0;
+out:
+	for (int l = 0; l < nlanes; l++)
+		free(order[l]);
+	if (ret < 0) {
+		fprintf(stderr, "Out of memory merging boot timeline\n");
+		boot_timeline_free(tl);
+	}
+	return ret;
+}
+
+/**
+ * @brief Releases a timeline.
+ */
+void boot_timeline_free(boot_timeline_t *tl)
+{
+	free(tl->entries);
+	memset(tl, 0, sizeof(*tl));
+}
+
+/**
+ * @brief Prints every record of every core in time order.
+ *
+ * The delta is to the previous record on the same core.
+ *
+ * @param ctx Parsed boot.
+ * @param fp Output stream.
+ */
+void boot_time_print_timeline(const boot_time_ctx_t *ctx, FILE *fp)
+{
+	boot_record_columns_t cols[BOOT_LANES_MAX];
+	boot_time_unit_t unit = boot_time_unit(ctx);
+	const char *un = boot_time_unit_name(unit);
+	boot_timeline_t tl;
+
+	if (boot_time_timeline(ctx, &tl) < 0)
+		return;
+	for (int l = 0; l < boot_time_lane_count(ctx); l++)
+		boot_time_lane_records(ctx, l, &cols[l]);
+
+	fprintf(fp, "--------------------------------------------------------------------\n");
+	fprintf(fp, "                 Unified Boot Timeline\n");
+	fprintf(fp, "--------------------------------------------------------------------\n");
+	for (size_t i = 0; i < tl.count; i++) {
+		const boot_record_columns_t *c = &cols[tl.entries[i].lane];
+		uint32_t k = tl.entries[i].index;
+
+		fprintf(fp, "%-6s %-30s = %6" PRIu64 " %s (+%3" PRIu64 " %s)\n",
+				boot_time_lane_name(ctx, tl.entries[i].lane),
+				boot_time_name(ctx, c->name[k]),
+				boot_time_to_unit(c->start_time[k], unit), un,
+				boot_time_to_unit(c->delta_time[k], unit), un);
+	}
+	fprintf(fp, "--------------------------------------------------------------------\n");
+	boot_timeline_free(&tl);
+}
@@ -0,0 +1,85 @@
+/*
+ *  Copyright (C) 2025 Texas Instruments Incorporated
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions
+ *  are met:
+ *
+ *    Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *
+ *    Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the
+ *    distribution.
+ *
+ *    Neither the name of Texas Instruments Incorporated nor the names of
+ *    its contributors may be used to endorse or promote products derived
+ *    from this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ *  "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ *  LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ *  A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ *  OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ *  SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ *  LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ *  DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ *  THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ *  (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ *  OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/**
+ * \file boot_timeline.h
+ * \brief Unified, time ordered timeline of a boot: the A53 records and
+ * every remote core's records merged into one sequence of lane references.
+ */
+
+#ifndef BOOT_TIMELINE_H
+#define BOOT_TIMELINE_H
+
+/* ========================================================================== */
+/*                           Include Files                                    */
+/* ========================================================================== */
+#include <stdio.h>
+#include <stdint.h>
+#include <stddef.h>
+
+#include "boot_time_report.h"
+
+/* ========================================================================== */
+/*                           Macros & Typedefs                                */
+/* ========================================================================== */
+
+/* Lane of the bootloader and kernel records; remote core n is lane n + 1 */
+#define BOOT_LANE_A53		0
+#define BOOT_LANES_MAX		(1 + BOOT_REMOTE_CORES_MAX)
+
+/* ========================================================================== */
+/*                           Data Structures                                  */
+/* ========================================================================== */
+
+typedef struct {
+	uint32_t lane;
+	uint32_t index; /* Record index within the lane's columns */
+} boot_timeline_entry_t;
+
+typedef struct {
+	boot_timeline_entry_t *entries;
+	size_t count;
+} boot_timeline_t;
+
+/* ========================================================================== */
+/*                          Function Declarations                             */
+/* ========================================================================== */
+
+int boot_time_lane_count(const boot_time_ctx_t *ctx);
+const char *boot_time_lane_name(const boot_time_ctx_t *ctx, int lane);
+void boot_time_lane_records(const boot_time_ctx_t *ctx, int lane,
+		boot_record_columns_t *out);
+int boot_time_timeline(const boot_time_ctx_t *ctx, boot_timeline_t *tl);
+void boot_timeline_free(boot_timeline_t *tl);
+void boot_time_print_timeline(const boot_time_ctx_t *ctx, FILE *fp);
+
+#endif /* BOOT_TIMELINE_H */
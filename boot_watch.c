@@ -0,0 +1,290 @@
+/*
+ *  Copyright (C) 2025 Texas Instruments Incorporated
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions
+ *  are met:
+ *
+ *    Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *
+ *    Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the
+ *    distribution.
+ *
+ *    Neither the name of Texas Instruments Incorporated nor the names of
+ *    its contributors may be used to endorse or promote products derived
+ *    from this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ *  "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ *  LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ *  A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ *  OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ *  SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ *  LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ *  DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ *  THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ *  (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ *  OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/**
+ * \file boot_watch.c
+ * \brief Live polling of the remote core record blocks.
+ *
+ * The firmware shares no lock with Linux: it writes a profile and bumps
+ * record_count. The block header is used as the sequence of a seqlock
+ * read. A copy is kept only when record_id, start_time and record_count
+ * read the same before and after it, and only profiles that read the same
+ * twice are kept, since a profile still being written changes between the
+ * two reads. Each poll reads one header per core, so watching costs next
+ * to no CPU between records.
+ */
+
+/* ========================================================================== */
+/*                           Include Files                                    */
+/* ========================================================================== */
+
+#include <time.h>
+
+#include "boot_watch.h"
+#include "boot_time_internal.h"
+
+/* ========================================================================== */
+/*                           Macros & Typedefs                                */
+/* ========================================================================== */
+
+/* Profiles copied per read of a block */
+#define WATCH_BATCH	64
+
+/* ========================================================================== */
+/*                           Data Structures                                  */
+/* ========================================================================== */
+
+typedef struct {
+	const mcu_boot_stage_record_t *blk;
+	uint32_t cap; /* Profiles the mapping covers */
+	uint32_t seen; /* Profiles already in the context */
+	mcu_boot_stage_record_t gen; /* Header the seen profiles belong to */
+	int active;
+} watch_core_t;
+
+/* ========================================================================== */
+/*                          Function Definitions                              */
+/* ========================================================================== */
+
+static void load_header(const mcu_boot_stage_record_t *blk, mcu_boot_stage_record_t *hdr)
+{
+	hdr->record_count = __atomic_load_n(&blk->record_count, __ATOMIC_ACQUIRE);
+	hdr->record_id = __atomic_load_n(&blk->record_id, __ATOMIC_RELAXED);
+	hdr->start_time = __atomic_load_n(&blk->start_time, __ATOMIC_RELAXED);
+}
+
+/**
+ * @brief Copies profiles of a remote core block that may still be written.
+ *
+ * Profiles are copied from first on until record_count, max or the first
+ * profile that is not complete yet: an empty name is one the firmware
+ * counted before writing it.
+ *
+ * @param blk Mapped record block.
+ * @param cap Number of profiles the mapping covers.
+ * @param first First profile to copy.
+ * @param hdr Receives the block header the copy is consistent with.
+ * @param out Receives the profiles.
+ * @param max Capacity of out.
+ * @return int Number of profiles copied, or -1 if the header changed
+ * during the copy and it has to be retried.
+ */
+int boot_watch_read_block(const mcu_boot_stage_record_t *blk, uint32_t cap,
+		uint32_t first, mcu_boot_stage_record_t *hdr,
+		mcu_boot_record_profile_t *out, uint32_t max)
+{
+	mcu_boot_stage_record_t after;
+	mcu_boot_record_profile_t again;
+	uint32_t count, n = 0;
+
+	load_header(blk, hdr);
+	count = (hdr->record_count < cap) ? hdr->record_count : cap;
+	while (first + n < count && n < max) {
+		const mcu_boot_record_profile_t *p = &blk->profiles[first + n];
+
+		memcpy(&out[n], p, sizeof(*p));
+		__atomic_thread_fence(__ATOMIC_ACQUIRE);
+		memcpy(&again, p, sizeof(*p));
+		if (out[n].name[0] == '\0' || memcmp(&out[n], &again, sizeof(again)) != 0)
+			break;
+		n++;
+	}
+	__atomic_thread_fence(__ATOMIC_ACQUIRE);
+	load_header(blk, &after);
+	if (after.record_id != hdr->record_id || after.start_time != hdr->start_time ||
+			after.record_count < hdr->record_count)
+		return -1;
+	return n;
+}
+
+/* Profiles that fit between a core's block and the next block or region end */
+static uint32_t block_capacity(const boot_time_ctx_t *ctx, int core, size_t region_size)
+{
+	size_t start = ctx->remote_cores[core].offset + MCU_BOOTRECORD_OFFSET;
+	size_t end = region_size;
+
+	for (int c = 0; c < ctx->remote_count; c++) {
+		size_t off = ctx->remote_cores[c].offset;
+		if (off > ctx->remote_cores[core].offset && off < end)
+			end = off;
+	}
+	return (end > start) ? (end - start) / sizeof(mcu_boot_record_profile_t) : 0;
+}
+
+static uint64_t elapsed_ns(const struct timespec *t0)
+{
+	struct timespec now;
+
+	clock_gettime(CLOCK_MONOTONIC, &now);
+	return (uint64_t)(now.tv_sec - t0->tv_sec) * 1000000000ull +
+		(uint64_t)now.tv_nsec - (uint64_t)t0->tv_nsec;
+}
+
+/* Returns 1 if the stage name, recorded on core, is the final stage */
+static int is_final_stage(const boot_time_ctx_t *ctx, int core, const char *name,
+		const boot_watch_opts_t *opts)
+{
+	return opts->until_stage && strcmp(name, opts->until_stage) == 0 &&
+		(!opts->until_core || strcmp(ctx->remote_cores[core].label, opts->until_core) == 0);
+}
+
+/* Returns 1 if the final stage was already recorded when the region was read */
+static int final_stage_read(const boot_time_ctx_t *ctx, const boot_watch_opts_t *opts)
+{
+	for (int c = 0; c < ctx->remote_count; c++) {
+		const record_table_t *tab = &ctx->remote_records[c];
+
+		for (uint32_t i = 0; i < tab->count; i++)
+			if (is_final_stage(ctx, c, boot_time_name(ctx, tab->name[i]), opts))
+				return 1;
+	}
+	return 0;
+}
+
+/*
+ * Adds the profiles that appeared in one core's block since the last poll
+ * and prints them. Returns 1 once the final stage was seen.
+ */
+static int poll_core(boot_time_ctx_t *ctx, int core, watch_core_t *w,
+		const boot_watch_opts_t *opts, FILE *out)
+{
+	const char *label = ctx->remote_cores[core].label;
+	const char *un = boot_time_unit_name(ctx->unit);
+	mcu_boot_record_profile_t batch[WATCH_BATCH];
+	mcu_boot_stage_record_t hdr;
+	int n, done = 0;
+
+	do {
+		n = -1;
+		for (int r = 0; r < BOOT_WATCH_RETRIES && n < 0; r++)
+			n = boot_watch_read_block(w->blk, w->cap, w->seen, &hdr, batch, WATCH_BATCH);
+		if (n < 0)
+			return 0; /* Busy firmware, next poll */
+		if (hdr.record_id != w->gen.record_id || hdr.start_time != w->gen.start_time ||
+				hdr.record_count < w->seen) {
+			fprintf(stderr, "%s record block was reset, no longer watched\n", label);
+			w->active = 0;
+			return 0;
+		}
+		for (int i = 0; i < n; i++) {
+			const record_table_t *tab = &ctx->remote_records[core];
+			const char *name;
+			int idx;
+
+			idx = boot_time_add_remote_profile(ctx, core, batch[i].name,
+					strnlen(batch[i].name, sizeof(batch[i].name)), batch[i].time);
+			if (idx < 0)
+				return -1;
+			name = boot_time_name(ctx, tab->name[idx]);
+			fprintf(out, "%-8s %-32s %8" PRIu64 " %s\n", label, name,
+					boot_time_to_unit(tab->start_time[idx], ctx->unit), un);
+			if (is_final_stage(ctx, core, name, opts))
+				done = 1;
+		}
+		w->seen += n;
+		fflush(out);
+	} while (n == WATCH_BATCH && !done);
+	return done;
+}
+
+/**
+ * @brief Streams the remote core records that appear after the region was
+ * read.
+ *
+ * Call after boot_time_read_bootstage() on the same source, and after
+ * boot_time_sync_clocks() so the new records get the fitted clocks. Each
+ * new record is added to the context and printed as it is seen. A block
+ * whose header changes (the core was restarted) stops being watched. If
+ * the final stage is already among the records read with the region,
+ * nothing is watched.
+ *
+ * @param ctx Parser context.
+ * @param src Region source the context was read from.
+ * @param opts Final stage, timeout and poll period.
+ * @param out Stream for the new records.
+ * @return int 0 when the final stage was seen, 1 on timeout, -1 on error.
+ */
+int boot_time_watch(boot_time_ctx_t *ctx, bootstage_source_t *src,
+		const boot_watch_opts_t *opts, FILE *out)
+{
+	watch_core_t cores[BOOT_REMOTE_CORES_MAX];
+	struct timespec t0, interval;
+	int nactive = 0;
+	size_t len;
+
+	if (final_stage_read(ctx, opts))
+		return 0;
+	for (int c = 0; c < ctx->remote_count; c++) {
+		watch_core_t *w = &cores[c];
+
+		memset(w, 0, sizeof(*w));
+		if (!ctx->remote_ticks[c])
+			continue; /* Block missing from the region */
+		w->cap = block_capacity(ctx, c, src->size);
+		len = MCU_BOOTRECORD_OFFSET + (size_t)w->cap * sizeof(mcu_boot_record_profile_t);
+		if (!bootstage_source_has(src, ctx->remote_cores[c].offset, len))
+			continue;
+		w->blk = bootstage_source_map(src, ctx->remote_cores[c].offset, len);
+		if (!w->blk)
+			return -1;
+		load_header(w->blk, &w->gen);
+		w->seen = ctx->remote_records[c].count - 1; /* Less <label>_AWAKE */
+		w->active = 1;
+		nactive++;
+	}
+	if (nactive == 0) {
+		fprintf(stderr, "No remote core record block to watch\n");
+		return -1;
+	}
+
+	interval.tv_sec = opts->interval_ns / 1000000000ull;
+	interval.tv_nsec = opts->interval_ns % 1000000000ull;
+	clock_gettime(CLOCK_MONOTONIC, &t0);
+	for (;;) {
+		nactive = 0;
+		for (int c = 0; c < ctx->remote_count; c++) {
+			int ret;
+
+			if (!cores[c].active)
+				continue;
+			ret = poll_core(ctx, c, &cores[c], opts, out);
+			if (ret != 0)
+				return (ret > 0) ? 0 : -1;
+			nactive += cores[c].active;
+		}
+		if (nactive == 0)
+			return 1;
+		if (opts->timeout_ns && elapsed_ns(&t0) >= opts->timeout_ns)
+			return 1;
+		clock_nanosleep(CLOCK_MONOTONIC, 0, &interval, NULL);
+	}
+}
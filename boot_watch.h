@@ -0,0 +1,84 @@
+/*
+ *  Copyright (C) 2025 Texas Instruments Incorporated
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions
+ *  are met:
+ *
+ *    Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *
+ *    Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the
+ *    distribution.
+ *
+ *    Neither the name of Texas Instruments Incorporated nor the names of
+ *    its contributors may be used to endorse or promote products derived
+ *    from this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ *  "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ *  LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ *  A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ *  OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ *  SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ *  LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ *  DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ *  THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ *  (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ *  OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/**
+ * \file boot_watch.h
+ * \brief Live polling of the remote core record blocks. Remote firmware
+ * keeps appending profiles after Linux is up (e.g. IPC_SYNC_ALL after
+ * BOOTSTAGE_KERNEL_END), so the watcher follows each block's record_count
+ * and streams the new records as they appear.
+ */
+
+#ifndef BOOT_WATCH_H
+#define BOOT_WATCH_H
+
+/* ========================================================================== */
+/*                           Include Files                                    */
+/* ========================================================================== */
+#include "boot_time_report.h"
+
+/* ========================================================================== */
+/*                           Macros & Typedefs                                */
+/* ========================================================================== */
+
+/* Defaults of boot_watch_opts_t, in nanoseconds */
+#define BOOT_WATCH_INTERVAL_DEFAULT	10000000ull /* 10 ms */
+#define BOOT_WATCH_TIMEOUT_DEFAULT	60000000000ull /* 60 s */
+
+/* Retries of a copy that raced with the firmware before giving up a poll */
+#define BOOT_WATCH_RETRIES		8
+
+/* ========================================================================== */
+/*                           Data Structures                                  */
+/* ========================================================================== */
+
+/**
+ * When and how long to watch.
+ */
+typedef struct {
+	const char *until_core; /* Core of the final stage, NULL for any core */
+	const char *until_stage; /* Final stage, NULL to watch until the timeout */
+	uint64_t timeout_ns; /* 0: no timeout, only valid with until_stage */
+	uint64_t interval_ns; /* Poll period */
+} boot_watch_opts_t;
+
+/* ========================================================================== */
+/*                          Function Declarations                             */
+/* ========================================================================== */
+
+int boot_watch_read_block(const mcu_boot_stage_record_t *blk, uint32_t cap,
+		uint32_t first, mcu_boot_stage_record_t *hdr,
+		mcu_boot_record_profile_t *out, uint32_t max);
+int boot_time_watch(boot_time_ctx_t *ctx, bootstage_source_t *src,
+		const boot_watch_opts_t *opts, FILE *out);
+
+#endif /* BOOT_WATCH_H */
@@ -0,0 +1,269 @@
+/*
+ *  Copyright (C) 2025 Texas Instruments Incorporated
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions
+ *  are met:
+ *
+ *    Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *
+ *    Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the
+ *    distribution.
+ *
+ *    Neither the name of Texas Instruments Incorporated nor the names of
+ *    its contributors may be used to endorse or promote products derived
+ *    from this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ *  "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ *  LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ *  A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ *  OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ *  SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ *  LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ *  DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ *  THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ *  (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ *  OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/**
+ * \file bootstage_layout.c
+ * \brief Bootstage record decoders, one per producer layout.
+ *
+ * U-Boot stashes its struct bootstage_record as laid out by its own
+ * compiler, so the record stride, field widths and byte order follow the
+ * SPL/U-Boot build rather than this parser's. Each layout gets its own
+ * decoder, generated with constant offsets and widths so the loop compiles
+ * to plain loads (and byte swaps for the foreign byte order).
+ */
+
+/* ========================================================================== */
+/*                           Include Files                                    */
+/* ========================================================================== */
+
+#include <string.h>
+
+#include "bootstage_layout.h"
+#include "boot_time_report.h"
+
+/* ========================================================================== */
+/*                           Macros & Typedefs                                */
+/* ========================================================================== */
+
+/* A decoded record is taken as plausible within these bounds */
+#define LAYOUT_ID_MAX		4096
+#define LAYOUT_FLAGS_MAX	0x100
+#define LAYOUT_TIME_US_MAX	10000000000ull /* ~2.8 hours */
+
+#if defined(__BYTE_ORDER__) && __BYTE_ORDER__ == __ORDER_BIG_ENDIAN__
+#define HOST_BIG_ENDIAN	1
+#else
+#define HOST_BIG_ENDIAN	0
+#endif
+
+/* ========================================================================== */
+/*                          Function Definitions                              */
+/* ========================================================================== */
+
+static inline __attribute__((always_inline)) uint64_t load(const uint8_t *p,
+		int size, int be)
+{
+	if (size == 8) {
+		uint64_t v;
+
+		memcpy(&v, p, 8);
+		return (be != HOST_BIG_ENDIAN) ? __builtin_bswap64(v) : v;
+	} else {
+		uint32_t v;
+
+		memcpy(&v, p, 4);
+		return (be != HOST_BIG_ENDIAN) ? __builtin_bswap32(v) : v;
+	}
+}
+
+static uint32_t load32(const uint8_t *p, int be)
+{
+	return be ? load(p, 4, 1) : load(p, 4, 0);
+}
+
+/*
+ * Every argument but src, count and out is a constant at each call site
+ * below, so the size and byte order tests fold away.
+ */
+static inline __attribute__((always_inline)) void decode_records(const uint8_t *src,
+		uint32_t count, bootstage_rec_t *out, int be, int tsize, int ssize,
+		int soff, int foff, int ioff, int stride)
+{
+	for (uint32_t i = 0; i < count; i++, src += stride) {
+		out[i].time_us = load(src, tsize, be);
+		out[i].start_us = load(src + soff, ssize, be);
+		out[i].flags = (int32_t)load(src + foff, 4, be);
+		out[i].id = (int32_t)load(src + ioff, 4, be);
+	}
+}
+
+#define BOOTSTAGE_DECODER(fn, be, tsize, ssize, soff, foff, ioff, stride) \
+static void fn(const uint8_t *src, uint32_t count, bootstage_rec_t *out) \
+{ \
+	decode_records(src, count, out, be, tsize, ssize, soff, foff, ioff, stride); \
+}
+
+/* 64-bit U-Boot, and this parser's own packed record */
+BOOTSTAGE_DECODER(decode_le64, 0, 8, 8, 8, 24, 28, 32)
+BOOTSTAGE_DECODER(decode_be64, 1, 8, 8, 8, 24, 28, 32)
+/* 64-bit U-Boot with the 32-bit start_us of newer releases */
+BOOTSTAGE_DECODER(decode_le64_s32, 0, 8, 4, 8, 24, 28, 32)
+BOOTSTAGE_DECODER(decode_be64_s32, 1, 8, 4, 8, 24, 28, 32)
+/* 32-bit SPL/U-Boot (e.g. on the R5F) */
+BOOTSTAGE_DECODER(decode_le32, 0, 4, 4, 4, 12, 16, 20)
+BOOTSTAGE_DECODER(decode_be32, 1, 4, 4, 4, 12, 16, 20)
+/* Packed 64-bit times with a 32-bit pointer */
+BOOTSTAGE_DECODER(decode_le64_p32, 0, 8, 8, 8, 20, 24, 28)
+BOOTSTAGE_DECODER(decode_be64_p32, 1, 8, 8, 8, 20, 24, 28)
+/* 32-bit times with a 64-bit pointer */
+BOOTSTAGE_DECODER(decode_le32_p64, 0, 4, 4, 4, 16, 20, 24)
+BOOTSTAGE_DECODER(decode_be32_p64, 1, 4, 4, 4, 16, 20, 24)
+
+/* Detection prefers the earlier entry when two layouts score the same */
+static const bootstage_layout_t layouts[] = {
+	{ "le64",	8, 8, 8, 0, 32, decode_le64 },
+	{ "le64-s32",	8, 4, 8, 0, 32, decode_le64_s32 },
+	{ "le32",	4, 4, 4, 0, 20, decode_le32 },
+	{ "le64-p32",	8, 8, 4, 0, 28, decode_le64_p32 },
+	{ "le32-p64",	4, 4, 8, 0, 24, decode_le32_p64 },
+	{ "be64",	8, 8, 8, 1, 32, decode_be64 },
+	{ "be64-s32",	8, 4, 8, 1, 32, decode_be64_s32 },
+	{ "be32",	4, 4, 4, 1, 20, decode_be32 },
+	{ "be64-p32",	8, 8, 4, 1, 28, decode_be64_p32 },
+	{ "be32-p64",	4, 4, 8, 1, 24, decode_be32_p64 },
+};
+
+#define NLAYOUTS (sizeof(layouts) / sizeof(layouts[0]))
+
+/**
+ * @brief Decodes the bootstage header in either byte order.
+ *
+ * The magic number tells the byte order of the producer.
+ *
+ * @param p BOOTSTAGE_HDR_SIZE bytes at the start of the region.
+ * @param hdr Receives the header in host byte order.
+ * @return int 0 on success, -1 if the magic matches neither byte order.
+ */
+int bootstage_parse_header(const void *p, bootstage_hdr_info_t *hdr)
+{
+	const uint8_t *b = p;
+	int be;
+
+	if (load32(b + 12, 0) == BOOTSTAGE_MAGIC)
+		be = 0;
+	else if (load32(b + 12, 1) == BOOTSTAGE_MAGIC)
+		be = 1;
+	else
+		return -1;
+
+	hdr->big_endian = be;
+	hdr->version = load32(b, be);
+	hdr->count = load32(b + 4, be);
+	hdr->size = load32(b + 8, be);
+	hdr->next_id = load32(b + 16, be);
+	return 0;
+}
+
+/**
+ * @brief Looks up a layout by name.
+ *
+ * @param name Layout name as listed by bootstage_layout_list().
+ * @return const bootstage_layout_t* The layout, NULL if unknown.
+ */
+const bootstage_layout_t *bootstage_layout_find(const char *name)
+{
+	for (size_t i = 0; i < NLAYOUTS; i++)
+		if (strcmp(layouts[i].name, name) == 0)
+			return &layouts[i];
+	return NULL;
+}
+
+static int plausible(const bootstage_rec_t *r)
+{
+	return r->id > 0 && r->id < LAYOUT_ID_MAX &&
+		r->flags >= 0 && r->flags < LAYOUT_FLAGS_MAX &&
+		r->time_us < LAYOUT_TIME_US_MAX && r->start_us < LAYOUT_TIME_US_MAX;
+}
+
+/**
+ * @brief Picks the record layout of a bootstage region.
+ *
+ * Layouts of the header's byte order whose records fit in the region are
+ * scored on up to BOOTSTAGE_LAYOUT_SAMPLE records: a layout read at the
+ * wrong stride or width quickly yields out of range ids, flags or times,
+ * and a wrong start_us width (padding read as time) breaks the time
+ * order. A record area that fits in the header's size counts as a tie
+ * breaker.
+ *
+ * @param hdr Decoded header.
+ * @param records Start of the records.
+ * @param len Bytes readable at records.
+ * @param avail Region bytes after the header.
+ * @return const bootstage_layout_t* The best layout, NULL if the records
+ * fit in the region with no layout.
+ */
+const bootstage_layout_t *bootstage_layout_detect(const bootstage_hdr_info_t *hdr,
+		const uint8_t *records, size_t len, size_t avail)
+{
+	bootstage_rec_t sample[BOOTSTAGE_LAYOUT_SAMPLE];
+	const bootstage_layout_t *best = NULL;
+	int best_score = -1;
+
+	for (size_t i = 0; i < NLAYOUTS; i++) {
+		const bootstage_layout_t *l = &layouts[i];
+		uint64_t need = (uint64_t)hdr->count * l->stride;
+		uint32_t n = hdr->count;
+		uint64_t last;
+		int score;
+
+		if (l->big_endian != hdr->big_endian || need > avail)
+			continue;
+		if (n > BOOTSTAGE_LAYOUT_SAMPLE)
+			n = BOOTSTAGE_LAYOUT_SAMPLE;
+		if (n > len / l->stride)
+			n = len / l->stride;
+		l->decode(records, n, sample);
+
+		score = (need <= hdr->size) ? 1 : 0;
+		last = 0;
+		for (uint32_t r = 0; r < n; r++) {
+			const bootstage_rec_t *rec = &sample[r];
+			uint64_t t = rec->start_us ? rec->start_us : rec->time_us;
+
+			if (!plausible(rec))
+				continue;
+			/* Records are stashed roughly in the order they were taken */
+			score += (t >= last) ? 3 : 2;
+			last = t;
+		}
+		if (score > best_score) {
+			best = l;
+			best_score = score;
+		}
+	}
+	return best;
+}
+
+/**
+ * @brief Lists the known layouts, one per line.
+ *
+ * @param fp Output stream.
+ */
+void bootstage_layout_list(FILE *fp)
+{
+	for (size_t i = 0; i < NLAYOUTS; i++)
+		fprintf(fp, "  %-10s %s endian, %u-bit time, %u-bit start, %u-bit pointer, "
+				"%u byte records\n",
+				layouts[i].name, layouts[i].big_endian ? "big" : "little",
+				layouts[i].ulong_size * 8, layouts[i].start_size * 8,
+				layouts[i].ptr_size * 8, layouts[i].stride);
+}
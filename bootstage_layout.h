@@ -0,0 +1,116 @@
+/*
+ *  Copyright (C) 2025 Texas Instruments Incorporated
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions
+ *  are met:
+ *
+ *    Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *
+ *    Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the
+ *    distribution.
+ *
+ *    Neither the name of Texas Instruments Incorporated nor the names of
+ *    its contributors may be used to endorse or promote products derived
+ *    from this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ *  "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ *  LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ *  A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ *  OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ *  SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ *  LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ *  DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ *  THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ *  (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ *  OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/**
+ * \file bootstage_layout.h
+ * \brief Decoders for the bootstage record layouts written by the
+ * different U-Boot/SPL builds: 32 or 64-bit ulong and pointers, little or
+ * big endian. The layout is picked once per region from the header and the
+ * record stride, and the chosen decoder converts all records in one loop.
+ */
+
+#ifndef BOOTSTAGE_LAYOUT_H
+#define BOOTSTAGE_LAYOUT_H
+
+/* ========================================================================== */
+/*                           Include Files                                    */
+/* ========================================================================== */
+#include <stdint.h>
+#include <stddef.h>
+#include <stdio.h>
+
+/* ========================================================================== */
+/*                           Macros & Typedefs                                */
+/* ========================================================================== */
+
+/* Header is five u32 in every layout */
+#define BOOTSTAGE_HDR_SIZE		20
+/* Widest record: 64-bit ulong and pointer */
+#define BOOTSTAGE_RECORD_STRIDE_MAX	32
+/* Records decoded per candidate layout when detecting */
+#define BOOTSTAGE_LAYOUT_SAMPLE		64
+
+/* ========================================================================== */
+/*                           Data Structures                                  */
+/* ========================================================================== */
+
+/**
+ * Bootstage header in host byte order.
+ */
+typedef struct {
+	uint32_t version;
+	uint32_t count;
+	uint32_t size;
+	uint32_t next_id;
+	int big_endian; /* Byte order the producer wrote */
+} bootstage_hdr_info_t;
+
+/**
+ * One bootstage record in host byte order; the name pointer is dropped as
+ * it points into the producer's address space.
+ */
+typedef struct {
+	uint64_t time_us;
+	uint64_t start_us;
+	int32_t flags;
+	int32_t id;
+} bootstage_rec_t;
+
+typedef void (*bootstage_decode_fn)(const uint8_t *src, uint32_t count,
+		bootstage_rec_t *out);
+
+/**
+ * A producer record layout and its decoder. Fields follow each other in
+ * struct bootstage_record order, name at 2 * ulong_size and flags right
+ * after it.
+ */
+typedef struct {
+	const char *name; /* e.g. "le64", "be32" */
+	uint8_t ulong_size; /* time_us */
+	uint8_t start_size; /* start_us, a u32 in newer U-Boot */
+	uint8_t ptr_size; /* name */
+	uint8_t big_endian;
+	uint8_t stride; /* Record size, including trailing padding */
+	bootstage_decode_fn decode;
+} bootstage_layout_t;
+
+/* ========================================================================== */
+/*                          Function Declarations                             */
+/* ========================================================================== */
+
+int bootstage_parse_header(const void *p, bootstage_hdr_info_t *hdr);
+const bootstage_layout_t *bootstage_layout_find(const char *name);
+const bootstage_layout_t *bootstage_layout_detect(const bootstage_hdr_info_t *hdr,
+		const uint8_t *records, size_t len, size_t avail);
+void bootstage_layout_list(FILE *fp);
+
+#endif /* BOOTSTAGE_LAYOUT_H */
@@ -0,0 +1,210 @@
+/*
+ *  Copyright (C) 2025 Texas Instruments Incorporated
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions
+ *  are met:
+ *
+ *    Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *
+ *    Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the
+ *    distribution.
+ *
+ *    Neither the name of Texas Instruments Incorporated nor the names of
+ *    its contributors may be used to endorse or promote products derived
+ *    from this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ *  "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ *  LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ *  A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ *  OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ *  SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ *  LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ *  DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ *  THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ *  (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ *  OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/**
+ * \file bootstage_source.c
+ * \brief In-place access to the preserved bootstage region. The parser asks
+ * for the byte ranges it needs and gets a pointer straight into the mapping
+ * (or the caller's buffer) instead of a full copy of the region.
+ */
+
+/* ========================================================================== */
+/*                           Include Files                                    */
+/* ========================================================================== */
+
+#include <stdio.h>
+#include <string.h>
+#include <unistd.h>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+
+#include "bootstage_source.h"
+
+
+/* ========================================================================== */
+/*                          Function Definitions                              */
+/* ========================================================================== */
+
+static void bootstage_source_init(bootstage_source_t *src,
+		bootstage_source_type_t type)
+{
+	memset(src, 0, sizeof(*src));
+	src->type = type;
+	src->fd = -1;
+}
+
+/**
+ * @brief Opens the bootstage region through /dev/mem.
+ *
+ * Nothing is mapped here; windows are mapped on demand.
+ *
+ * @param src Source to initialise.
+ * @param phys_addr Physical address of the preserved region.
+ * @param size Size of the preserved region.
+ * @return int 0 on success, -1 on failure.
+ */
+int bootstage_source_open_mem(bootstage_source_t *src, off_t phys_addr, size_t size)
+{
+	bootstage_source_init(src, BOOTSTAGE_SOURCE_DEVMEM);
+	src->fd = open("/dev/mem", O_RDONLY);
+	if (src->fd < 0) {
+		perror("Error opening /dev/mem");
+		return -1;
+	}
+	src->base = phys_addr;
+	src->size = size;
+	return 0;
+}
+
+/**
+ * @brief Opens a raw dump of the bootstage region.
+ *
+ * The dump is expected to start at the region base, i.e. the U-Boot
+ * bootstage header is at offset 0.
+ *
+ * @param src Source to initialise.
+ * @param path Path of the dump file.
+ * @return int 0 on success, -1 on failure.
+ */
+int bootstage_source_open_file(bootstage_source_t *src, const char *path)
+{
+	struct stat st;
+
+	bootstage_source_init(src, BOOTSTAGE_SOURCE_FILE);
+	src->fd = open(path, O_RDONLY);
+	if (src->fd < 0) {
+		perror("Error opening bootstage dump");
+		return -1;
+	}
+	if (fstat(src->fd, &st) < 0) {
+		perror("fstat");
+		close(src->fd);
+		src->fd = -1;
+		return -1;
+	}
+	src->size = st.st_size;
+	return 0;
+}
+
+/**
+ * @brief Wraps a memory buffer holding a copy of the bootstage region.
+ *
+ * The buffer must stay valid until the source is closed.
+ */
+void bootstage_source_open_buffer(bootstage_source_t *src, const void *buf, size_t len)
+{
+	bootstage_source_init(src, BOOTSTAGE_SOURCE_BUFFER);
+	src->buf = buf;
+	src->size = len;
+}
+
+/**
+ * @brief Tells whether [offset, offset + len) lies inside the region.
+ *
+ * Lets callers tell a range missing from a short dump apart from a range
+ * that bootstage_source_map() failed to map.
+ */
+int bootstage_source_has(const bootstage_source_t *src, size_t offset, size_t len)
+{
+	return offset <= src->size && len <= src->size - offset;
+}
+
+/**
+ * @brief Returns a read-only pointer to [offset, offset + len) of the region.
+ *
+ * For mapped sources only the pages covering the requested range are
+ * mapped, and an already mapped window is reused when it covers the range.
+ * The pointer stays valid until bootstage_source_close().
+ *
+ * @return const void* Pointer to the data, or NULL if the range is out of
+ * bounds (see bootstage_source_has()) or cannot be mapped; the latter is
+ * reported on stderr.
+ */
+const void *bootstage_source_map(bootstage_source_t *src, size_t offset, size_t len)
+{
+	long page = sysconf(_SC_PAGESIZE);
+	size_t start, end;
+	void *addr;
+
+	if (!bootstage_source_has(src, offset, len))
+		return NULL;
+
+	if (src->type == BOOTSTAGE_SOURCE_BUFFER)
+		return src->buf + offset;
+
+	for (int i = 0; i < src->nviews; i++) {
+		bootstage_view_t *v = &src->views[i];
+		if (offset >= v->offset && offset + len <= v->offset + v->len)
+			return (uint8_t *)v->addr + (offset - v->offset);
+	}
+
+	if (src->nviews == BOOTSTAGE_SOURCE_MAX_VIEWS) {
+		fprintf(stderr, "bootstage source: out of map windows\n");
+		return NULL;
+	}
+
+	/* Align on the absolute device/file offset so mmap accepts it */
+	start = ((src->base + offset) & ~(page - 1)) - src->base;
+	end = src->base + offset + len;
+	end = ((end + page - 1) & ~(page - 1)) - src->base;
+	if (len == 0)
+		end = start + page;
+
+	addr = mmap(NULL, end - start, PROT_READ,
+		src->type == BOOTSTAGE_SOURCE_DEVMEM ? MAP_SHARED : MAP_PRIVATE,
+		src->fd, src->base + start);
+	if (addr == MAP_FAILED) {
+		perror("mmap");
+		return NULL;
+	}
+
+	src->views[src->nviews].addr = addr;
+	src->views[src->nviews].len = end - start;
+	src->views[src->nviews].offset = start;
+	src->nviews++;
+
+	return (uint8_t *)addr + (offset - start);
+}
+
+/**
+ * @brief Unmaps every window and releases the source.
+ */
+void bootstage_source_close(bootstage_source_t *src)
+{
+	for (int i = 0; i < src->nviews; i++)
+		munmap(src->views[i].addr, src->views[i].len);
+	src->nviews = 0;
+	if (src->fd >= 0)
+		close(src->fd);
+	src->fd = -1;
+}
@@ -0,0 +1,106 @@
+/*
+ *  Copyright (C) 2025 Texas Instruments Incorporated
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions
+ *  are met:
+ *
+ *    Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *
+ *    Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the
+ *    distribution.
+ *
+ *    Neither the name of Texas Instruments Incorporated nor the names of
+ *    its contributors may be used to endorse or promote products derived
+ *    from this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ *  "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ *  LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ *  A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ *  OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ *  SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ *  LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ *  DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ *  THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ *  (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ *  OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/**
+ * \file bootstage_source.h
+ * \brief Record source layer giving in-place, page-minimal access to the
+ * preserved bootstage region from /dev/mem, a raw dump file or a buffer.
+ */
+
+#ifndef BOOTSTAGE_SOURCE_H
+#define BOOTSTAGE_SOURCE_H
+
+/* ========================================================================== */
+/*                           Include Files                                    */
+/* ========================================================================== */
+#include <stdint.h>
+#include <stddef.h>
+#include <sys/types.h>
+
+/* ========================================================================== */
+/*                           Macros & Typedefs                                */
+/* ========================================================================== */
+
+/*
+ * Windows one source may map: the region header and records (3), the
+ * kernel record area (3) and, per remote core block, its header, its
+ * records and the capacity followed by --watch (3). Checked against
+ * BOOT_REMOTE_CORES_MAX in boot_time_report.h.
+ */
+#define BOOTSTAGE_SOURCE_MAX_VIEWS	32
+
+typedef enum {
+	BOOTSTAGE_SOURCE_DEVMEM,
+	BOOTSTAGE_SOURCE_FILE,
+	BOOTSTAGE_SOURCE_BUFFER,
+} bootstage_source_type_t;
+
+/* ========================================================================== */
+/*                           Data Structures                                  */
+/* ========================================================================== */
+
+/**
+ * One page aligned window of the region mapped into our address space.
+ */
+typedef struct {
+	void *addr;
+	size_t len;
+	size_t offset; /* Region offset of the first mapped byte */
+} bootstage_view_t;
+
+/**
+ * Bootstage region source. Only the windows asked for through
+ * bootstage_source_map() are ever mapped, so the pages touched are the
+ * ones actually covered by the header and record counts.
+ */
+typedef struct {
+	bootstage_source_type_t type;
+	int fd;
+	off_t base; /* Offset of the region in the backing device/file */
+	size_t size; /* Region size in bytes */
+	const uint8_t *buf; /* Backing memory for BOOTSTAGE_SOURCE_BUFFER */
+	bootstage_view_t views[BOOTSTAGE_SOURCE_MAX_VIEWS];
+	int nviews;
+} bootstage_source_t;
+
+/* ========================================================================== */
+/*                          Function Declarations                             */
+/* ========================================================================== */
+
+int bootstage_source_open_mem(bootstage_source_t *src, off_t phys_addr, size_t size);
+int bootstage_source_open_file(bootstage_source_t *src, const char *path);
+void bootstage_source_open_buffer(bootstage_source_t *src, const void *buf, size_t len);
+int bootstage_source_has(const bootstage_source_t *src, size_t offset, size_t len);
+const void *bootstage_source_map(bootstage_source_t *src, size_t offset, size_t len);
+void bootstage_source_close(bootstage_source_t *src);
+
+#endif /* BOOTSTAGE_SOURCE_H */
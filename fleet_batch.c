@@ -0,0 +1,825 @@
+/*
+ *  Copyright (C) 2025 Texas Instruments Incorporated
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions
+ *  are met:
+ *
+ *    Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *
+ *    Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the
+ *    distribution.
+ *
+ *    Neither the name of Texas Instruments Incorporated nor the names of
+ *    its contributors may be used to endorse or promote products derived
+ *    from this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ *  "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ *  LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ *  A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ *  OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ *  SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ *  LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ *  DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ *  THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ *  (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ *  OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/**
+ * \file fleet_batch.c
+ * \brief Fleet batch analyzer. Every captured boot is parsed into its own
+ * parser context on a pool of worker threads; each worker folds its boots
+ * into private per-stage sample columns, which are merged once at the end
+ * and reduced to min/percentile/max/stddev per stage.
+ */
+
+/* ========================================================================== */
+/*                           Include Files                                    */
+/* ========================================================================== */
+
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include <time.h>
+#include <dirent.h>
+#include <libgen.h>
+#include <limits.h>
+#include <unistd.h>
+#include <pthread.h>
+#include <inttypes.h>
+#include <sys/stat.h>
+
+#include "fleet_batch.h"
+#include "boot_time_report.h"
+#include "boot_capture.h"
+
+/* ========================================================================== */
+/*                           Macros & Typedefs                                */
+/* ========================================================================== */
+
+/**
+ * Samples of one stage collected by one worker.
+ */
+typedef struct {
+	uint64_t *start;
+	uint64_t *delta;
+	size_t count;
+	size_t cap;
+} fleet_series_t;
+
+/**
+ * Per worker accumulator; series[d][i] holds the samples of name i.
+ */
+typedef struct {
+	arena_t arena;
+	strtab_t names;
+	fleet_series_t *series[FLEET_DOMAINS];
+	uint32_t nseries[FLEET_DOMAINS];
+	uint64_t boots;
+	uint64_t failed;
+	int err;
+} fleet_acc_t;
+
+typedef struct {
+	const fleet_input_t *in;
+	size_t next; /* Next unclaimed item, advanced atomically */
+} fleet_queue_t;
+
+typedef struct {
+	fleet_queue_t *queue;
+	fleet_acc_t acc;
+} fleet_worker_t;
+
+static const char *const fleet_domain_names[FLEET_DOMAINS] = {
+	[FLEET_DOMAIN_SUMMARY] = "summary",
+	[FLEET_DOMAIN_BOOT] = "boot",
+	[FLEET_DOMAIN_MCU] = "mcu",
+};
+
+/* Summary rows, interned first so they keep this order */
+static const char *const fleet_summary_names[] = {
+	"SPL Time",
+	"U-Boot Time",
+	"Kernel handoff time",
+	"Kernel Time",
+	"Total Boot Time",
+};
+
+static const char *const fleet_domain_titles[FLEET_DOMAINS] = {
+	[FLEET_DOMAIN_SUMMARY] = "Boot Time Summary",
+	[FLEET_DOMAIN_BOOT] = "Bootloader and Kernel Boot Records",
+	[FLEET_DOMAIN_MCU] = "Remote Core Boot Records",
+};
+
+
+/* ========================================================================== */
+/*                          Function Definitions                              */
+/* ========================================================================== */
+
+/**
+ * @brief Appends one boot to the batch input.
+ *
+ * @param dump Bootstage region dump.
+ * @param log Kernel log (syslog, or a kmsg/dmesg dump ending in
+ * FLEET_KMSG_SUFFIX), or NULL.
+ * @return int 0 on success, -1 on allocation failure.
+ */
+int fleet_input_add(fleet_input_t *in, const char *dump, const char *log)
+{
+	fleet_item_t *it;
+
+	if (in->count == in->cap) {
+		size_t cap = in->cap ? in->cap * 2 : 256;
+		fleet_item_t *n = realloc(in->items, cap * sizeof(*n));
+		if (!n)
+			return -1;
+		in->items = n;
+		in->cap = cap;
+	}
+	it = &in->items[in->count];
+	it->dump = strdup(dump);
+	it->log = log ? strdup(log) : NULL;
+	if (!it->dump || (log && !it->log)) {
+		free(it->dump);
+		free(it->log);
+		return -1;
+	}
+	in->count++;
+	return 0;
+}
+
+static int has_suffix(const char *s, const char *suffix)
+{
+	size_t n = strlen(s), m = strlen(suffix);
+
+	return n > m && strcmp(s + n - m, suffix) == 0;
+}
+
+static int cmp_str(const void *a, const void *b)
+{
+	return strcmp(*(char *const *)a, *(char *const *)b);
+}
+
+/*
+ * Collects every <name>.bin in a directory together with <name>.log or
+ * <name>.kmsg when present. Entries are sorted so runs are reproducible.
+ */
+static int load_dir(fleet_input_t *in, const char *dir)
+{
+	char **names = NULL;
+	size_t n = 0, cap = 0;
+	struct dirent *de;
+	int ret = 0;
+	DIR *d;
+
+	d = opendir(dir);
+	if (!d) {
+		perror("Failed to open fleet directory");
+		return -1;
+	}
+	while ((de = readdir(d)) != NULL) {
+		if (!has_suffix(de->d_name, FLEET_DUMP_SUFFIX) &&
+				!has_suffix(de->d_name, BOOT_CAPTURE_SUFFIX))
+			continue;
+		if (n == cap) {
+			char **p;
+			cap = cap ? cap * 2 : 256;
+			p = realloc(names, cap * sizeof(*p));
+			if (!p) {
+				ret = -1;
+				break;
+			}
+			names = p;
+		}
+		names[n] = strdup(de->d_name);
+		if (!names[n]) {
+			ret = -1;
+			break;
+		}
+		n++;
+	}
+	closedir(d);
+	if (ret == 0)
+		qsort(names, n, sizeof(*names), cmp_str);
+
+	for (size_t i = 0; i < n && ret == 0; i++) {
+		size_t base = strlen(names[i]) - strlen(FLEET_DUMP_SUFFIX);
+		char dump[PATH_MAX], log[PATH_MAX];
+		const char *logp = NULL;
+
+		snprintf(dump, sizeof(dump), "%s/%s", dir, names[i]);
+		if (has_suffix(names[i], BOOT_CAPTURE_SUFFIX)) {
+			/* Captures carry their own kernel lines */
+			ret = fleet_input_add(in, dump, NULL);
+			continue;
+		}
+		snprintf(log, sizeof(log), "%s/%.*s%s", dir, (int)base, names[i],
+				FLEET_LOG_SUFFIX);
+		if (access(log, R_OK) == 0) {
+			logp = log;
+		} else {
+			snprintf(log, sizeof(log), "%s/%.*s%s", dir, (int)base, names[i],
+					FLEET_KMSG_SUFFIX);
+			if (access(log, R_OK) == 0)
+				logp = log;
+		}
+		ret = fleet_input_add(in, dump, logp);
+	}
+	for (size_t i = 0; i < n; i++)
+		free(names[i]);
+	free(names);
+	if (ret < 0)
+		fprintf(stderr, "Out of memory listing %s\n", dir);
+	return ret;
+}
+
+/*
+ * Resolves a manifest entry relative to the manifest's directory. Returns
+ * -1 if the resulting path does not fit.
+ */
+static int manifest_path(char *out, size_t len, const char *dir, const char *p)
+{
+	int n;
+
+	if (p[0] == '/')
+		n = snprintf(out, len, "%s", p);
+	else
+		n = snprintf(out, len, "%s/%s", dir, p);
+	return (n < 0 || (size_t)n >= len) ? -1 : 0;
+}
+
+/*
+ * Reads a manifest with one boot per line: "<dump> [<log>]". Blank lines
+ * and lines starting with '#' are ignored.
+ */
+static int load_manifest(fleet_input_t *in, const char *path)
+{
+	char line[2 * PATH_MAX], tmp[PATH_MAX], dir[PATH_MAX];
+	unsigned lineno = 0;
+	FILE *fp;
+	int ret = 0;
+
+	fp = fopen(path, "r");
+	if (!fp) {
+		perror("Failed to open fleet manifest");
+		return -1;
+	}
+	snprintf(tmp, sizeof(tmp), "%s", path);
+	snprintf(dir, sizeof(dir), "%s", dirname(tmp));
+
+	while (ret == 0 && fgets(line, sizeof(line), fp)) {
+		char dump[PATH_MAX], log[PATH_MAX];
+		char *save, *d, *l;
+
+		lineno++;
+		d = strtok_r(line, " \t\r\n", &save);
+		if (!d || d[0] == '#')
+			continue;
+		l = strtok_r(NULL, " \t\r\n", &save);
+		if (manifest_path(dump, sizeof(dump), dir, d) < 0 ||
+				(l && manifest_path(log, sizeof(log), dir, l) < 0)) {
+			fprintf(stderr, "%s:%u: path too long\n", path, lineno);
+			ret = -1;
+			break;
+		}
+		ret = fleet_input_add(in, dump, l ? log : NULL);
+		if (ret < 0)
+			fprintf(stderr, "%s:%u: out of memory\n", path, lineno);
+	}
+	fclose(fp);
+	return ret;
+}
+
+/**
+ * @brief Loads the boots of a fleet capture.
+ *
+ * @param path Directory of <name>.bin dumps with optional <name>.log or
+ * <name>.kmsg logs, or a manifest file listing "<dump> [<log>]" per line.
+ * @return int 0 on success, -1 on failure.
+ */
+int fleet_input_load(fleet_input_t *in, const char *path)
+{
+	struct stat st;
+
+	if (stat(path, &st) < 0) {
+		perror("Failed to open fleet input");
+		return -1;
+	}
+	if (S_ISDIR(st.st_mode))
+		return load_dir(in, path);
+	return load_manifest(in, path);
+}
+
+/**
+ * @brief Releases the batch input.
+ */
+void fleet_input_free(fleet_input_t *in)
+{
+	for (size_t i = 0; i < in->count; i++) {
+		free(in->items[i].dump);
+		free(in->items[i].log);
+	}
+	free(in->items);
+	memset(in, 0, sizeof(*in));
+}
+
+static void acc_init(fleet_acc_t *acc)
+{
+	memset(acc, 0, sizeof(*acc));
+	arena_init(&acc->arena);
+	strtab_init(&acc->names, &acc->arena);
+	for (size_t i = 0; i < sizeof(fleet_summary_names) / sizeof(fleet_summary_names[0]); i++)
+		strtab_intern(&acc->names, fleet_summary_names[i], strlen(fleet_summary_names[i]));
+}
+
+static void acc_release(fleet_acc_t *acc)
+{
+	for (int d = 0; d < FLEET_DOMAINS; d++) {
+		for (uint32_t i = 0; i < acc->nseries[d]; i++) {
+			free(acc->series[d][i].start);
+			free(acc->series[d][i].delta);
+		}
+		free(acc->series[d]);
+		acc->series[d] = NULL;
+		acc->nseries[d] = 0;
+	}
+}
+
+/*
+ * Returns the sample series of a stage. Names are interned into the
+ * worker's own table, so no locking is needed while boots are parsed.
+ */
+static fleet_series_t *acc_series(fleet_acc_t *acc, fleet_domain_t domain,
+		const char *name, size_t len)
+{
+	uint32_t idx = strtab_intern(&acc->names, name, len);
+
+	if (idx == STRTAB_NONE)
+		return NULL;
+	if (idx >= acc->nseries[domain]) {
+		uint32_t n = acc->names.cap;
+		fleet_series_t *p = realloc(acc->series[domain], n * sizeof(*p));
+		if (!p)
+			return NULL;
+		memset(p + acc->nseries[domain], 0,
+				(n - acc->nseries[domain]) * sizeof(*p));
+		acc->series[domain] = p;
+		acc->nseries[domain] = n;
+	}
+	return &acc->series[domain][idx];
+}
+
+static int series_reserve(fleet_series_t *s, size_t n)
+{
+	size_t cap = s->cap ? s->cap : 64;
+	uint64_t *p;
+
+	if (s->count + n <= s->cap)
+		return 0;
+	while (cap < s->count + n)
+		cap *= 2;
+	p = realloc(s->start, cap * sizeof(*p));
+	if (!p)
+		return -1;
+	s->start = p;
+	p = realloc(s->delta, cap * sizeof(*p));
+	if (!p)
+		return -1;
+	s->delta = p;
+	s->cap = cap;
+	return 0;
+}
+
+/* Appends one sample of a stage */
+static int acc_push(fleet_acc_t *acc, fleet_domain_t domain, const char *name,
+		size_t len, uint64_t start, uint64_t delta)
+{
+	fleet_series_t *s = acc_series(acc, domain, name, len);
+
+	if (!s || series_reserve(s, 1) < 0)
+		return -1;
+	s->start[s->count] = start;
+	s->delta[s->count] = delta;
+	s->count++;
+	return 0;
+}
+
+static int push_summary(fleet_acc_t *acc, const char *name, uint64_t start,
+		uint64_t end)
+{
+	if (end < start)
+		return 0;
+	return acc_push(acc, FLEET_DOMAIN_SUMMARY, name, strlen(name), start, end - start);
+}
+
+static int push_records(fleet_acc_t *acc, fleet_domain_t domain,
+		const boot_time_ctx_t *ctx, const boot_record_columns_t *cols,
+		const char *prefix)
+{
+	char buf[256];
+
+	for (int i = 0; i < cols->count; i++) {
+		const char *name = boot_time_name(ctx, cols->name[i]);
+		int len = prefix ? snprintf(buf, sizeof(buf), "%s:%s", prefix, name) :
+			(int)strlen(name);
+
+		if (len >= (int)sizeof(buf))
+			len = sizeof(buf) - 1;
+		if (acc_push(acc, domain, prefix ? buf : name, len,
+				cols->start_time[i], cols->delta_time[i]) < 0)
+			return -1;
+	}
+	return 0;
+}
+
+/*
+ * Parses one captured boot into a private context and folds its records
+ * into the worker's accumulator.
+ */
+static void parse_item(fleet_acc_t *acc, const fleet_input_t *in,
+		const fleet_item_t *it)
+{
+	const boot_summary_t *sum;
+	boot_record_columns_t cols;
+	boot_time_ctx_t *ctx;
+
+	ctx = boot_time_ctx_create();
+	if (!ctx) {
+		acc->err = -1;
+		return;
+	}
+	/*
+	 * Parallelism comes from the pool; never split single logs. No sidecar
+	 * index is written next to the inputs: the log is split into boots in
+	 * memory and its latest boot, the one the dump belongs to, is kept.
+	 */
+	boot_time_set_jobs(ctx, 1);
+	boot_time_set_log_index(ctx, BOOT_TIME_LOG_INDEX_NONE);
+	boot_time_set_boot(ctx, 0);
+	if (in->remote)
+		boot_time_set_remote_cores(ctx, in->remote, in->nremote);
+
+	if (has_suffix(it->dump, BOOT_CAPTURE_SUFFIX)) {
+		if (boot_time_read_capture(ctx, it->dump) != EXIT_SUCCESS) {
+			acc->failed++;
+			boot_time_ctx_destroy(ctx);
+			return;
+		}
+	} else if (boot_time_read_bootstage_file(ctx, it->dump) != EXIT_SUCCESS) {
+		acc->failed++;
+		boot_time_ctx_destroy(ctx);
+		return;
+	}
+	if (it->log) {
+		if (has_suffix(it->log, FLEET_KMSG_SUFFIX))
+			boot_time_read_kmsg(ctx, it->log);
+		else
+			boot_time_read_kernel_log(ctx, it->log);
+	}
+
+	sum = boot_time_summary(ctx);
+	if (push_summary(acc, fleet_summary_names[0], 0, sum->ustart_time) < 0 ||
+			push_summary(acc, fleet_summary_names[1], sum->ustart_time, sum->uend_time) < 0)
+		acc->err = -1;
+	if (sum->kend_time && (push_summary(acc, fleet_summary_names[2],
+				sum->uend_time, sum->kstart_time) < 0 ||
+			push_summary(acc, fleet_summary_names[3], sum->kstart_time, sum->kend_time) < 0 ||
+			push_summary(acc, fleet_summary_names[4], 0, sum->kend_time) < 0))
+		acc->err = -1;
+
+	boot_time_records(ctx, &cols);
+	if (push_records(acc, FLEET_DOMAIN_BOOT, ctx, &cols, NULL) < 0)
+		acc->err = -1;
+	/* The first core keeps plain names so MCU-only fleets compare as before */
+	for (int c = 0; c < boot_time_remote_core_count(ctx); c++) {
+		boot_time_remote_records(ctx, c, &cols);
+		if (push_records(acc, FLEET_DOMAIN_MCU, ctx, &cols,
+					c ? boot_time_remote_core(ctx, c)->label : NULL) < 0)
+			acc->err = -1;
+	}
+	acc->boots++;
+	boot_time_ctx_destroy(ctx);
+}
+
+/*
+ * Worker loop. Boots are claimed one at a time from a shared atomic
+ * cursor, so a worker that drew cheap boots keeps taking more work
+ * instead of idling behind one that drew large logs.
+ */
+static void *fleet_worker(void *arg)
+{
+	fleet_worker_t *w = arg;
+	const fleet_input_t *in = w->queue->in;
+
+	while (!w->acc.err) {
+		size_t i = __atomic_fetch_add(&w->queue->next, 1, __ATOMIC_RELAXED);
+		if (i >= in->count)
+			break;
+		parse_item(&w->acc, in, &in->items[i]);
+	}
+	return NULL;
+}
+
+/* Moves one worker's samples into the merged accumulator */
+static int acc_merge(fleet_acc_t *dst, const fleet_acc_t *src)
+{
+	for (int d = 0; d < FLEET_DOMAINS; d++) {
+		for (uint32_t i = 0; i < src->nseries[d]; i++) {
+			const fleet_series_t *s = &src->series[d][i];
+			const char *name = strtab_str(&src->names, i);
+			fleet_series_t *t;
+
+			if (!s->count)
+				continue;
+			t = acc_series(dst, d, name, strlen(name));
+			if (!t || series_reserve(t, s->count) < 0)
+				return -1;
+			memcpy(t->start + t->count, s->start, s->count * sizeof(*s->start));
+			memcpy(t->delta + t->count, s->delta, s->count * sizeof(*s->delta));
+			t->count += s->count;
+		}
+	}
+	dst->boots += src->boots;
+	dst->failed += src->failed;
+	return 0;
+}
+
+static int cmp_u64(const void *a, const void *b)
+{
+	uint64_t x = *(const uint64_t *)a, y = *(const uint64_t *)b;
+
+	return (x > y) - (x < y);
+}
+
+/* Nearest-rank percentile of sorted v[0..n) */
+static uint64_t percentile(const uint64_t *v, size_t n, unsigned pct)
+{
+	size_t rank = (n * pct + 99) / 100;
+
+	return v[rank ? rank - 1 : 0];
+}
+
+/* Sorts v in place and fills the order statistics */
+static void compute_stat(uint64_t *v, size_t n, fleet_stat_t *st)
+{
+	double sum = 0, sq = 0;
+
+	qsort(v, n, sizeof(*v), cmp_u64);
+	for (size_t i = 0; i < n; i++)
+		sum += (double)v[i];
+	st->mean = sum / n;
+	for (size_t i = 0; i < n; i++) {
+		double d = (double)v[i] - st->mean;
+		sq += d * d;
+	}
+	st->stddev = sqrt(sq / n);
+	st->min = v[0];
+	st->p50 = percentile(v, n, 50);
+	st->p95 = percentile(v, n, 95);
+	st->p99 = percentile(v, n, 99);
+	st->max = v[n - 1];
+}
+
+/* Summary rows keep their fixed order, stages follow boot order */
+static int cmp_row(const void *a, const void *b)
+{
+	const fleet_row_t *x = a, *y = b;
+
+	if (x->domain != y->domain)
+		return (int)x->domain - (int)y->domain;
+	if (x->domain != FLEET_DOMAIN_SUMMARY && x->start.p50 != y->start.p50)
+		return (x->start.p50 > y->start.p50) ? 1 : -1;
+	return (x->name > y->name) - (x->name < y->name);
+}
+
+/* Reduces the merged samples to one row per stage */
+static int build_rows(fleet_acc_t *acc, fleet_result_t *res)
+{
+	size_t n = 0;
+
+	for (int d = 0; d < FLEET_DOMAINS; d++)
+		for (uint32_t i = 0; i < acc->nseries[d]; i++)
+			n += acc->series[d][i].count != 0;
+	res->rows = calloc(n ? n : 1, sizeof(*res->rows));
+	if (!res->rows)
+		return -1;
+
+	for (int d = 0; d < FLEET_DOMAINS; d++) {
+		for (uint32_t i = 0; i < acc->nseries[d]; i++) {
+			fleet_series_t *s = &acc->series[d][i];
+			fleet_row_t *r;
+
+			if (!s->count)
+				continue;
+			r = &res->rows[res->nrows++];
+			r->domain = d;
+			r->name = i;
+			r->samples = s->count;
+			compute_stat(s->start, s->count, &r->start);
+			compute_stat(s->delta, s->count, &r->delta);
+		}
+	}
+	qsort(res->rows, res->nrows, sizeof(*res->rows), cmp_row);
+	return 0;
+}
+
+/**
+ * @brief Parses every boot of a batch and reduces them to per-stage
+ * statistics.
+ *
+ * Boots are independent, so each worker parses into its own context and
+ * accumulator and the only shared state is the work cursor. Samples are
+ * merged and sorted once after all workers have finished.
+ *
+ * @param in Boots to analyze.
+ * @param nthreads Worker count, or <= 0 for one per online CPU.
+ * @param res Receives the statistics; release with fleet_result_free().
+ * @return int 0 on success, -1 on allocation or thread failure.
+ */
+int fleet_analyze(const fleet_input_t *in, int nthreads, fleet_result_t *res)
+{
+	fleet_queue_t queue = { .in = in, .next = 0 };
+	fleet_worker_t *workers;
+	pthread_t *tids;
+	struct timespec t0, t1;
+	fleet_acc_t merged;
+	int err = 0;
+
+	memset(res, 0, sizeof(*res));
+	if (nthreads <= 0)
+		nthreads = (int)sysconf(_SC_NPROCESSORS_ONLN);
+	if (nthreads > FLEET_MAX_THREADS)
+		nthreads = FLEET_MAX_THREADS;
+	if ((size_t)nthreads > in->count)
+		nthreads = (int)in->count;
+	if (nthreads < 1)
+		nthreads = 1;
+
+	workers = calloc(nthreads, sizeof(*workers));
+	tids = calloc(nthreads, sizeof(*tids));
+	if (!workers || !tids) {
+		free(workers);
+		free(tids);
+		return -1;
+	}
+
+	clock_gettime(CLOCK_MONOTONIC, &t0);
+	for (int i = 0; i < nthreads; i++) {
+		workers[i].queue = &queue;
+		acc_init(&workers[i].acc);
+	}
+	for (int i = 1; i < nthreads; i++)
+		if (pthread_create(&tids[i], NULL, fleet_worker, &workers[i]) != 0)
+			tids[i] = 0; /* The remaining workers pick up its share */
+	fleet_worker(&workers[0]);
+	for (int i = 1; i < nthreads; i++)
+		if (tids[i])
+			pthread_join(tids[i], NULL);
+
+	acc_init(&merged);
+	for (int i = 0; i < nthreads; i++) {
+		err |= workers[i].acc.err;
+		if (!err && acc_merge(&merged, &workers[i].acc) < 0)
+			err = -1;
+		acc_release(&workers[i].acc);
+		arena_release(&workers[i].acc.arena);
+	}
+	if (!err)
+		err = build_rows(&merged, res);
+	clock_gettime(CLOCK_MONOTONIC, &t1);
+
+	acc_release(&merged);
+	res->arena = merged.arena;
+	res->names = merged.names;
+	res->names.arena = &res->arena;
+	res->boots = merged.boots;
+	res->failed = merged.failed;
+	res->threads = nthreads;
+	res->elapsed = (t1.tv_sec - t0.tv_sec) + (t1.tv_nsec - t0.tv_nsec) / 1e9;
+	free(workers);
+	free(tids);
+	if (err) {
+		fprintf(stderr, "Out of memory analyzing fleet\n");
+		fleet_result_free(res);
+		return -1;
+	}
+	return 0;
+}
+
+/**
+ * @brief Prints the per-stage duration statistics as text tables.
+ *
+ * @param res Result of fleet_analyze().
+ * @param unit Display unit of the statistics.
+ * @param fp Output stream.
+ */
+void fleet_print(const fleet_result_t *res, boot_time_unit_t unit, FILE *fp)
+{
+	double div = boot_time_unit_ns(unit);
+	int domain = -1;
+
+	fprintf(fp, "--------------------------------------------------------------------\n");
+	fprintf(fp, "                 Fleet Boot Time Statistics\n");
+	fprintf(fp, "--------------------------------------------------------------------\n");
+	fprintf(fp, "Boots parsed            : %" PRIu64 "\n", res->boots);
+	fprintf(fp, "Boots failed            : %" PRIu64 "\n", res->failed);
+	fprintf(fp, "Threads                 : %d\n", res->threads);
+	fprintf(fp, "Analysis time           : %.3f s\n", res->elapsed);
+	fprintf(fp, "--------------------------------------------------------------------\n");
+
+	for (size_t i = 0; i < res->nrows; i++) {
+		const fleet_row_t *r = &res->rows[i];
+		const fleet_stat_t *st = &r->delta;
+
+		if ((int)r->domain != domain) {
+			domain = r->domain;
+			fprintf(fp, "\n--------------------------------------------------------------------\n");
+			fprintf(fp, "                 %s (duration, %s)\n", fleet_domain_titles[domain],
+					boot_time_unit_name(unit));
+			fprintf(fp, "--------------------------------------------------------------------\n");
+			fprintf(fp, "%-30s %7s %7s %7s %7s %7s %7s %8s\n", "Stage", "n",
+					"min", "p50", "p95", "p99", "max", "stddev");
+		}
+		fprintf(fp, "%-30s %7" PRIu64 " %7" PRIu64 " %7" PRIu64 " %7" PRIu64
+				" %7" PRIu64 " %7" PRIu64 " %8.1f\n",
+				strtab_str(&res->names, r->name), r->samples,
+				boot_time_to_unit(st->min, unit), boot_time_to_unit(st->p50, unit),
+				boot_time_to_unit(st->p95, unit), boot_time_to_unit(st->p99, unit),
+				boot_time_to_unit(st->max, unit), st->stddev / div);
+	}
+	fprintf(fp, "--------------------------------------------------------------------\n");
+}
+
+static void json_string(FILE *fp, const char *s)
+{
+	fputc('"', fp);
+	for (; *s; s++) {
+		unsigned char c = *s;
+
+		if (c == '"' || c == '\\')
+			fprintf(fp, "\\%c", c);
+		else if (c < 0x20)
+			fprintf(fp, "\\u%04x", c);
+		else
+			fputc(c, fp);
+	}
+	fputc('"', fp);
+}
+
+static void json_stat(FILE *fp, const char *key, const fleet_stat_t *st,
+		boot_time_unit_t unit)
+{
+	double div = boot_time_unit_ns(unit);
+
+	fprintf(fp, "\"%s\":{\"min\":%" PRIu64 ",\"p50\":%" PRIu64 ",\"p95\":%" PRIu64
+			",\"p99\":%" PRIu64 ",\"max\":%" PRIu64 ",\"mean\":%.3f,\"stddev\":%.3f}",
+			key, boot_time_to_unit(st->min, unit), boot_time_to_unit(st->p50, unit),
+			boot_time_to_unit(st->p95, unit), boot_time_to_unit(st->p99, unit),
+			boot_time_to_unit(st->max, unit), st->mean / div, st->stddev / div);
+}
+
+/**
+ * @brief Writes the statistics as JSON.
+ *
+ * Both the absolute stage time ("start") and the stage duration ("delta")
+ * distributions are written, in the given unit.
+ *
+ * @param res Result of fleet_analyze().
+ * @param unit Unit of the written statistics.
+ * @param fp Output stream.
+ */
+void fleet_export_json(const fleet_result_t *res, boot_time_unit_t unit, FILE *fp)
+{
+	fprintf(fp, "{\"boots\":%" PRIu64 ",\"failed\":%" PRIu64 ",\"threads\":%d,"
+			"\"elapsed_s\":%.6f,\"unit\":\"%s\",\"stages\":[",
+			res->boots, res->failed, res->threads, res->elapsed,
+			boot_time_unit_name(unit));
+	for (size_t i = 0; i < res->nrows; i++) {
+		const fleet_row_t *r = &res->rows[i];
+
+		fprintf(fp, "%s\n{\"domain\":\"%s\",\"name\":", i ? "," : "",
+				fleet_domain_names[r->domain]);
+		json_string(fp, strtab_str(&res->names, r->name));
+		fprintf(fp, ",\"samples\":%" PRIu64 ",", r->samples);
+		json_stat(fp, "start", &r->start, unit);
+		fputc(',', fp);
+		json_stat(fp, "delta", &r->delta, unit);
+		fputc('}', fp);
+	}
+	fprintf(fp, "\n]}\n");
+}
+
+/**
+ * @brief Releases the statistics.
+ */
+void fleet_result_free(fleet_result_t *res)
+{
+	free(res->rows);
+	arena_release(&res->arena);
+	memset(res, 0, sizeof(*res));
+}
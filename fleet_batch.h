@@ -0,0 +1,141 @@
+/*
+ *  Copyright (C) 2025 Texas Instruments Incorporated
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions
+ *  are met:
+ *
+ *    Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *
+ *    Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the
+ *    distribution.
+ *
+ *    Neither the name of Texas Instruments Incorporated nor the names of
+ *    its contributors may be used to endorse or promote products derived
+ *    from this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ *  "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ *  LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ *  A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ *  OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ *  SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ *  LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ *  DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ *  THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ *  (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ *  OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/**
+ * \file fleet_batch.h
+ * \brief Batch analysis of many captured boots (bootstage dump plus kernel
+ * log per boot) on a thread pool, reduced to per-stage distribution
+ * statistics.
+ */
+
+#ifndef FLEET_BATCH_H
+#define FLEET_BATCH_H
+
+/* ========================================================================== */
+/*                           Include Files                                    */
+/* ========================================================================== */
+#include <stdio.h>
+#include <stdint.h>
+#include <stddef.h>
+
+#include "record_store.h"
+#include "boot_time_report.h"
+
+/* ========================================================================== */
+/*                           Macros & Typedefs                                */
+/* ========================================================================== */
+
+/* Bootstage dumps are picked up from a directory by this suffix */
+#define FLEET_DUMP_SUFFIX	".bin"
+/* Kernel log next to a dump: <name>.log (syslog) or <name>.kmsg (dmesg) */
+/* boot_time_capture files (BOOT_CAPTURE_SUFFIX) are picked up as well */
+#define FLEET_LOG_SUFFIX	".log"
+#define FLEET_KMSG_SUFFIX	".kmsg"
+#define FLEET_MAX_THREADS	256
+
+typedef enum {
+	FLEET_DOMAIN_SUMMARY, /* SPL/U-Boot/handoff/kernel/total split */
+	FLEET_DOMAIN_BOOT, /* Bootloader and kernel records */
+	FLEET_DOMAIN_MCU, /* Remote core records; cores after the first are prefixed "<label>:" */
+	FLEET_DOMAINS,
+} fleet_domain_t;
+
+/* ========================================================================== */
+/*                           Data Structures                                  */
+/* ========================================================================== */
+
+/**
+ * One captured boot. log may be NULL when only the dump was captured.
+ */
+typedef struct {
+	char *dump;
+	char *log;
+} fleet_item_t;
+
+typedef struct {
+	fleet_item_t *items;
+	size_t count;
+	size_t cap;
+	/* Remote core table for every boot, or NULL for the default MCU block */
+	const boot_remote_core_t *remote;
+	int nremote;
+} fleet_input_t;
+
+/**
+ * Order statistics of one sample set, in nanoseconds.
+ */
+typedef struct {
+	uint64_t min;
+	uint64_t p50;
+	uint64_t p95;
+	uint64_t p99;
+	uint64_t max;
+	double mean;
+	double stddev;
+} fleet_stat_t;
+
+/**
+ * Distribution of one stage over all boots it was seen in.
+ */
+typedef struct {
+	fleet_domain_t domain;
+	uint32_t name; /* fleet_result_t.names index */
+	uint64_t samples;
+	fleet_stat_t start; /* Absolute time the stage was reached */
+	fleet_stat_t delta; /* Time since the previous stage */
+} fleet_row_t;
+
+typedef struct {
+	arena_t arena;
+	strtab_t names;
+	fleet_row_t *rows; /* Sorted by domain, then median start time */
+	size_t nrows;
+	uint64_t boots; /* Boots parsed */
+	uint64_t failed; /* Boots whose bootstage dump could not be read */
+	int threads;
+	double elapsed; /* Wall time of the parse and reduce, seconds */
+} fleet_result_t;
+
+/* ========================================================================== */
+/*                          Function Declarations                             */
+/* ========================================================================== */
+
+int fleet_input_add(fleet_input_t *in, const char *dump, const char *log);
+int fleet_input_load(fleet_input_t *in, const char *path);
+void fleet_input_free(fleet_input_t *in);
+
+int fleet_analyze(const fleet_input_t *in, int nthreads, fleet_result_t *res);
+void fleet_print(const fleet_result_t *res, boot_time_unit_t unit, FILE *fp);
+void fleet_export_json(const fleet_result_t *res, boot_time_unit_t unit, FILE *fp);
+void fleet_result_free(fleet_result_t *res);
+
+#endif /* FLEET_BATCH_H */
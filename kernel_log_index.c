@@ -0,0 +1,340 @@
+/*
+ *  Copyright (C) 2025 Texas Instruments Incorporated
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions
+ *  are met:
+ *
+ *    Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *
+ *    Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the
+ *    distribution.
+ *
+ *    Neither the name of Texas Instruments Incorporated nor the names of
+ *    its contributors may be used to endorse or promote products derived
+ *    from this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ *  "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ *  LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ *  A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ *  OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ *  SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ *  LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ *  DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ *  THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ *  (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ *  OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/**
+ * \file kernel_log_index.c
+ * \brief Sidecar index of the boots found in the kernel log.
+ *
+ * A boot starts at each BOOTSTAGE_KERNEL_START tracker line (or at the
+ * first tracker line of the log). The index stores how far the log has been
+ * scanned, so each run only scans what syslog appended since, and the boot
+ * table has fixed size entries so any boot is found with a single pread().
+ */
+
+/* ========================================================================== */
+/*                           Include Files                                    */
+/* ========================================================================== */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include <fcntl.h>
+#include <sys/file.h>
+#include <sys/stat.h>
+
+#include "boot_time_report.h"
+#include "kernel_log_index.h"
+#include "kernel_log_scan.h"
+
+
+/* ========================================================================== */
+/*                          Function Definitions                              */
+/* ========================================================================== */
+
+static uint64_t fnv1a(const uint8_t *p, size_t n)
+{
+	uint64_t h = 0xcbf29ce484222325ull;
+
+	while (n--) {
+		h ^= *p++;
+		h *= 0x100000001b3ull;
+	}
+	return h;
+}
+
+static off_t boot_entry_offset(uint32_t idx)
+{
+	return sizeof(klog_index_hdr_t) + (off_t)idx * sizeof(klog_index_boot_t);
+}
+
+static int index_open(const char *index_path)
+{
+	int fd = open(index_path, O_RDWR | O_CREAT, 0644);
+
+	if (fd < 0) {
+		/* Read-only log directory: keep the index for this run only */
+		fprintf(stderr, "Cannot open log index %s, using a temporary one\n",
+				index_path);
+		fd = open(P_tmpdir, O_TMPFILE | O_RDWR, 0600);
+	}
+	if (fd >= 0 && flock(fd, LOCK_EX) < 0) {
+		close(fd);
+		fd = -1;
+	}
+	return fd;
+}
+
+/*
+ * Brings the index open on fd up to date with the log and returns its
+ * header in hdr.
+ */
+static int index_update_fd(int fd, const char *log_path, int nthreads,
+		klog_index_hdr_t *hdr)
+{
+	uint8_t head[KLOG_INDEX_HEAD_BYTES];
+	klog_index_boot_t *boots = NULL;
+	kernel_log_scan_result_t res = { 0 };
+	uint32_t first = 0, nboots = 0, cap = 0;
+	struct stat st;
+	ssize_t head_len;
+	int logfd, ret = -1;
+
+	logfd = open(log_path, O_RDONLY);
+	if (logfd < 0) {
+		perror("Failed to open kernel log");
+		return -1;
+	}
+	if (fstat(logfd, &st) < 0) {
+		close(logfd);
+		return -1;
+	}
+	head_len = pread(logfd, head, sizeof(head), 0);
+	close(logfd);
+	if (head_len < 0)
+		return -1;
+
+	/* Start over if the index is stale: other file, truncated or rewritten */
+	if (pread(fd, hdr, sizeof(*hdr), 0) != sizeof(*hdr) ||
+			hdr->magic != KLOG_INDEX_MAGIC ||
+			hdr->version != KLOG_INDEX_VERSION ||
+			hdr->log_ino != (uint64_t)st.st_ino ||
+			hdr->scanned > (uint64_t)st.st_size ||
+			hdr->head_len > (uint32_t)head_len ||
+			hdr->head_hash != fnv1a(head, hdr->head_len)) {
+		memset(hdr, 0, sizeof(*hdr));
+		hdr->magic = KLOG_INDEX_MAGIC;
+		hdr->version = KLOG_INDEX_VERSION;
+		hdr->log_ino = st.st_ino;
+		if (ftruncate(fd, sizeof(*hdr)) < 0)
+			return -1;
+	}
+
+	if (hdr->scanned < (uint64_t)st.st_size) {
+		if (kernel_log_scan_file(log_path, hdr->scanned, st.st_size,
+					nthreads, &res) < 0)
+			goto out;
+
+		/* The open boot may still grow, so it is rewritten too */
+		first = hdr->boot_count;
+		if (first > 0) {
+			first--;
+			cap = 8;
+			boots = malloc(cap * sizeof(*boots));
+			if (!boots || pread(fd, boots, sizeof(*boots),
+						boot_entry_offset(first)) != sizeof(*boots))
+				goto out;
+			nboots = 1;
+		}
+
+		for (size_t i = 0; i < res.count; i++) {
+			const kernel_log_match_t *m = &res.matches[i];
+
+			/* A trailing partial line is picked up by the next run */
+			if (m->offset >= res.line_end)
+				break;
+			if (nboots == 0 || m->id == BOOTSTAGE_KERNEL_START) {
+				if (nboots == cap) {
+					klog_index_boot_t *n;
+					cap = cap ? cap * 2 : 8;
+					n = realloc(boots, cap * sizeof(*boots));
+					if (!n)
+						goto out;
+					boots = n;
+				}
+				if (nboots)
+					boots[nboots - 1].end = m->offset;
+				memset(&boots[nboots], 0, sizeof(boots[nboots]));
+				boots[nboots].start = m->offset;
+				nboots++;
+			}
+			boots[nboots - 1].records++;
+			if (m->id == BOOTSTAGE_KERNEL_END)
+				boots[nboots - 1].flags |= KLOG_BOOT_HAS_KERNEL_END;
+		}
+
+		if (res.line_end > hdr->scanned) {
+			if (nboots)
+				boots[nboots - 1].end = res.line_end;
+			hdr->scanned = res.line_end;
+		}
+		if (nboots && pwrite(fd, boots, nboots * sizeof(*boots),
+					boot_entry_offset(first)) != (ssize_t)(nboots * sizeof(*boots)))
+			goto out;
+		hdr->boot_count = first + nboots;
+	}
+
+	hdr->head_len = head_len;
+	hdr->head_hash = fnv1a(head, head_len);
+	if (pwrite(fd, hdr, sizeof(*hdr), 0) != sizeof(*hdr))
+		goto out;
+	ret = 0;
+out:
+	if (ret < 0)
+		fprintf(stderr, "Failed to update kernel log index\n");
+	kernel_log_scan_free(&res);
+	free(boots);
+	return ret;
+}
+
+/**
+ * @brief Updates the index of a kernel log.
+ *
+ * Only the bytes appended to the log since the previous update are
+ * scanned. The index is rebuilt from scratch when the log was rotated,
+ * truncated or rewritten.
+ *
+ * @param log_path Kernel log file.
+ * @param index_path Sidecar index file, created if missing.
+ * @param nthreads Scanner thread count, see kernel_log_scan_buffer().
+ * @param hdr Receives the updated index header.
+ * @return int 0 on success, -1 on failure.
+ */
+int kernel_log_index_update(const char *log_path, const char *index_path,
+		int nthreads, klog_index_hdr_t *hdr)
+{
+	int fd = index_open(index_path);
+	int ret;
+
+	if (fd < 0)
+		return -1;
+	ret = index_update_fd(fd, log_path, nthreads, hdr);
+	close(fd);
+	return ret;
+}
+
+/**
+ * @brief Locates one boot in the kernel log.
+ *
+ * @param log_path Kernel log file.
+ * @param index_path Sidecar index file.
+ * @param boot Relative boot index: 0 is the latest boot, -1 the one
+ * before, and so on.
+ * @param nthreads Scanner thread count used for the index update.
+ * @param out Receives the byte range of the selected boot.
+ * @param boot_count Receives the number of boots in the log.
+ * @return int 0 on success, 1 if the boot is older than the log (e.g.
+ * rotated out), -1 on failure.
+ */
+int kernel_log_index_lookup(const char *log_path, const char *index_path,
+		int boot, int nthreads, klog_index_boot_t *out, uint32_t *boot_count)
+{
+	klog_index_hdr_t hdr;
+	int64_t idx;
+	int fd, ret = -1;
+
+	if (boot > 0) {
+		fprintf(stderr, "Boot %d not found, boots are counted back from 0\n", boot);
+		return -1;
+	}
+	fd = index_open(index_path);
+	if (fd < 0)
+		return -1;
+	if (index_update_fd(fd, log_path, nthreads, &hdr) < 0)
+		goto out;
+
+	*boot_count = hdr.boot_count;
+	idx = (int64_t)hdr.boot_count - 1 + boot;
+	if (idx < 0)
+		ret = 1;
+	else if (pread(fd, out, sizeof(*out), boot_entry_offset(idx)) == sizeof(*out))
+		ret = 0;
+out:
+	close(fd);
+	return ret;
+}
+
+/*
+ * A tracker line opens a boot if it is BOOTSTAGE_KERNEL_START or the first
+ * one seen, the rule index_update_fd() applies.
+ */
+static int opens_boot(const kernel_log_match_t *m, uint32_t nboots)
+{
+	return m->marker == LOG_MARKER_TRACKER &&
+		(nboots == 0 || m->id == BOOTSTAGE_KERNEL_START);
+}
+
+/**
+ * @brief Splits the tracker lines of a scan into boots, as the index does,
+ * and locates one of them.
+ *
+ * Used where no index is kept: logs scanned with indexing disabled, fleet
+ * inputs and rotated segments.
+ *
+ * @param res Scan result; marker lines do not delimit boots.
+ * @param boot Relative boot index: 0 is the latest boot, -1 the one
+ * before, and so on.
+ * @param out Receives the byte range of the selected boot; end is 0 for
+ * the last boot, which runs to the end of the log.
+ * @param boot_count Receives the number of boots in the scan.
+ * @return int 0 on success, 1 if the boot is older than the scan, -1 if
+ * boot is positive.
+ */
+int kernel_log_split_boots(const kernel_log_scan_result_t *res, int boot,
+		klog_index_boot_t *out, uint32_t *boot_count)
+{
+	uint32_t nboots = 0, idx;
+	size_t i;
+
+	if (boot > 0) {
+		fprintf(stderr, "Boot %d not found, boots are counted back from 0\n", boot);
+		return -1;
+	}
+	for (i = 0; i < res->count; i++)
+		nboots += opens_boot(&res->matches[i], nboots);
+	*boot_count = nboots;
+	if ((int64_t)nboots - 1 + boot < 0)
+		return 1;
+	idx = nboots - 1 + boot;
+
+	memset(out, 0, sizeof(*out));
+	nboots = 0;
+	for (i = 0; i < res->count; i++) {
+		const kernel_log_match_t *m = &res->matches[i];
+
+		if (opens_boot(m, nboots)) {
+			if (nboots == idx + 1) {
+				out->end = m->offset;
+				break;
+			}
+			if (nboots == idx)
+				out->start = m->offset;
+			nboots++;
+		}
+		if (nboots != idx + 1 || m->marker != LOG_MARKER_TRACKER)
+			continue;
+		out->records++;
+		if (m->id == BOOTSTAGE_KERNEL_END)
+			out->flags |= KLOG_BOOT_HAS_KERNEL_END;
+	}
+	return 0;
+}
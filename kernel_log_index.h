@@ -0,0 +1,101 @@
+/*
+ *  Copyright (C) 2025 Texas Instruments Incorporated
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions
+ *  are met:
+ *
+ *    Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *
+ *    Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the
+ *    distribution.
+ *
+ *    Neither the name of Texas Instruments Incorporated nor the names of
+ *    its contributors may be used to endorse or promote products derived
+ *    from this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ *  "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ *  LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ *  A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ *  OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ *  SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ *  LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ *  DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ *  THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ *  (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ *  OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/**
+ * \file kernel_log_index.h
+ * \brief Persistent sidecar index splitting the kernel log into boots, kept
+ * up to date by scanning only the bytes appended since the previous run.
+ */
+
+#ifndef KERNEL_LOG_INDEX_H
+#define KERNEL_LOG_INDEX_H
+
+/* ========================================================================== */
+/*                           Include Files                                    */
+/* ========================================================================== */
+#include <stdint.h>
+#include <stddef.h>
+
+#include "kernel_log_scan.h"
+
+/* ========================================================================== */
+/*                           Macros & Typedefs                                */
+/* ========================================================================== */
+
+#define KLOG_INDEX_MAGIC		0x58495442 /* "BTIX" */
+#define KLOG_INDEX_VERSION		1
+#define KLOG_INDEX_SUFFIX		".btidx"
+/* Leading log bytes hashed to notice rotation or rewrite of the log */
+#define KLOG_INDEX_HEAD_BYTES		256
+
+/* Boot entry flags */
+#define KLOG_BOOT_HAS_KERNEL_END	(1u << 0)
+
+/* ========================================================================== */
+/*                           Data Structures                                  */
+/* ========================================================================== */
+
+/**
+ * On-disk index header, followed by boot_count klog_index_boot_t entries.
+ */
+typedef struct {
+	uint32_t magic;
+	uint32_t version;
+	uint64_t log_ino; /* Inode of the indexed log */
+	uint64_t scanned; /* Log bytes indexed so far, always a line boundary */
+	uint64_t head_hash; /* FNV-1a of the first head_len log bytes */
+	uint32_t head_len;
+	uint32_t boot_count;
+} klog_index_hdr_t;
+
+/**
+ * One boot in the log: [start, end) covers its tracker lines.
+ */
+typedef struct {
+	uint64_t start; /* Offset of the line opening the boot */
+	uint64_t end; /* Start of the next boot, or end of indexed data */
+	uint32_t records; /* Tracker lines seen in the boot */
+	uint32_t flags;
+} klog_index_boot_t;
+
+/* ========================================================================== */
+/*                          Function Declarations                             */
+/* ========================================================================== */
+
+int kernel_log_index_update(const char *log_path, const char *index_path,
+		int nthreads, klog_index_hdr_t *hdr);
+int kernel_log_index_lookup(const char *log_path, const char *index_path,
+		int boot, int nthreads, klog_index_boot_t *out, uint32_t *boot_count);
+int kernel_log_split_boots(const kernel_log_scan_result_t *res, int boot,
+		klog_index_boot_t *out, uint32_t *boot_count);
+
+#endif /* KERNEL_LOG_INDEX_H */
@@ -0,0 +1,756 @@
+/*
+ *  Copyright (C) 2025 Texas Instruments Incorporated
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions
+ *  are met:
+ *
+ *    Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *
+ *    Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the
+ *    distribution.
+ *
+ *    Neither the name of Texas Instruments Incorporated nor the names of
+ *    its contributors may be used to endorse or promote products derived
+ *    from this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ *  "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ *  LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ *  A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ *  OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ *  SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ *  LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ *  DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ *  THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ *  (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ *  OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/**
+ * \file kernel_log_scan.c
+ * \brief Scanner for "[BOOT TRACKER]" lines and initcall_debug return
+ * lines. The log is memory mapped, both tags are located in one vectorised
+ * substring search and large inputs are split on line boundaries into
+ * chunks scanned on several cores, whose results are merged back in file
+ * order.
+ */
+
+/* ========================================================================== */
+/*                           Include Files                                    */
+/* ========================================================================== */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include <fcntl.h>
+#include <pthread.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+
+#if defined(__AVX2__) || defined(__SSE2__)
+#include <immintrin.h>
+#elif defined(__ARM_NEON)
+#include <arm_neon.h>
+#endif
+
+#include "kernel_log_scan.h"
+
+/* ========================================================================== */
+/*                           Macros & Typedefs                                */
+/* ========================================================================== */
+
+/*
+ * The SIMD filter compares two tag bytes at a fixed distance before doing a
+ * full compare. '[' and ']' are a poor pair since every printk time stamp
+ * "[    2.522000]" has them exactly 13 bytes apart, so 'B' and 'K' are used.
+ */
+#define TAG_FILTER_A	1
+#define TAG_FILTER_B	10
+/* "returned ": 'u' and 'd' are rarer together than 'r' and 'e' */
+#define CALL_FILTER_A	3
+#define CALL_FILTER_B	7
+
+typedef struct {
+	const char *str;
+	size_t len;
+	int fa; /* Offsets of the two filter bytes */
+	int fb;
+} scan_pattern_t;
+
+/* Pattern indices match the built-in markers of log_marker_set_t */
+enum {
+	SCAN_TRACKER = LOG_MARKER_TRACKER,
+	SCAN_CALL = LOG_MARKER_CALL,
+	SCAN_PATTERNS,
+};
+
+typedef struct {
+	const char *buf; /* Start of the whole buffer */
+	const char *begin; /* Chunk handled by this job */
+	const char *end;
+	uint64_t base;
+	kernel_log_scan_result_t res;
+	int err;
+} scan_job_t;
+
+
+/* ========================================================================== */
+/*                          Global Variables                                  */
+/* ========================================================================== */
+
+static const scan_pattern_t scan_patterns[SCAN_PATTERNS] = {
+	[SCAN_TRACKER] = { BOOT_TRACKER_TAG, BOOT_TRACKER_TAG_LEN,
+		TAG_FILTER_A, TAG_FILTER_B },
+	[SCAN_CALL] = { KERNEL_LOG_CALL_TAG, KERNEL_LOG_CALL_TAG_LEN,
+		CALL_FILTER_A, CALL_FILTER_B },
+};
+
+
+/* ========================================================================== */
+/*                          Function Definitions                              */
+/* ========================================================================== */
+
+/*
+ * Finds the first of npat scan_patterns[] in [p, end) and stores its index
+ * in which. Inlined with a constant npat, so a tracker-only scan pays
+ * nothing for the call pattern.
+ */
+static inline __attribute__((always_inline)) const char *
+find_patterns(const char *p, const char *end, int npat, int *which)
+{
+	const scan_pattern_t *pat = scan_patterns;
+	const size_t n = BOOT_TRACKER_TAG_LEN; /* Longest pattern */
+
+	if (p >= end)
+		return NULL;
+
+#if defined(__AVX2__)
+	__m256i fa[SCAN_PATTERNS], fb[SCAN_PATTERNS];
+
+	for (int k = 0; k < npat; k++) {
+		fa[k] = _mm256_set1_epi8(pat[k].str[pat[k].fa]);
+		fb[k] = _mm256_set1_epi8(pat[k].str[pat[k].fb]);
+	}
+	while ((size_t)(end - p) >= 32 + n - 1) {
+		uint32_t mask = 0;
+		for (int k = 0; k < npat; k++) {
+			__m256i a = _mm256_loadu_si256((const __m256i *)(p + pat[k].fa));
+			__m256i b = _mm256_loadu_si256((const __m256i *)(p + pat[k].fb));
+			mask |= _mm256_movemask_epi8(_mm256_and_si256(
+					_mm256_cmpeq_epi8(a, fa[k]), _mm256_cmpeq_epi8(b, fb[k])));
+		}
+		while (mask) {
+			int bit = __builtin_ctz(mask);
+			for (int k = 0; k < npat; k++)
+				if (memcmp(p + bit, pat[k].str, pat[k].len) == 0) {
+					*which = k;
+					return p + bit;
+				}
+			mask &= mask - 1;
+		}
+		p += 32;
+	}
+#elif defined(__SSE2__)
+	__m128i fa[SCAN_PATTERNS], fb[SCAN_PATTERNS];
+
+	for (int k = 0; k < npat; k++) {
+		fa[k] = _mm_set1_epi8(pat[k].str[pat[k].fa]);
+		fb[k] = _mm_set1_epi8(pat[k].str[pat[k].fb]);
+	}
+	while ((size_t)(end - p) >= 16 + n - 1) {
+		uint32_t mask = 0;
+		for (int k = 0; k < npat; k++) {
+			__m128i a = _mm_loadu_si128((const __m128i *)(p + pat[k].fa));
+			__m128i b = _mm_loadu_si128((const __m128i *)(p + pat[k].fb));
+			mask |= _mm_movemask_epi8(_mm_and_si128(
+					_mm_cmpeq_epi8(a, fa[k]), _mm_cmpeq_epi8(b, fb[k])));
+		}
+		while (mask) {
+			int bit = __builtin_ctz(mask);
+			for (int k = 0; k < npat; k++)
+				if (memcmp(p + bit, pat[k].str, pat[k].len) == 0) {
+					*which = k;
+					return p + bit;
+				}
+			mask &= mask - 1;
+		}
+		p += 16;
+	}
+#elif defined(__ARM_NEON)
+	uint8x16_t fa[SCAN_PATTERNS], fb[SCAN_PATTERNS];
+
+	for (int k = 0; k < npat; k++) {
+		fa[k] = vdupq_n_u8(pat[k].str[pat[k].fa]);
+		fb[k] = vdupq_n_u8(pat[k].str[pat[k].fb]);
+	}
+	while ((size_t)(end - p) >= 16 + n - 1) {
+		uint8x16_t eq = vdupq_n_u8(0);
+		for (int k = 0; k < npat; k++) {
+			uint8x16_t a = vld1q_u8((const uint8_t *)(p + pat[k].fa));
+			uint8x16_t b = vld1q_u8((const uint8_t *)(p + pat[k].fb));
+			eq = vorrq_u8(eq, vandq_u8(vceqq_u8(a, fa[k]), vceqq_u8(b, fb[k])));
+		}
+		/* Narrow to a 64-bit mask holding 4 bits per byte lane */
+		uint64_t mask = vget_lane_u64(vreinterpret_u64_u8(
+				vshrn_n_u16(vreinterpretq_u16_u8(eq), 4)), 0);
+		while (mask) {
+			int bit = __builtin_ctzll(mask) >> 2;
+			for (int k = 0; k < npat; k++)
+				if (memcmp(p + bit, pat[k].str, pat[k].len) == 0) {
+					*which = k;
+					return p + bit;
+				}
+			mask &= ~(0xfull << (bit * 4));
+		}
+		p += 16;
+	}
+#else
+	/* Portable fallback: let memchr() skip to the rarer filter byte */
+	while (npat == 1 && (size_t)(end - p) >= n) {
+		const char *k = memchr(p + TAG_FILTER_B, pat[0].str[TAG_FILTER_B],
+				(end - p) - TAG_FILTER_B);
+		if (!k)
+			return NULL;
+		p = k - TAG_FILTER_B;
+		if ((size_t)(end - p) < n)
+			return NULL;
+		if (memcmp(p, pat[0].str, n) == 0) {
+			*which = 0;
+			return p;
+		}
+		p++;
+	}
+#endif
+	/* Tail shorter than one vector */
+	for (; p < end; p++)
+		for (int k = 0; k < npat; k++)
+			if ((size_t)(end - p) >= pat[k].len && p[pat[k].fb] == pat[k].str[pat[k].fb] &&
+					memcmp(p, pat[k].str, pat[k].len) == 0) {
+				*which = k;
+				return p;
+			}
+	return NULL;
+}
+
+/**
+ * @brief Finds the next "[BOOT TRACKER]" tag in [p, end).
+ *
+ * @return const char* Pointer to the tag, or NULL if there is none.
+ */
+const char *kernel_log_find_tag(const char *p, const char *end)
+{
+	int which;
+
+	return find_patterns(p, end, 1, &which);
+}
+
+static const char *parse_u64(const char *p, const char *end, uint64_t *val)
+{
+	const char *start = p;
+	uint64_t v = 0;
+
+	while (p < end && *p >= '0' && *p <= '9')
+		v = v * 10 + (*p++ - '0');
+	*val = v;
+	return (p == start) ? NULL : p;
+}
+
+/**
+ * @brief Decodes "ID:<id> <name> = <time>" following a tracker tag.
+ *
+ * Hand written replacement for the former
+ * sscanf("%*[^I]ID:%d%*[^=]=%u") on the whole line.
+ *
+ * @param tag Pointer to the "[BOOT TRACKER]" tag.
+ * @param eol End of the line.
+ * @param id Decoded bootstage id.
+ * @param time_us Decoded time stamp.
+ * @return int 0 on success, -1 if the line is malformed.
+ */
+int kernel_log_decode_line(const char *tag, const char *eol, int *id, uint64_t *time_us)
+{
+	const char *p = tag + BOOT_TRACKER_TAG_LEN;
+	uint64_t v;
+	int neg = 0;
+
+	for (; eol - p >= 3; p++)
+		if (p[0] == 'I' && p[1] == 'D' && p[2] == ':')
+			break;
+	if (eol - p < 3)
+		return -1;
+	p += 3;
+
+	while (p < eol && *p == ' ')
+		p++;
+	if (p < eol && *p == '-') {
+		neg = 1;
+		p++;
+	}
+	p = parse_u64(p, eol, &v);
+	if (!p)
+		return -1;
+	*id = neg ? -(int)v : (int)v;
+
+	p = memchr(p, '=', eol - p);
+	if (!p)
+		return -1;
+	p++;
+	while (p < eol && (*p == ' ' || *p == '\t'))
+		p++;
+	if (!parse_u64(p, eol, time_us))
+		return -1;
+	return 0;
+}
+
+/*
+ * Returns the printk time stamp "[    2.522000]" found in [p, limit), or
+ * KERNEL_LOG_NO_TS. Syslog puts its own prefix before it.
+ */
+static uint64_t parse_printk_ts(const char *p, const char *limit)
+{
+	while (p < limit && (p = memchr(p, '[', limit - p)) != NULL) {
+		const char *q = p + 1, *frac_start;
+		uint64_t sec, frac;
+
+		while (q < limit && *q == ' ')
+			q++;
+		q = parse_u64(q, limit, &sec);
+		if (q && q < limit && *q == '.') {
+			frac_start = q + 1;
+			q = parse_u64(frac_start, limit, &frac);
+			if (q && q < limit && *q == ']') {
+				for (int digits = q - frac_start; digits < 6; digits++)
+					frac *= 10;
+				for (int digits = q - frac_start; digits > 6; digits--)
+					frac /= 10;
+				return sec * 1000000 + frac;
+			}
+		}
+		p++;
+	}
+	return KERNEL_LOG_NO_TS;
+}
+
+/*
+ * Decodes "returned <ret> after <n> usecs" at the tag of an initcall_debug
+ * return line. Returns the end of the match, or NULL for other lines.
+ */
+static const char *decode_call_return(const char *tag, const char *end,
+		kernel_log_call_t *call)
+{
+	const char *p = tag + KERNEL_LOG_CALL_TAG_LEN;
+	uint64_t v;
+	int neg = 0;
+
+	if (p < end && *p == '-') {
+		neg = 1;
+		p++;
+	}
+	p = parse_u64(p, end, &v);
+	if (!p || end - p < 7 || memcmp(p, " after ", 7) != 0)
+		return NULL;
+	call->ret = neg ? -(int)v : (int)v;
+	p = parse_u64(p + 7, end, &call->dur_us);
+	if (!p || end - p < 6 || memcmp(p, " usecs", 6) != 0)
+		return NULL;
+	return p + 6;
+}
+
+/*
+ * Finds the kind and the function or device name of a return line:
+ *   initcall <fn>+0x0/0x3c returned <ret> after <n> usecs
+ *   probe of <dev> returned <ret> after <n> usecs
+ *   <drv> <dev>: probe with driver <drv> returned <ret> after <n> usecs
+ * Returns -1 for any other line.
+ */
+static int decode_call_name(const char *bol, const char *tag, kernel_log_call_t *call)
+{
+	const char *n, *ne = tag - 1; /* The space before "returned" */
+	size_t len;
+
+	if ((n = memmem(bol, tag - bol, "initcall ", 9)) != NULL) {
+		call->kind = KERNEL_LOG_INITCALL;
+		n += 9;
+		/* Drop the "+0x0/0x3c" symbol offset */
+		for (const char *q = n; q < ne; q++)
+			if (*q == '+' || *q == ' ') {
+				ne = q;
+				break;
+			}
+	} else if ((n = memmem(bol, tag - bol, "probe of ", 9)) != NULL) {
+		call->kind = KERNEL_LOG_PROBE;
+		n += 9;
+	} else if ((n = memmem(bol, tag - bol, ": probe with driver ", 20)) != NULL) {
+		/* dev_info() prefix "<drv> <dev>: ": name the device */
+		call->kind = KERNEL_LOG_PROBE;
+		ne = n;
+		while (n > bol && n[-1] != ' ')
+			n--;
+	} else {
+		return -1;
+	}
+	if (ne <= n)
+		return -1;
+	len = ne - n;
+	if (len >= sizeof(call->name))
+		len = sizeof(call->name) - 1;
+	memcpy(call->name, n, len);
+	call->name[len] = '\0';
+	return 0;
+}
+
+/*
+ * Keeps call if it is among the call_top longest seen so far. calls is a
+ * min-heap on dur_us, so the shortest kept call is replaced in O(log n).
+ */
+static int call_heap_push(kernel_log_scan_result_t *res, const kernel_log_call_t *call)
+{
+	kernel_log_call_t *h = res->calls;
+	size_t n = res->call_count;
+	size_t i;
+
+	if (!h) {
+		h = malloc(res->call_top * sizeof(*h));
+		if (!h)
+			return -1;
+		res->calls = h;
+	}
+	if (n < res->call_top) {
+		for (i = res->call_count++; i > 0 && h[(i - 1) / 2].dur_us > call->dur_us;
+				i = (i - 1) / 2)
+			h[i] = h[(i - 1) / 2];
+		h[i] = *call;
+		return 0;
+	}
+	if (call->dur_us <= h[0].dur_us)
+		return 0;
+	for (i = 0; 2 * i + 1 < n; ) {
+		size_t c = 2 * i + 1;
+
+		if (c + 1 < n && h[c + 1].dur_us < h[c].dur_us)
+			c++;
+		if (h[c].dur_us >= call->dur_us)
+			break;
+		h[i] = h[c];
+		i = c;
+	}
+	h[i] = *call;
+	return 0;
+}
+
+/*
+ * Handles the return line whose tag is at tag and returns where scanning
+ * resumes, or NULL on allocation failure. Only the calls that make it into
+ * the heap pay for finding their line start and name.
+ */
+static const char *scan_call(scan_job_t *job, const char *tag)
+{
+	kernel_log_scan_result_t *res = &job->res;
+	kernel_log_call_t call;
+	const char *next, *bol;
+
+	next = decode_call_return(tag, job->end, &call);
+	if (!next)
+		return tag + KERNEL_LOG_CALL_TAG_LEN;
+	res->call_lines++;
+	if (res->call_count == res->call_top && call.dur_us <= res->calls[0].dur_us)
+		return next;
+
+	for (bol = tag; bol > job->begin && bol[-1] != '\n'; bol--)
+		;
+	if (decode_call_name(bol, tag, &call) < 0) {
+		res->call_lines--;
+		return next;
+	}
+	call.offset = job->base + (bol - job->buf);
+	call.ts_us = parse_printk_ts(bol, tag);
+	return call_heap_push(res, &call) < 0 ? NULL : next;
+}
+
+static int scan_result_push(kernel_log_scan_result_t *res, const kernel_log_match_t *m)
+{
+	if (res->count == res->cap) {
+		size_t cap = res->cap ? res->cap * 2 : 64;
+		kernel_log_match_t *n = realloc(res->matches, cap * sizeof(*n));
+		if (!n)
+			return -1;
+		res->matches = n;
+		res->cap = cap;
+	}
+	res->matches[res->count++] = *m;
+	return 0;
+}
+
+static void *scan_chunk(void *arg)
+{
+	scan_job_t *job = arg;
+	const char *p = job->begin;
+	log_marker_cursor_t cur;
+	const char *tag;
+	int which;
+
+	log_marker_cursor_init(&cur, job->begin);
+	for (;;) {
+		const char *bol, *eol;
+		kernel_log_match_t m;
+		int ok;
+
+		/*
+		 * All tags are looked for in the same pass over the chunk. The
+		 * SIMD search resumes at p, past the tag's line; the automaton
+		 * goes on from its cursor, so the markers sharing a line or
+		 * overlapping the built-in tags are all seen.
+		 */
+		if (job->res.markers)
+			tag = log_marker_find(job->res.markers, &cur, job->end, &which);
+		else if (job->res.call_top)
+			tag = find_patterns(p, job->end, SCAN_PATTERNS, &which);
+		else
+			tag = find_patterns(p, job->end, 1, &which);
+		if (!tag)
+			break;
+		if (which == SCAN_CALL) {
+			p = job->res.call_top ? scan_call(job, tag) : tag + KERNEL_LOG_CALL_TAG_LEN;
+			if (!p) {
+				job->err = -1;
+				break;
+			}
+			continue;
+		}
+
+		bol = tag;
+		eol = memchr(tag, '\n', job->end - tag);
+		if (!eol)
+			eol = job->end;
+		while (bol > job->begin && bol[-1] != '\n')
+			bol--;
+		if (which == SCAN_TRACKER) {
+			ok = kernel_log_decode_line(tag, eol, &m.id, &m.time_us) == 0;
+		} else {
+			const log_marker_t *mk = &job->res.markers->markers[which];
+
+			ok = log_marker_decode(mk, tag, eol, &m.time_us) == 0;
+			m.id = mk->id;
+		}
+		if (ok) {
+			m.marker = which;
+			m.offset = job->base + (bol - job->buf);
+			m.ts_us = parse_printk_ts(bol, tag);
+			/* A marker timed by printk needs a printk time stamp */
+			if (m.time_us == KERNEL_LOG_NO_TS && m.ts_us == KERNEL_LOG_NO_TS)
+				ok = 0;
+		}
+		if (ok && scan_result_push(&job->res, &m) < 0) {
+			job->err = -1;
+			break;
+		}
+		p = eol;
+	}
+	job->res.bytes_scanned = job->end - job->begin;
+	return NULL;
+}
+
+/**
+ * @brief Scans a buffer holding log text for tracker lines.
+ *
+ * Inputs larger than KERNEL_LOG_SCAN_MIN_CHUNK are split on line
+ * boundaries and scanned by up to nthreads threads. Matches are appended
+ * to res in buffer order. With res->call_top set, the same pass also keeps
+ * the res->call_top longest initcalls and probes in res->calls. With
+ * res->markers set, the configured markers are matched too, by their
+ * Aho-Corasick automaton instead of the SIMD tag search.
+ *
+ * @param buf Log text.
+ * @param len Length of buf.
+ * @param base File offset of buf[0], used for kernel_log_match_t.offset.
+ * @param nthreads Maximum thread count, or <= 0 for one per online CPU.
+ * @param res Result to append to; must be zeroed before first use.
+ * @return int 0 on success, -1 on allocation or thread failure.
+ */
+int kernel_log_scan_buffer(const char *buf, size_t len, uint64_t base,
+		int nthreads, kernel_log_scan_result_t *res)
+{
+	scan_job_t jobs[KERNEL_LOG_SCAN_MAX_THREADS];
+	pthread_t tids[KERNEL_LOG_SCAN_MAX_THREADS];
+	const char *end = buf + len;
+	const char *p = buf;
+	int njobs = 0, err = 0;
+	size_t total = 0;
+
+	if (nthreads <= 0)
+		nthreads = (int)sysconf(_SC_NPROCESSORS_ONLN);
+	if (nthreads > KERNEL_LOG_SCAN_MAX_THREADS)
+		nthreads = KERNEL_LOG_SCAN_MAX_THREADS;
+	if (nthreads < 1)
+		nthreads = 1;
+	if ((size_t)nthreads > len / KERNEL_LOG_SCAN_MIN_CHUNK)
+		nthreads = len / KERNEL_LOG_SCAN_MIN_CHUNK ? len / KERNEL_LOG_SCAN_MIN_CHUNK : 1;
+
+	/* Cut the input on line boundaries so no line spans two chunks */
+	for (int i = 0; i < nthreads && p < end; i++) {
+		const char *cend = (i == nthreads - 1) ? end : p + len / nthreads;
+		if (cend < end) {
+			const char *nl = memchr(cend, '\n', end - cend);
+			cend = nl ? nl + 1 : end;
+		}
+		memset(&jobs[njobs], 0, sizeof(jobs[njobs]));
+		jobs[njobs].buf = buf;
+		jobs[njobs].begin = p;
+		jobs[njobs].end = cend;
+		jobs[njobs].base = base;
+		jobs[njobs].res.call_top = res->call_top;
+		jobs[njobs].res.markers = res->markers;
+		njobs++;
+		p = cend;
+	}
+
+	if (njobs == 1) {
+		scan_chunk(&jobs[0]);
+	} else {
+		for (int i = 1; i < njobs; i++)
+			if (pthread_create(&tids[i], NULL, scan_chunk, &jobs[i]) != 0) {
+				/* Fall back to scanning this chunk inline */
+				tids[i] = 0;
+				scan_chunk(&jobs[i]);
+			}
+		scan_chunk(&jobs[0]);
+		for (int i = 1; i < njobs; i++)
+			if (tids[i])
+				pthread_join(tids[i], NULL);
+	}
+
+	/* Remember where the last complete line ends for incremental callers */
+	for (p = end; p > buf && p[-1] != '\n'; p--)
+		;
+	if (p > buf)
+		res->line_end = base + (p - buf);
+
+	/* Merge per-chunk results in file order */
+	for (int i = 0; i < njobs; i++) {
+		total += jobs[i].res.count;
+		err |= jobs[i].err;
+	}
+	if (!err && res->count + total > res->cap) {
+		kernel_log_match_t *n = realloc(res->matches,
+				(res->count + total) * sizeof(*n));
+		if (n) {
+			res->matches = n;
+			res->cap = res->count + total;
+		} else {
+			err = -1;
+		}
+	}
+	for (int i = 0; i < njobs; i++) {
+		if (!err && jobs[i].res.count) {
+			memcpy(res->matches + res->count, jobs[i].res.matches,
+					jobs[i].res.count * sizeof(kernel_log_match_t));
+			res->count += jobs[i].res.count;
+		}
+		res->bytes_scanned += jobs[i].res.bytes_scanned;
+		res->call_lines += jobs[i].res.call_lines;
+		for (size_t c = 0; c < jobs[i].res.call_count && !err; c++)
+			err |= call_heap_push(res, &jobs[i].res.calls[c]);
+		free(jobs[i].res.matches);
+		free(jobs[i].res.calls);
+	}
+	return err ? -1 : 0;
+}
+
+/**
+ * @brief Memory maps a log file and scans [start, end) for tracker lines.
+ *
+ * @param path Log file.
+ * @param start First byte to scan.
+ * @param end End of the scan, or 0 to scan up to the end of file.
+ * @param nthreads See kernel_log_scan_buffer().
+ * @param res Result to append to.
+ * @return int 0 on success, -1 on failure.
+ */
+int kernel_log_scan_file(const char *path, off_t start, off_t end,
+		int nthreads, kernel_log_scan_result_t *res)
+{
+	long page = sysconf(_SC_PAGESIZE);
+	struct stat st;
+	off_t map_start;
+	size_t map_len;
+	void *addr;
+	int fd, ret;
+
+	fd = open(path, O_RDONLY);
+	if (fd < 0) {
+		perror("Failed to open kernel log");
+		return -1;
+	}
+	if (fstat(fd, &st) < 0) {
+		perror("fstat");
+		close(fd);
+		return -1;
+	}
+	if (end == 0 || end > st.st_size)
+		end = st.st_size;
+	if (start >= end) {
+		close(fd);
+		return 0;
+	}
+
+	map_start = start & ~((off_t)page - 1);
+	map_len = end - map_start;
+	addr = mmap(NULL, map_len, PROT_READ, MAP_PRIVATE, fd, map_start);
+	close(fd);
+	if (addr == MAP_FAILED) {
+		perror("mmap");
+		return -1;
+	}
+	madvise(addr, map_len, MADV_SEQUENTIAL);
+
+	ret = kernel_log_scan_buffer((const char *)addr + (start - map_start),
+			end - start, start, nthreads, res);
+	munmap(addr, map_len);
+	return ret;
+}
+
+/**
+ * @brief Appends the matches of src that lie in [start, end) to dst.
+ *
+ * @param dst Result to append to.
+ * @param src Result to copy from.
+ * @param start First offset kept.
+ * @param end Offset past the last one kept.
+ * @return int 0 on success, -1 on allocation failure.
+ */
+int kernel_log_scan_copy(kernel_log_scan_result_t *dst,
+		const kernel_log_scan_result_t *src, uint64_t start, uint64_t end)
+{
+	for (size_t i = 0; i < src->count; i++) {
+		const kernel_log_match_t *m = &src->matches[i];
+
+		if (m->offset < start || m->offset >= end)
+			continue;
+		if (dst->count == dst->cap) {
+			size_t cap = dst->cap ? dst->cap * 2 : 64;
+			kernel_log_match_t *n = realloc(dst->matches, cap * sizeof(*n));
+
+			if (!n)
+				return -1;
+			dst->matches = n;
+			dst->cap = cap;
+		}
+		dst->matches[dst->count++] = *m;
+	}
+	return 0;
+}
+
+/**
+ * @brief Releases the matches and calls held by a scan result.
+ */
+void kernel_log_scan_free(kernel_log_scan_result_t *res)
+{
+	free(res->matches);
+	free(res->calls);
+	memset(res, 0, sizeof(*res));
+}
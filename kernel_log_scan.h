@@ -0,0 +1,130 @@
+/*
+ *  Copyright (C) 2025 Texas Instruments Incorporated
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions
+ *  are met:
+ *
+ *    Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *
+ *    Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the
+ *    distribution.
+ *
+ *    Neither the name of Texas Instruments Incorporated nor the names of
+ *    its contributors may be used to endorse or promote products derived
+ *    from this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ *  "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ *  LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ *  A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ *  OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ *  SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ *  LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ *  DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ *  THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ *  (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ *  OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/**
+ * \file kernel_log_scan.h
+ * \brief Memory mapped, vectorised and chunk parallel scanner for the
+ * "[BOOT TRACKER]" lines written by the kernel into the system log, and for
+ * the initcall and probe durations logged with initcall_debug.
+ */
+
+#ifndef KERNEL_LOG_SCAN_H
+#define KERNEL_LOG_SCAN_H
+
+/* ========================================================================== */
+/*                           Include Files                                    */
+/* ========================================================================== */
+#include <stdint.h>
+#include <stddef.h>
+#include <sys/types.h>
+
+#include "log_marker.h"
+
+/* ========================================================================== */
+/*                           Macros & Typedefs                                */
+/* ========================================================================== */
+
+#define BOOT_TRACKER_TAG		"[BOOT TRACKER]"
+#define BOOT_TRACKER_TAG_LEN		(sizeof(BOOT_TRACKER_TAG) - 1)
+
+/* "initcall <fn> returned <ret> after <n> usecs", "probe of <dev> returned ..." */
+#define KERNEL_LOG_CALL_TAG		"returned "
+#define KERNEL_LOG_CALL_TAG_LEN		(sizeof(KERNEL_LOG_CALL_TAG) - 1)
+#define KERNEL_LOG_CALL_NAME_MAX	48
+/* ts_us of a line without a printk time stamp */
+#define KERNEL_LOG_NO_TS		UINT64_MAX
+
+/* Smallest chunk handed to a scan thread; smaller inputs stay on one core */
+#define KERNEL_LOG_SCAN_MIN_CHUNK	(4u << 20)
+#define KERNEL_LOG_SCAN_MAX_THREADS	64
+
+/* ========================================================================== */
+/*                           Data Structures                                  */
+/* ========================================================================== */
+
+/**
+ * One decoded "[BOOT TRACKER] ID:<id> ... = <time>" line, or a line matched
+ * by a configured log marker.
+ */
+typedef struct {
+	uint64_t offset; /* Byte offset of the line in the log */
+	int id; /* Bootstage id */
+	int marker; /* Index in the marker set, LOG_MARKER_TRACKER for tracker lines */
+	uint64_t time_us; /* Tracker time stamp in microseconds, or KERNEL_LOG_NO_TS */
+	uint64_t ts_us; /* printk time stamp, or KERNEL_LOG_NO_TS */
+} kernel_log_match_t;
+
+typedef enum {
+	KERNEL_LOG_INITCALL,
+	KERNEL_LOG_PROBE,
+} kernel_log_call_kind_t;
+
+/**
+ * One initcall or driver probe that returned, as logged with initcall_debug.
+ */
+typedef struct {
+	uint64_t offset; /* Byte offset of the line in the log */
+	uint64_t ts_us; /* printk time stamp of the return, or KERNEL_LOG_NO_TS */
+	uint64_t dur_us;
+	int ret; /* -517 (-EPROBE_DEFER) for a deferred probe */
+	kernel_log_call_kind_t kind;
+	char name[KERNEL_LOG_CALL_NAME_MAX];
+} kernel_log_call_t;
+
+typedef struct {
+	kernel_log_match_t *matches;
+	size_t count;
+	size_t cap;
+	kernel_log_call_t *calls; /* Min-heap on dur_us of the longest calls */
+	size_t call_count;
+	size_t call_top; /* Calls kept; 0 skips initcall and probe lines */
+	uint64_t call_lines; /* Calls seen, kept or not */
+	const log_marker_set_t *markers; /* Also match these, NULL for tracker lines only */
+	uint64_t bytes_scanned;
+	uint64_t line_end; /* Offset just past the last complete line scanned */
+} kernel_log_scan_result_t;
+
+/* ========================================================================== */
+/*                          Function Declarations                             */
+/* ========================================================================== */
+
+const char *kernel_log_find_tag(const char *p, const char *end);
+int kernel_log_decode_line(const char *tag, const char *eol, int *id, uint64_t *time_us);
+int kernel_log_scan_buffer(const char *buf, size_t len, uint64_t base,
+		int nthreads, kernel_log_scan_result_t *res);
+int kernel_log_scan_file(const char *path, off_t start, off_t end,
+		int nthreads, kernel_log_scan_result_t *res);
+int kernel_log_scan_copy(kernel_log_scan_result_t *dst,
+		const kernel_log_scan_result_t *src, uint64_t start, uint64_t end);
+void kernel_log_scan_free(kernel_log_scan_result_t *res);
+
+#endif /* KERNEL_LOG_SCAN_H */
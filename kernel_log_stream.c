@@ -0,0 +1,549 @@
+/*
+ *  Copyright (C) 2025 Texas Instruments Incorporated
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions
+ *  are met:
+ *
+ *    Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *
+ *    Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the
+ *    distribution.
+ *
+ *    Neither the name of Texas Instruments Incorporated nor the names of
+ *    its contributors may be used to endorse or promote products derived
+ *    from this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ *  "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ *  LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ *  A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ *  OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ *  SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ *  LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ *  DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ *  THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ *  (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ *  OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/**
+ * \file kernel_log_stream.c
+ * \brief Streaming scan of rotated and compressed kernel logs.
+ *
+ * After logrotate the boot of interest may sit in <log>.1 or <log>.2.gz.
+ * Segments are read front to back by a reader thread that decompresses
+ * gzip or zstd on the fly into KLOG_STREAM_BUFS bounded buffers; the caller
+ * scans each filled buffer for tracker lines while the next one is being
+ * inflated, and tells the reader to stop as soon as the boot it wants has
+ * been scanned.
+ */
+
+/* ========================================================================== */
+/*                           Include Files                                    */
+/* ========================================================================== */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <errno.h>
+#include <glob.h>
+#include <pthread.h>
+#include <unistd.h>
+#include <fcntl.h>
+
+#ifdef BOOT_TIME_HAVE_ZLIB
+#include <zlib.h>
+#endif
+#ifdef BOOT_TIME_HAVE_ZSTD
+#include <zstd.h>
+#endif
+
+#include "boot_time_report.h"
+#include "kernel_log_stream.h"
+#include "kernel_log_index.h"
+
+/* ========================================================================== */
+/*                           Macros & Typedefs                                */
+/* ========================================================================== */
+
+/* Compressed bytes read at a time */
+#define KLOG_STREAM_IN_SIZE	(64u << 10)
+
+/* ========================================================================== */
+/*                           Data Structures                                  */
+/* ========================================================================== */
+
+typedef struct {
+	char *data; /* KLOG_STREAM_LINE_MAX of room, then the buffer proper */
+	size_t len;
+	int eof;
+} stream_buf_t;
+
+/* Decoder state of the reader thread */
+typedef struct {
+	int fd;
+	klog_codec_t codec;
+	uint8_t *in;
+#ifdef BOOT_TIME_HAVE_ZLIB
+	z_stream z;
+#endif
+#ifdef BOOT_TIME_HAVE_ZSTD
+	ZSTD_DStream *zs;
+	ZSTD_inBuffer zin;
+#endif
+} stream_decoder_t;
+
+typedef struct {
+	stream_decoder_t dec;
+	stream_buf_t bufs[KLOG_STREAM_BUFS];
+	unsigned head; /* Next buffer the reader fills */
+	unsigned tail; /* Next buffer the scanner takes */
+	unsigned filled;
+	int stop; /* Set by the scanner once it has what it needs */
+	int err;
+	pthread_mutex_t lock;
+	pthread_cond_t cond;
+} klog_stream_t;
+
+/* ========================================================================== */
+/*                          Function Definitions                              */
+/* ========================================================================== */
+
+/**
+ * @brief Tells how a log file is compressed, from its first bytes.
+ *
+ * @param path Log file.
+ * @param codec Receives the codec.
+ * @return int 0 on success, -1 if the file cannot be read.
+ */
+int kernel_log_codec(const char *path, klog_codec_t *codec)
+{
+	uint8_t magic[4];
+	ssize_t n;
+	int fd;
+
+	fd = open(path, O_RDONLY);
+	if (fd < 0)
+		return -1;
+	n = read(fd, magic, sizeof(magic));
+	close(fd);
+	if (n < 0)
+		return -1;
+	if (n >= 2 && magic[0] == 0x1f && magic[1] == 0x8b)
+		*codec = KLOG_CODEC_GZIP;
+	else if (n == 4 && magic[0] == 0x28 && magic[1] == 0xb5 &&
+			magic[2] == 0x2f && magic[3] == 0xfd)
+		*codec = KLOG_CODEC_ZSTD;
+	else
+		*codec = KLOG_CODEC_PLAIN;
+	return 0;
+}
+
+static int add_segment(klog_segment_t *seg, const char *path)
+{
+	if (kernel_log_codec(path, &seg->codec) < 0)
+		return 0;
+	snprintf(seg->path, sizeof(seg->path), "%s", path);
+	return 1;
+}
+
+/* Dated segments sort newest last, so they are taken from the end */
+static int dated_segments(const char *path, klog_segment_t *segs, int max)
+{
+	char pattern[PATH_MAX];
+	size_t suffix = strlen(KLOG_INDEX_SUFFIX);
+	glob_t g;
+	int n = 0;
+
+	snprintf(pattern, sizeof(pattern), "%s-[0-9]*", path);
+	if (glob(pattern, 0, NULL, &g) != 0)
+		return 0;
+	for (size_t i = g.gl_pathc; i-- > 0 && n < max; ) {
+		size_t len = strlen(g.gl_pathv[i]);
+
+		if (len > suffix && strcmp(g.gl_pathv[i] + len - suffix, KLOG_INDEX_SUFFIX) == 0)
+			continue;
+		n += add_segment(&segs[n], g.gl_pathv[i]);
+	}
+	globfree(&g);
+	return n;
+}
+
+/**
+ * @brief Lists the rotated segments of a log, newest first.
+ *
+ * Numbered segments (<log>.1, <log>.2.gz, <log>.3.zst, ...) are taken up to
+ * the first missing number; without any, dated ones (<log>-20250101.gz)
+ * are looked for.
+ *
+ * @param path Live log file.
+ * @param segs Receives the segments.
+ * @param max Size of segs.
+ * @return int Number of segments found.
+ */
+int kernel_log_rotated_segments(const char *path, klog_segment_t *segs, int max)
+{
+	static const char *const exts[] = { "", ".gz", ".zst" };
+	char name[PATH_MAX];
+	int n = 0;
+
+	for (int i = 1; i <= KLOG_ROTATE_MAX && n < max; i++) {
+		int found = 0;
+
+		for (size_t e = 0; e < sizeof(exts) / sizeof(exts[0]) && !found; e++) {
+			snprintf(name, sizeof(name), "%s.%d%s", path, i, exts[e]);
+			found = add_segment(&segs[n], name);
+		}
+		if (!found)
+			break;
+		n++;
+	}
+	return n ? n : dated_segments(path, segs, max);
+}
+
+static int decoder_init(stream_decoder_t *d, const klog_segment_t *seg)
+{
+	memset(d, 0, sizeof(*d));
+	d->codec = seg->codec;
+	d->fd = open(seg->path, O_RDONLY);
+	if (d->fd < 0) {
+		perror(seg->path);
+		return -1;
+	}
+	posix_fadvise(d->fd, 0, 0, POSIX_FADV_SEQUENTIAL);
+	switch (d->codec) {
+	case KLOG_CODEC_PLAIN:
+		return 0;
+	case KLOG_CODEC_GZIP:
+#ifdef BOOT_TIME_HAVE_ZLIB
+		d->in = malloc(KLOG_STREAM_IN_SIZE);
+		/* 15 + 32: gzip or zlib header, detected */
+		if (d->in && inflateInit2(&d->z, 15 + 32) == Z_OK)
+			return 0;
+		free(d->in);
+#else
+		fprintf(stderr, "%s: built without gzip support\n", seg->path);
+#endif
+		break;
+	case KLOG_CODEC_ZSTD:
+#ifdef BOOT_TIME_HAVE_ZSTD
+		d->in = malloc(KLOG_STREAM_IN_SIZE);
+		d->zs = ZSTD_createDStream();
+		if (d->in && d->zs && !ZSTD_isError(ZSTD_initDStream(d->zs)))
+			return 0;
+		ZSTD_freeDStream(d->zs);
+		free(d->in);
+#else
+		fprintf(stderr, "%s: built without zstd support\n", seg->path);
+#endif
+		break;
+	}
+	close(d->fd);
+	return -1;
+}
+
+static void decoder_end(stream_decoder_t *d)
+{
+#ifdef BOOT_TIME_HAVE_ZLIB
+	if (d->codec == KLOG_CODEC_GZIP)
+		inflateEnd(&d->z);
+#endif
+#ifdef BOOT_TIME_HAVE_ZSTD
+	if (d->codec == KLOG_CODEC_ZSTD)
+		ZSTD_freeDStream(d->zs);
+#endif
+	free(d->in);
+	close(d->fd);
+}
+
+/*
+ * Fills out with up to cap bytes of log text. Returns the bytes written,
+ * -1 on a read or format error; *eof is set at the end of the file. A
+ * truncated compressed file (still being written) just ends early.
+ */
+static ssize_t decoder_fill(stream_decoder_t *d, char *out, size_t cap, int *eof)
+{
+	size_t got = 0;
+	ssize_t n;
+
+	switch (d->codec) {
+	case KLOG_CODEC_PLAIN:
+		while (got < cap) {
+			n = read(d->fd, out + got, cap - got);
+			if (n < 0 && errno == EINTR)
+				continue;
+			if (n < 0)
+				return -1;
+			if (n == 0) {
+				*eof = 1;
+				break;
+			}
+			got += n;
+		}
+		return got;
+	case KLOG_CODEC_GZIP:
+#ifdef BOOT_TIME_HAVE_ZLIB
+		d->z.next_out = (Bytef *)out;
+		d->z.avail_out = cap;
+		while (d->z.avail_out) {
+			int rc;
+
+			if (d->z.avail_in == 0) {
+				n = read(d->fd, d->in, KLOG_STREAM_IN_SIZE);
+				if (n < 0)
+					return -1;
+				if (n == 0) {
+					*eof = 1;
+					break;
+				}
+				d->z.next_in = d->in;
+				d->z.avail_in = n;
+			}
+			rc = inflate(&d->z, Z_NO_FLUSH);
+			if (rc == Z_STREAM_END)
+				inflateReset(&d->z); /* gzip members may be concatenated */
+			else if (rc != Z_OK && rc != Z_BUF_ERROR)
+				return -1;
+		}
+		return cap - d->z.avail_out;
+#endif
+		break;
+	case KLOG_CODEC_ZSTD:
+#ifdef BOOT_TIME_HAVE_ZSTD
+		{
+			ZSTD_outBuffer zout = { out, cap, 0 };
+
+			while (zout.pos < zout.size) {
+				if (d->zin.pos == d->zin.size) {
+					n = read(d->fd, d->in, KLOG_STREAM_IN_SIZE);
+					if (n < 0)
+						return -1;
+					if (n == 0) {
+						*eof = 1;
+						break;
+					}
+					d->zin.src = d->in;
+					d->zin.size = n;
+					d->zin.pos = 0;
+				}
+				if (ZSTD_isError(ZSTD_decompressStream(d->zs, &zout, &d->zin)))
+					return -1;
+			}
+			return zout.pos;
+		}
+#endif
+		break;
+	}
+	return -1;
+}
+
+static void *stream_reader(void *arg)
+{
+	klog_stream_t *s = arg;
+
+	for (;;) {
+		stream_buf_t *b;
+		ssize_t n;
+		int eof = 0;
+
+		pthread_mutex_lock(&s->lock);
+		while (s->filled == KLOG_STREAM_BUFS && !s->stop)
+			pthread_cond_wait(&s->cond, &s->lock);
+		if (s->stop) {
+			pthread_mutex_unlock(&s->lock);
+			break;
+		}
+		b = &s->bufs[s->head];
+		pthread_mutex_unlock(&s->lock);
+
+		n = decoder_fill(&s->dec, b->data + KLOG_STREAM_LINE_MAX,
+				KLOG_STREAM_BUF_SIZE, &eof);
+
+		pthread_mutex_lock(&s->lock);
+		b->len = (n > 0) ? n : 0;
+		b->eof = eof || n < 0;
+		if (n < 0)
+			s->err = -1;
+		s->head = (s->head + 1) % KLOG_STREAM_BUFS;
+		s->filled++;
+		pthread_cond_broadcast(&s->cond);
+		pthread_mutex_unlock(&s->lock);
+		if (b->eof)
+			break;
+	}
+	return NULL;
+}
+
+/* Returns 1 if res gained a tracker line with id stop_id from index first */
+static int found_stop(const kernel_log_scan_result_t *res, size_t first, int stop_id)
+{
+	for (size_t i = first; i < res->count; i++)
+		if (res->matches[i].marker == LOG_MARKER_TRACKER &&
+				res->matches[i].id == stop_id)
+			return 1;
+	return 0;
+}
+
+/**
+ * @brief Scans [start, end) of a log segment as it is read or inflated.
+ *
+ * Bytes before start are decompressed but not scanned. Reading stops at
+ * end, or right after the tracker line with id stop_id. Offsets in res
+ * are offsets in the decompressed text.
+ *
+ * @param seg Segment to scan.
+ * @param start First byte to scan, a line start.
+ * @param end End of the scan, a line start, or 0 for the end of the file.
+ * @param stop_id Tracker id ending the scan, or -1 for none.
+ * @param res Result to append to.
+ * @return int 0 on success, -1 on failure.
+ */
+int kernel_log_stream_scan(const klog_segment_t *seg, uint64_t start, uint64_t end,
+		int stop_id, kernel_log_scan_result_t *res)
+{
+	klog_stream_t s;
+	pthread_t tid;
+	char *carry;
+	size_t carry_len = 0;
+	uint64_t pos = 0; /* Offset of the next buffer's first byte */
+	int done = 0, err = 0, started = 0;
+
+	if (end == 0)
+		end = UINT64_MAX;
+	memset(&s, 0, sizeof(s));
+	carry = malloc(KLOG_STREAM_LINE_MAX);
+	for (int i = 0; i < KLOG_STREAM_BUFS; i++) {
+		s.bufs[i].data = malloc(KLOG_STREAM_LINE_MAX + KLOG_STREAM_BUF_SIZE);
+		err |= !s.bufs[i].data;
+	}
+	if (!carry || err || decoder_init(&s.dec, seg) < 0) {
+		for (int i = 0; i < KLOG_STREAM_BUFS; i++)
+			free(s.bufs[i].data);
+		free(carry);
+		return -1;
+	}
+	pthread_mutex_init(&s.lock, NULL);
+	pthread_cond_init(&s.cond, NULL);
+	started = pthread_create(&tid, NULL, stream_reader, &s) == 0;
+	if (!started) {
+		perror("pthread_create");
+		err = -1;
+		done = 1;
+	}
+
+	while (!done) {
+		stream_buf_t *b;
+		const char *text, *line_end;
+		uint64_t base, s0, s1;
+		size_t len, first;
+
+		pthread_mutex_lock(&s.lock);
+		while (s.filled == 0)
+			pthread_cond_wait(&s.cond, &s.lock);
+		b = &s.bufs[s.tail];
+		pthread_mutex_unlock(&s.lock);
+
+		/* The partial line left over from the previous buffer goes first */
+		memcpy(b->data + KLOG_STREAM_LINE_MAX - carry_len, carry, carry_len);
+		text = b->data + KLOG_STREAM_LINE_MAX - carry_len;
+		len = carry_len + b->len;
+		base = pos - carry_len;
+		line_end = text + len;
+		if (!b->eof) {
+			const char *nl = memrchr(text, '\n', len);
+
+			if (nl && (size_t)(text + len - (nl + 1)) <= KLOG_STREAM_LINE_MAX)
+				line_end = nl + 1;
+		}
+
+		s0 = (base > start) ? base : start;
+		s1 = base + (line_end - text);
+		if (s1 > end)
+			s1 = end;
+		first = res->count;
+		if (s0 < s1 && kernel_log_scan_buffer(text + (s0 - base), s1 - s0, s0,
+					1, res) < 0)
+			err = -1;
+		if (err || b->eof || s1 >= end ||
+				(stop_id >= 0 && found_stop(res, first, stop_id)))
+			done = 1;
+
+		carry_len = text + len - line_end;
+		memcpy(carry, line_end, carry_len);
+		pos += b->len;
+
+		pthread_mutex_lock(&s.lock);
+		s.tail = (s.tail + 1) % KLOG_STREAM_BUFS;
+		s.filled--;
+		if (done)
+			s.stop = 1;
+		pthread_cond_broadcast(&s.cond);
+		pthread_mutex_unlock(&s.lock);
+	}
+
+	if (started)
+		pthread_join(tid, NULL);
+	if (s.err) {
+		fprintf(stderr, "Failed to read %s\n", seg->path);
+		err = -1;
+	}
+	decoder_end(&s.dec);
+	pthread_cond_destroy(&s.cond);
+	pthread_mutex_destroy(&s.lock);
+	for (int i = 0; i < KLOG_STREAM_BUFS; i++)
+		free(s.bufs[i].data);
+	free(carry);
+	return err;
+}
+
+/**
+ * @brief Scans one boot out of a log rotation set.
+ *
+ * Segments are walked newest first. Each one is streamed once to split it
+ * into boots, as kernel_log_index.c does for the live log; the segment
+ * holding the wanted boot is then streamed again up to that boot's
+ * BOOTSTAGE_KERNEL_END line only if initcalls or marker lines are wanted
+ * as well, since the first pass looks at tracker lines only.
+ *
+ * @param segs Segments, newest first.
+ * @param nsegs Number of segments.
+ * @param skip Boots newer than the wanted one in these segments: 0 for
+ * the newest boot they hold.
+ * @param res Result to append to; call_top and markers select what is
+ * scanned besides tracker lines.
+ * @return int 0 on success, 1 if the set holds fewer boots, -1 on failure.
+ */
+int kernel_log_rotated_boot(const klog_segment_t *segs, int nsegs, uint32_t skip,
+		kernel_log_scan_result_t *res)
+{
+	for (int i = 0; i < nsegs; i++) {
+		kernel_log_scan_result_t boots = { 0 };
+		klog_index_boot_t b;
+		uint32_t nboots = 0;
+		int ret;
+
+		if (kernel_log_stream_scan(&segs[i], 0, 0, -1, &boots) < 0) {
+			kernel_log_scan_free(&boots);
+			return -1;
+		}
+		ret = kernel_log_split_boots(&boots, -(int)skip, &b, &nboots);
+		if (ret == 0) {
+			if (res->call_top || res->markers)
+				ret = kernel_log_stream_scan(&segs[i], b.start, b.end,
+						res->markers ? -1 : BOOTSTAGE_KERNEL_END, res);
+			else
+				ret = kernel_log_scan_copy(res, &boots, b.start,
+						b.end ? b.end : UINT64_MAX);
+			res->bytes_scanned += boots.bytes_scanned;
+		}
+		kernel_log_scan_free(&boots);
+		if (ret <= 0)
+			return ret;
+		skip -= nboots;
+	}
+	return 1;
+}
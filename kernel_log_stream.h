@@ -0,0 +1,94 @@
+/*
+ *  Copyright (C) 2025 Texas Instruments Incorporated
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions
+ *  are met:
+ *
+ *    Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *
+ *    Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the
+ *    distribution.
+ *
+ *    Neither the name of Texas Instruments Incorporated nor the names of
+ *    its contributors may be used to endorse or promote products derived
+ *    from this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ *  "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ *  LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ *  A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ *  OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ *  SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ *  LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ *  DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ *  THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ *  (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ *  OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/**
+ * \file kernel_log_stream.h
+ * \brief Streaming scan of rotated and compressed kernel logs. A reader
+ * thread reads or inflates a log segment into a small ring of buffers while
+ * the caller's thread scans them, so a compressed log is never inflated
+ * into memory as a whole.
+ */
+
+#ifndef KERNEL_LOG_STREAM_H
+#define KERNEL_LOG_STREAM_H
+
+/* ========================================================================== */
+/*                           Include Files                                    */
+/* ========================================================================== */
+#include <stdint.h>
+#include <stddef.h>
+#include <limits.h>
+
+#include "kernel_log_scan.h"
+
+/* ========================================================================== */
+/*                           Macros & Typedefs                                */
+/* ========================================================================== */
+
+/* Ring between the reader and the scanner: KLOG_STREAM_BUFS * 1 MiB */
+#define KLOG_STREAM_BUFS		4
+#define KLOG_STREAM_BUF_SIZE		(1u << 20)
+/* Longest line joined across two buffers; longer ones are scanned in pieces */
+#define KLOG_STREAM_LINE_MAX		(64u << 10)
+/* Rotated segments looked at: <log>.1 ... <log>.KLOG_ROTATE_MAX */
+#define KLOG_ROTATE_MAX			64
+
+typedef enum {
+	KLOG_CODEC_PLAIN,
+	KLOG_CODEC_GZIP,
+	KLOG_CODEC_ZSTD,
+} klog_codec_t;
+
+/* ========================================================================== */
+/*                           Data Structures                                  */
+/* ========================================================================== */
+
+/**
+ * One file of a log rotation set.
+ */
+typedef struct {
+	char path[PATH_MAX];
+	klog_codec_t codec; /* From the file's magic, not its name */
+} klog_segment_t;
+
+/* ========================================================================== */
+/*                          Function Declarations                             */
+/* ========================================================================== */
+
+int kernel_log_codec(const char *path, klog_codec_t *codec);
+int kernel_log_rotated_segments(const char *path, klog_segment_t *segs, int max);
+int kernel_log_stream_scan(const klog_segment_t *seg, uint64_t start, uint64_t end,
+		int stop_id, kernel_log_scan_result_t *res);
+int kernel_log_rotated_boot(const klog_segment_t *segs, int nsegs, uint32_t skip,
+		kernel_log_scan_result_t *res);
+
+#endif /* KERNEL_LOG_STREAM_H */
@@ -0,0 +1,230 @@
+/*
+ *  Copyright (C) 2025 Texas Instruments Incorporated
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions
+ *  are met:
+ *
+ *    Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *
+ *    Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the
+ *    distribution.
+ *
+ *    Neither the name of Texas Instruments Incorporated nor the names of
+ *    its contributors may be used to endorse or promote products derived
+ *    from this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ *  "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ *  LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ *  A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ *  OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ *  SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ *  LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ *  DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ *  THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ *  (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ *  OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/**
+ * \file kmsg_source.c
+ * \brief Tracker records from the kernel ring buffer.
+ *
+ * /dev/kmsg hands out one record per read() as
+ * "<prio>,<seq>,<ts_usec>,<flags>[,...];<message>", so no syslog daemon is
+ * needed and the kernel's own time stamp is available. Saved dumps may be in
+ * that format or in dmesg's "[<sec>.<usec>] <message>" format.
+ */
+
+/* ========================================================================== */
+/*                           Include Files                                    */
+/* ========================================================================== */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <errno.h>
+#include <unistd.h>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+
+#include "kmsg_source.h"
+#include "kernel_log_scan.h"
+
+
+/* ========================================================================== */
+/*                          Function Definitions                              */
+/* ========================================================================== */
+
+static const char *parse_uint(const char *p, const char *end, uint64_t *val)
+{
+	const char *start = p;
+	uint64_t v = 0;
+
+	while (p < end && *p >= '0' && *p <= '9')
+		v = v * 10 + (*p++ - '0');
+	*val = v;
+	return (p == start) ? NULL : p;
+}
+
+/*
+ * Extracts the kernel time stamp from the prefix of a kmsg record or a dmesg
+ * line. Returns 0 when the line has neither prefix (e.g. plain syslog).
+ */
+static uint64_t parse_kernel_ts(const char *p, const char *tag)
+{
+	uint64_t v, frac;
+	const char *q;
+
+	if (*p == '[') {
+		/* dmesg: "[    3.478000] ..." */
+		for (p++; p < tag && *p == ' '; p++)
+			;
+		q = parse_uint(p, tag, &v);
+		if (!q || *q != '.')
+			return 0;
+		p = q + 1;
+		q = parse_uint(p, tag, &frac);
+		if (!q)
+			return 0;
+		for (int digits = q - p; digits < 6; digits++)
+			frac *= 10;
+		for (int digits = q - p; digits > 6; digits--)
+			frac /= 10;
+		return v * 1000000 + frac;
+	}
+
+	/* kmsg: "<prio>,<seq>,<ts_usec>,..." */
+	for (int field = 0; field < 2; field++) {
+		q = parse_uint(p, tag, &v);
+		if (!q || *q != ',')
+			return 0;
+		p = q + 1;
+	}
+	q = parse_uint(p, tag, &v);
+	return q ? v : 0;
+}
+
+/*
+ * Decodes one record or line and reports it. Returns 1 when it was the
+ * stop marker.
+ */
+static int handle_line(const char *p, const char *eol, kmsg_record_cb_t cb, void *arg)
+{
+	const char *tag = kernel_log_find_tag(p, eol);
+	uint64_t ts, time_us;
+	int id;
+
+	if (!tag)
+		return 0;
+	ts = parse_kernel_ts(p, tag);
+	if (kernel_log_decode_line(tag, eol, &id, &time_us) < 0) {
+		const char *q = tag + BOOT_TRACKER_TAG_LEN;
+		uint64_t v;
+
+		/* "ID:<n>" without a time value: fall back to the kernel clock */
+		q = memmem(q, eol - q, "ID:", 3);
+		if (!q || !ts || !parse_uint(q + 3, eol, &v))
+			return 0;
+		id = (int)v;
+		time_us = ts;
+	}
+	cb(arg, id, time_us, ts);
+	return id == KMSG_STOP_ID;
+}
+
+static int read_kmsg_device(int fd, kmsg_record_cb_t cb, void *arg)
+{
+	char rec[KMSG_RECORD_MAX];
+
+	for (;;) {
+		ssize_t n = read(fd, rec, sizeof(rec));
+
+		if (n < 0) {
+			if (errno == EAGAIN)
+				break; /* Ring drained without a kernel end marker */
+			if (errno == EPIPE || errno == EINTR)
+				continue; /* Record overwritten while reading */
+			perror("Failed to read " KMSG_DEVICE);
+			return -1;
+		}
+		if (n == 0)
+			break;
+		/* Only the first line is the message, the rest are dictionary */
+		const char *eol = memchr(rec, '\n', n);
+		if (handle_line(rec, eol ? eol : rec + n, cb, arg))
+			break;
+	}
+	return 0;
+}
+
+static int read_kmsg_dump(int fd, size_t size, kmsg_record_cb_t cb, void *arg)
+{
+	const char *buf, *p, *end;
+
+	if (size == 0)
+		return 0;
+	buf = mmap(NULL, size, PROT_READ, MAP_PRIVATE, fd, 0);
+	if (buf == MAP_FAILED) {
+		perror("mmap");
+		return -1;
+	}
+	end = buf + size;
+	for (p = buf; p < end; ) {
+		const char *tag = kernel_log_find_tag(p, end);
+		const char *bol, *eol;
+
+		if (!tag)
+			break;
+		for (bol = tag; bol > buf && bol[-1] != '\n'; bol--)
+			;
+		eol = memchr(tag, '\n', end - tag);
+		if (!eol)
+			eol = end;
+		if (handle_line(bol, eol, cb, arg))
+			break;
+		p = eol;
+	}
+	munmap((void *)buf, size);
+	return 0;
+}
+
+/**
+ * @brief Reads tracker records from /dev/kmsg or a saved dump.
+ *
+ * A character device is read one record at a time without blocking;
+ * regular files are taken as kmsg or dmesg dumps. Reading stops as soon
+ * as the BOOTSTAGE_KERNEL_END record has been reported.
+ *
+ * @param path KMSG_DEVICE or a dump file.
+ * @param cb Called for every tracker record.
+ * @param arg Passed to cb.
+ * @return int 0 on success, -1 on failure.
+ */
+int kmsg_read_records(const char *path, kmsg_record_cb_t cb, void *arg)
+{
+	struct stat st;
+	int fd, ret;
+
+	fd = open(path, O_RDONLY | O_NONBLOCK);
+	if (fd < 0) {
+		perror("Failed to open kernel message source");
+		return -1;
+	}
+	if (fstat(fd, &st) < 0) {
+		perror("fstat");
+		close(fd);
+		return -1;
+	}
+	if (S_ISCHR(st.st_mode))
+		ret = read_kmsg_device(fd, cb, arg);
+	else
+		ret = read_kmsg_dump(fd, st.st_size, cb, arg);
+	close(fd);
+	return ret;
+}
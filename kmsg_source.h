@@ -0,0 +1,74 @@
+/*
+ *  Copyright (C) 2025 Texas Instruments Incorporated
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions
+ *  are met:
+ *
+ *    Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *
+ *    Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the
+ *    distribution.
+ *
+ *    Neither the name of Texas Instruments Incorporated nor the names of
+ *    its contributors may be used to endorse or promote products derived
+ *    from this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ *  "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ *  LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ *  A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ *  OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ *  SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ *  LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ *  DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ *  THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ *  (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ *  OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/**
+ * \file kmsg_source.h
+ * \brief Kernel record source reading tracker lines straight from
+ * /dev/kmsg, or from a saved kmsg or dmesg dump for offline use.
+ */
+
+#ifndef KMSG_SOURCE_H
+#define KMSG_SOURCE_H
+
+/* ========================================================================== */
+/*                           Include Files                                    */
+/* ========================================================================== */
+#include <stdint.h>
+
+/* ========================================================================== */
+/*                           Macros & Typedefs                                */
+/* ========================================================================== */
+
+#define KMSG_DEVICE		"/dev/kmsg"
+/* Largest record the kernel hands out per read() (CONSOLE_EXT_LOG_MAX) */
+#define KMSG_RECORD_MAX		8192
+/* Reading stops once this tracker id (BOOTSTAGE_KERNEL_END) is seen */
+#define KMSG_STOP_ID		301
+
+/**
+ * Called for each tracker record in log order.
+ *
+ * @param arg Caller context.
+ * @param id Bootstage id.
+ * @param time_us Tracker time stamp, or the kernel time stamp when the
+ * tracker line carries none.
+ * @param ts_us Kernel time stamp of the record (0 if unknown).
+ */
+typedef void (*kmsg_record_cb_t)(void *arg, int id, uint64_t time_us, uint64_t ts_us);
+
+/* ========================================================================== */
+/*                          Function Declarations                             */
+/* ========================================================================== */
+
+int kmsg_read_records(const char *path, kmsg_record_cb_t cb, void *arg);
+
+#endif /* KMSG_SOURCE_H */
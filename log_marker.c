@@ -0,0 +1,426 @@
+/*
+ *  Copyright (C) 2025 Texas Instruments Incorporated
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions
+ *  are met:
+ *
+ *    Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *
+ *    Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the
+ *    distribution.
+ *
+ *    Neither the name of Texas Instruments Incorporated nor the names of
+ *    its contributors may be used to endorse or promote products derived
+ *    from this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ *  "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ *  LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ *  A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ *  OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ *  SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ *  LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ *  DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ *  THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ *  (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ *  OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/**
+ * \file log_marker.c
+ * \brief Marker config parser and the Aho-Corasick automaton matching all
+ * markers in one pass. The automaton is a dense DFA, so each input byte
+ * costs one table lookup whatever the number of patterns.
+ */
+
+/* ========================================================================== */
+/*                           Include Files                                    */
+/* ========================================================================== */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <ctype.h>
+
+#include "log_marker.h"
+#include "kernel_log_scan.h"
+#include "boot_time_report.h"
+
+
+/* ========================================================================== */
+/*                          Function Definitions                              */
+/* ========================================================================== */
+
+static log_marker_t *marker_add(log_marker_set_t *set, log_marker_kind_t kind,
+		const char *pattern)
+{
+	log_marker_t *mk;
+
+	if (set->count == set->cap) {
+		int cap = set->cap ? set->cap * 2 : 16;
+		log_marker_t *n = realloc(set->markers, cap * sizeof(*n));
+
+		if (!n)
+			return NULL;
+		set->markers = n;
+		set->cap = cap;
+	}
+	mk = &set->markers[set->count++];
+	memset(mk, 0, sizeof(*mk));
+	mk->kind = kind;
+	snprintf(mk->pattern, sizeof(mk->pattern), "%s", pattern);
+	mk->len = strlen(mk->pattern);
+	mk->id = BOOTSTAGE_LOG_MARKER;
+	mk->unit_ns = 1000;
+	return mk;
+}
+
+/*
+ * Splits off the next token of s. Double quotes group spaces, and \" and \\
+ * escape inside them. Returns NULL at the end of the line or at a comment;
+ * sets *err for an unterminated quote.
+ */
+static char *next_token(char **s, int *err)
+{
+	char *p = *s, *tok, *w;
+	int quoted = 0;
+
+	while (isspace((unsigned char)*p))
+		p++;
+	if (!*p || *p == '#')
+		return NULL;
+	tok = w = p;
+	for (; *p && (quoted || !isspace((unsigned char)*p)); p++) {
+		if (*p == '"') {
+			quoted = !quoted;
+			continue;
+		}
+		if (quoted && *p == '\\' && p[1])
+			p++;
+		*w++ = *p;
+	}
+	if (*p)
+		p++;
+	*w = '\0';
+	*s = p;
+	if (quoted) {
+		*err = 1;
+		return NULL;
+	}
+	return tok;
+}
+
+static int parse_option(log_marker_t *mk, char *opt)
+{
+	char *val = strchr(opt, '=');
+	char *end;
+
+	if (!val)
+		return -1;
+	*val++ = '\0';
+	if (strcmp(opt, "id") == 0) {
+		mk->id = strtol(val, &end, 0);
+		return (*val && !*end) ? 0 : -1;
+	}
+	if (strcmp(opt, "track") == 0) {
+		if (strcmp(val, "kernel") == 0)
+			mk->id = BOOTSTAGE_LOG_MARKER;
+		else if (strcmp(val, "user") == 0)
+			mk->id = BOOTSTAGE_USER_MILESTONE;
+		else
+			return -1;
+		return 0;
+	}
+	if (strcmp(opt, "field") == 0) {
+		if (!*val || strlen(val) >= sizeof(mk->field))
+			return -1;
+		strcpy(mk->field, val);
+		mk->field_len = strlen(val);
+		return 0;
+	}
+	if (strcmp(opt, "unit") == 0) {
+		if (strcmp(val, "s") == 0)
+			mk->unit_ns = 1000000000;
+		else if (strcmp(val, "ms") == 0)
+			mk->unit_ns = 1000000;
+		else if (strcmp(val, "us") == 0)
+			mk->unit_ns = 1000;
+		else if (strcmp(val, "ns") == 0)
+			mk->unit_ns = 1;
+		else
+			return -1;
+		return 0;
+	}
+	return -1;
+}
+
+/*
+ * Builds the automaton: a trie of all patterns, then a breadth first pass
+ * that fills in the failure transitions so every state has an edge for
+ * every input class. The markers ending in a state form a list through
+ * out_next: those whose pattern leads to it, then the list of its failure
+ * state, i.e. the markers that are suffixes of it.
+ */
+static int marker_compile(log_marker_set_t *set)
+{
+	uint32_t max_states = 1, nstates = 1, head = 0, tail = 0;
+	uint32_t *fail = NULL, *queue = NULL;
+	int32_t *last = NULL;
+	int nclass = 1;
+
+	memset(set->cls, 0, sizeof(set->cls));
+	memset(set->first, 0, sizeof(set->first));
+	for (int i = 0; i < set->count; i++) {
+		const log_marker_t *mk = &set->markers[i];
+
+		max_states += mk->len;
+		set->first[(uint8_t)mk->pattern[0]] = 1;
+		for (size_t j = 0; j < mk->len; j++)
+			if (!set->cls[(uint8_t)mk->pattern[j]])
+				set->cls[(uint8_t)mk->pattern[j]] = nclass++;
+	}
+	set->class_count = nclass;
+	set->next = calloc((size_t)max_states * nclass, sizeof(*set->next));
+	set->out = malloc(max_states * sizeof(*set->out));
+	set->out_next = malloc(set->count * sizeof(*set->out_next));
+	fail = calloc(max_states, sizeof(*fail));
+	queue = malloc(max_states * sizeof(*queue));
+	last = malloc(max_states * sizeof(*last));
+	if (!set->next || !set->out || !set->out_next || !fail || !queue || !last)
+		goto oom;
+	for (uint32_t s = 0; s < max_states; s++)
+		set->out[s] = -1;
+	for (int i = 0; i < set->count; i++)
+		set->out_next[i] = -1;
+
+	/* ---- trie; state 0 is the root and never a child ---- */
+	for (int i = 0; i < set->count; i++) {
+		const log_marker_t *mk = &set->markers[i];
+		uint32_t s = 0;
+
+		for (size_t j = 0; j < mk->len; j++) {
+			uint32_t *t = &set->next[(size_t)s * nclass + set->cls[(uint8_t)mk->pattern[j]]];
+
+			if (!*t)
+				*t = nstates++;
+			s = *t;
+		}
+		/* Markers with the same pattern all end here, in config order */
+		if (set->out[s] < 0)
+			set->out[s] = i;
+		else
+			set->out_next[last[s]] = i;
+		last[s] = i;
+	}
+
+	/* ---- failure transitions, in breadth first order ---- */
+	for (int c = 1; c < nclass; c++)
+		if (set->next[c])
+			queue[tail++] = set->next[c];
+	while (head < tail) {
+		uint32_t s = queue[head++];
+
+		for (int c = 1; c < nclass; c++) {
+			uint32_t *t = &set->next[(size_t)s * nclass + c];
+			uint32_t f = set->next[(size_t)fail[s] * nclass + c];
+
+			if (*t) {
+				/* f is shallower, so its list is complete */
+				fail[*t] = f;
+				if (set->out[*t] < 0)
+					set->out[*t] = set->out[f];
+				else
+					set->out_next[last[*t]] = set->out[f];
+				queue[tail++] = *t;
+			} else {
+				*t = f;
+			}
+		}
+	}
+	set->state_count = nstates;
+	free(fail);
+	free(queue);
+	free(last);
+	return 0;
+oom:
+	fprintf(stderr, "Out of memory compiling log markers\n");
+	free(fail);
+	free(queue);
+	free(last);
+	return -1;
+}
+
+/**
+ * @brief Loads a marker config and compiles it with the built-in tags.
+ *
+ * Each non-empty line is a quoted literal pattern, the stage name of its
+ * records and options, see log_marker_t. '#' starts a comment outside
+ * quotes.
+ *
+ * @param set Receives the markers; release with log_marker_free().
+ * @param path Marker config file.
+ * @return int 0 on success, -1 on failure.
+ */
+int log_marker_load(log_marker_set_t *set, const char *path)
+{
+	char line[512];
+	unsigned lineno = 0;
+	FILE *fp;
+
+	memset(set, 0, sizeof(*set));
+	if (!marker_add(set, LOG_MARKER_TRACKER, BOOT_TRACKER_TAG) ||
+			!marker_add(set, LOG_MARKER_CALL, KERNEL_LOG_CALL_TAG)) {
+		fprintf(stderr, "Out of memory loading log markers\n");
+		return -1;
+	}
+	fp = fopen(path, "r");
+	if (!fp) {
+		perror("Failed to open marker config");
+		log_marker_free(set);
+		return -1;
+	}
+	while (fgets(line, sizeof(line), fp)) {
+		char *s = line, *pattern, *name, *opt;
+		log_marker_t *mk;
+		int err = 0;
+
+		lineno++;
+		pattern = next_token(&s, &err);
+		if (!pattern && !err)
+			continue;
+		name = pattern ? next_token(&s, &err) : NULL;
+		if (!name || !*pattern || strlen(pattern) >= LOG_MARKER_PATTERN_MAX) {
+			fprintf(stderr, "%s:%u: expected \"<pattern>\" <stage name> [options]\n",
+					path, lineno);
+			goto fail;
+		}
+		mk = marker_add(set, LOG_MARKER_USER, pattern);
+		if (!mk) {
+			fprintf(stderr, "%s:%u: out of memory\n", path, lineno);
+			goto fail;
+		}
+		snprintf(mk->name, sizeof(mk->name), "%s", name);
+		while ((opt = next_token(&s, &err)) != NULL)
+			if (parse_option(mk, opt) < 0) {
+				fprintf(stderr, "%s:%u: bad option %s\n", path, lineno, opt);
+				goto fail;
+			}
+		if (err) {
+			fprintf(stderr, "%s:%u: unterminated quote\n", path, lineno);
+			goto fail;
+		}
+	}
+	fclose(fp);
+	return marker_compile(set) < 0 ? (log_marker_free(set), -1) : 0;
+fail:
+	fclose(fp);
+	log_marker_free(set);
+	return -1;
+}
+
+/**
+ * @brief Releases a marker set.
+ */
+void log_marker_free(log_marker_set_t *set)
+{
+	free(set->markers);
+	free(set->next);
+	free(set->out);
+	free(set->out_next);
+	memset(set, 0, sizeof(*set));
+}
+
+/**
+ * @brief Starts a scan at p, which must be the start of a line.
+ */
+void log_marker_cursor_init(log_marker_cursor_t *cur, const char *p)
+{
+	cur->p = p;
+	cur->state = 0;
+	cur->which = -1;
+}
+
+/**
+ * @brief Finds the next marker ending in [cur->p, end).
+ *
+ * Every marker is reported, including those ending inside or at the same
+ * byte as another one: each call returns one of them, and the next call
+ * goes on from there. In the root state, bytes that start no pattern are
+ * skipped without a table lookup.
+ *
+ * @param cur Scan position, see log_marker_cursor_init().
+ * @param which Receives the marker index.
+ * @return const char* Start of the marker text, or NULL if there is none.
+ */
+const char *log_marker_find(const log_marker_set_t *set, log_marker_cursor_t *cur,
+		const char *end, int *which)
+{
+	const uint32_t *next = set->next;
+	const int nclass = set->class_count;
+	const char *p = cur->p;
+	uint32_t s = cur->state;
+	int m = -1;
+
+	/* Markers left ending at the byte before p */
+	if (cur->which >= 0)
+		m = set->out_next[cur->which];
+	while (m < 0 && p < end) {
+		if (s == 0) {
+			while (p < end && !set->first[(uint8_t)*p])
+				p++;
+			if (p == end)
+				break;
+		}
+		s = next[(size_t)s * nclass + set->cls[(uint8_t)*p++]];
+		m = set->out[s];
+	}
+	cur->p = p;
+	cur->state = s;
+	cur->which = m;
+	if (m < 0)
+		return NULL;
+	*which = m;
+	return p - set->markers[m].len;
+}
+
+/**
+ * @brief Extracts the time of a configured marker's line.
+ *
+ * @param mk Marker found at tag.
+ * @param tag Start of the marker text in the line.
+ * @param eol End of the line.
+ * @param time_us Receives the field value in microseconds, or
+ * KERNEL_LOG_NO_TS if the marker is timed by the printk time stamp.
+ * @return int 0 on success, -1 if the field is missing.
+ */
+int log_marker_decode(const log_marker_t *mk, const char *tag, const char *eol,
+		uint64_t *time_us)
+{
+	const char *p = tag; /* The field may end the pattern itself */
+	uint64_t v = 0, frac = 0, scale = 1;
+
+	if (!mk->field_len) {
+		*time_us = KERNEL_LOG_NO_TS;
+		return 0;
+	}
+	p = memmem(p, eol - p, mk->field, mk->field_len);
+	if (!p)
+		return -1;
+	for (p += mk->field_len; p < eol && *p == ' '; p++)
+		;
+	if (p == eol || !isdigit((unsigned char)*p))
+		return -1;
+	while (p < eol && isdigit((unsigned char)*p))
+		v = v * 10 + (*p++ - '0');
+	if (p < eol && *p == '.')
+		for (p++; p < eol && isdigit((unsigned char)*p) && scale < 1000000000; p++) {
+			frac = frac * 10 + (*p - '0');
+			scale *= 10;
+		}
+	*time_us = (v * mk->unit_ns + frac * mk->unit_ns / scale + 500) / 1000;
+	return 0;
+}
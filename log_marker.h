@@ -0,0 +1,126 @@
+/*
+ *  Copyright (C) 2025 Texas Instruments Incorporated
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions
+ *  are met:
+ *
+ *    Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *
+ *    Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the
+ *    distribution.
+ *
+ *    Neither the name of Texas Instruments Incorporated nor the names of
+ *    its contributors may be used to endorse or promote products derived
+ *    from this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ *  "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ *  LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ *  A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ *  OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ *  SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ *  LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ *  DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ *  THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ *  (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ *  OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/**
+ * \file log_marker.h
+ * \brief Configurable log markers: literal patterns that turn log lines into
+ * boot records, matched together with the tracker tag in one pass by an
+ * Aho-Corasick automaton.
+ */
+
+#ifndef LOG_MARKER_H
+#define LOG_MARKER_H
+
+/* ========================================================================== */
+/*                           Include Files                                    */
+/* ========================================================================== */
+#include <stdint.h>
+#include <stddef.h>
+
+/* ========================================================================== */
+/*                           Macros & Typedefs                                */
+/* ========================================================================== */
+
+#define LOG_MARKER_PATTERN_MAX	128
+#define LOG_MARKER_NAME_MAX	64
+#define LOG_MARKER_FIELD_MAX	32
+
+/* Markers 0 and 1 are the built-in tags, configured ones follow */
+typedef enum {
+	LOG_MARKER_TRACKER, /* BOOT_TRACKER_TAG */
+	LOG_MARKER_CALL, /* KERNEL_LOG_CALL_TAG of initcall_debug */
+	LOG_MARKER_USER, /* From the marker config */
+} log_marker_kind_t;
+
+/* ========================================================================== */
+/*                           Data Structures                                  */
+/* ========================================================================== */
+
+/**
+ * One marker config line:
+ *   "<pattern>" <stage name> [id=<n>] [track=kernel|user] [field="<text>"]
+ *   [unit=ns|us|ms|s]
+ * The record time is the number following field in the line, or the line's
+ * printk time stamp when there is no field.
+ */
+typedef struct {
+	log_marker_kind_t kind;
+	char pattern[LOG_MARKER_PATTERN_MAX];
+	size_t len;
+	char name[LOG_MARKER_NAME_MAX];
+	int id; /* Bootstage id of the records */
+	char field[LOG_MARKER_FIELD_MAX]; /* Empty: use the printk time stamp */
+	size_t field_len;
+	uint64_t unit_ns; /* Nanoseconds per unit of the field value */
+} log_marker_t;
+
+/**
+ * Markers compiled into a dense Aho-Corasick automaton. Bytes that occur
+ * in no pattern share one input class, so the transition table has
+ * state_count * class_count entries.
+ */
+typedef struct {
+	log_marker_t *markers;
+	int count;
+	int cap;
+	uint8_t cls[256]; /* Input class of each byte, 0 if in no pattern */
+	uint8_t first[256]; /* Bytes that start a pattern */
+	int class_count;
+	uint32_t *next; /* next[state * class_count + class] */
+	int32_t *out; /* First marker ending in each state, or -1 */
+	int32_t *out_next; /* Next marker ending where each one ends, or -1 */
+	uint32_t state_count;
+} log_marker_set_t;
+
+/**
+ * Position of a scan, kept between log_marker_find() calls so that every
+ * marker ending at a byte is reported, and overlapping ones are not lost.
+ */
+typedef struct {
+	const char *p; /* Next byte to scan */
+	uint32_t state; /* Automaton state after the byte before p */
+	int which; /* Marker reported last, or -1 */
+} log_marker_cursor_t;
+
+/* ========================================================================== */
+/*                          Function Declarations                             */
+/* ========================================================================== */
+
+int log_marker_load(log_marker_set_t *set, const char *path);
+void log_marker_free(log_marker_set_t *set);
+void log_marker_cursor_init(log_marker_cursor_t *cur, const char *p);
+const char *log_marker_find(const log_marker_set_t *set, log_marker_cursor_t *cur,
+		const char *end, int *which);
+int log_marker_decode(const log_marker_t *mk, const char *tag, const char *eol,
+		uint64_t *time_us);
+
+#endif /* LOG_MARKER_H */
@@ -0,0 +1,257 @@
+/*
+ *  Copyright (C) 2025 Texas Instruments Incorporated
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions
+ *  are met:
+ *
+ *    Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *
+ *    Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the
+ *    distribution.
+ *
+ *    Neither the name of Texas Instruments Incorporated nor the names of
+ *    its contributors may be used to endorse or promote products derived
+ *    from this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ *  "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ *  LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ *  A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ *  OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ *  SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ *  LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ *  DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ *  THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ *  (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ *  OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/**
+ * \file record_store.c
+ * \brief Arena allocator, string interning and column store used to hold
+ * boot records without per-record allocations or fixed size arrays.
+ */
+
+/* ========================================================================== */
+/*                           Include Files                                    */
+/* ========================================================================== */
+
+#include <stdlib.h>
+#include <string.h>
+
+#include "record_store.h"
+
+
+/* ========================================================================== */
+/*                          Function Definitions                              */
+/* ========================================================================== */
+
+/**
+ * @brief Initialises an empty arena; the first chunk is allocated lazily.
+ */
+void arena_init(arena_t *arena)
+{
+	arena->head = NULL;
+	arena->total = 0;
+}
+
+/**
+ * @brief Allocates size bytes, 8-byte aligned, from the arena.
+ *
+ * Chunks grow geometrically so the number of malloc() calls stays
+ * logarithmic in the amount of data held.
+ *
+ * @return void* Zeroed memory, or NULL on allocation failure.
+ */
+void *arena_alloc(arena_t *arena, size_t size)
+{
+	arena_chunk_t *c = arena->head;
+	void *p;
+
+	size = (size + 7) & ~(size_t)7;
+	if (!c || c->size - c->used < size) {
+		size_t csize = c ? c->size * 2 : ARENA_MIN_CHUNK;
+
+		while (csize < size)
+			csize *= 2;
+		c = calloc(1, sizeof(*c) + csize);
+		if (!c)
+			return NULL;
+		c->size = csize;
+		c->next = arena->head;
+		arena->head = c;
+		arena->total += csize;
+	}
+	p = (uint8_t *)c->data + c->used;
+	c->used += size;
+	return p;
+}
+
+/**
+ * @brief Frees every chunk of the arena.
+ */
+void arena_release(arena_t *arena)
+{
+	arena_chunk_t *c = arena->head;
+
+	while (c) {
+		arena_chunk_t *next = c->next;
+		free(c);
+		c = next;
+	}
+	arena_init(arena);
+}
+
+/* Grows an arena backed array; the old block is reclaimed with the arena */
+static void *arena_grow(arena_t *arena, void *old, size_t old_size, size_t new_size)
+{
+	void *p = arena_alloc(arena, new_size);
+
+	if (p && old_size)
+		memcpy(p, old, old_size);
+	return p;
+}
+
+static uint32_t str_hash(const char *s, size_t len)
+{
+	uint32_t h = 2166136261u;
+
+	while (len--) {
+		h ^= (uint8_t)*s++;
+		h *= 16777619u;
+	}
+	return h;
+}
+
+/**
+ * @brief Initialises an empty string table allocating from arena.
+ */
+void strtab_init(strtab_t *tab, arena_t *arena)
+{
+	memset(tab, 0, sizeof(*tab));
+	tab->arena = arena;
+}
+
+static int strtab_rehash(strtab_t *tab, uint32_t nslots)
+{
+	uint32_t *slots = arena_alloc(tab->arena, nslots * sizeof(*slots));
+
+	if (!slots)
+		return -1;
+	for (uint32_t i = 0; i < tab->count; i++) {
+		const char *s = tab->strs[i];
+		uint32_t h = str_hash(s, strlen(s)) & (nslots - 1);
+
+		while (slots[h])
+			h = (h + 1) & (nslots - 1);
+		slots[h] = i + 1;
+	}
+	tab->slots = slots;
+	tab->nslots = nslots;
+	return 0;
+}
+
+/**
+ * @brief Returns the index of a string, adding it on first use.
+ *
+ * @param s String, not necessarily NUL terminated.
+ * @param len Length of s.
+ * @return uint32_t Index usable with strtab_str(), or STRTAB_NONE on
+ * allocation failure.
+ */
+uint32_t strtab_intern(strtab_t *tab, const char *s, size_t len)
+{
+	uint32_t h;
+	char *copy;
+
+	/* Keep the load factor at or below one half */
+	if ((tab->count + 1) * 2 > tab->nslots &&
+			strtab_rehash(tab, tab->nslots ? tab->nslots * 2 : STRTAB_MIN_SLOTS) < 0)
+		return STRTAB_NONE;
+
+	h = str_hash(s, len) & (tab->nslots - 1);
+	while (tab->slots[h]) {
+		const char *e = tab->strs[tab->slots[h] - 1];
+		if (strncmp(e, s, len) == 0 && e[len] == '\0')
+			return tab->slots[h] - 1;
+		h = (h + 1) & (tab->nslots - 1);
+	}
+
+	if (tab->count == tab->cap) {
+		uint32_t cap = tab->cap ? tab->cap * 2 : STRTAB_MIN_SLOTS;
+		const char **strs = arena_grow(tab->arena, tab->strs,
+				tab->cap * sizeof(*strs), cap * sizeof(*strs));
+		if (!strs)
+			return STRTAB_NONE;
+		tab->strs = strs;
+		tab->cap = cap;
+	}
+	copy = arena_alloc(tab->arena, len + 1);
+	if (!copy)
+		return STRTAB_NONE;
+	memcpy(copy, s, len);
+	copy[len] = '\0';
+
+	tab->strs[tab->count] = copy;
+	tab->slots[h] = ++tab->count;
+	return tab->count - 1;
+}
+
+/**
+ * @brief Returns the string stored at idx.
+ */
+const char *strtab_str(const strtab_t *tab, uint32_t idx)
+{
+	return (idx < tab->count) ? tab->strs[idx] : "";
+}
+
+/**
+ * @brief Initialises an empty record table allocating from arena.
+ */
+void record_table_init(record_table_t *tab, arena_t *arena)
+{
+	memset(tab, 0, sizeof(*tab));
+	tab->arena = arena;
+}
+
+/**
+ * @brief Appends one record, growing the columns when full.
+ *
+ * @return int 0 on success, -1 on allocation failure.
+ */
+int record_table_push(record_table_t *tab, uint64_t start_time,
+		uint64_t delta_time, uint32_t name, int32_t id, uint64_t duration)
+{
+	if (tab->count == tab->cap) {
+		uint32_t cap = tab->cap ? tab->cap * 2 : RECORD_TABLE_MIN_CAP;
+		uint64_t *st = arena_grow(tab->arena, tab->start_time,
+				tab->cap * sizeof(*st), cap * sizeof(*st));
+		uint64_t *dt = arena_grow(tab->arena, tab->delta_time,
+				tab->cap * sizeof(*dt), cap * sizeof(*dt));
+		uint32_t *nm = arena_grow(tab->arena, tab->name,
+				tab->cap * sizeof(*nm), cap * sizeof(*nm));
+		int32_t *id = arena_grow(tab->arena, tab->id,
+				tab->cap * sizeof(*id), cap * sizeof(*id));
+		uint64_t *du = arena_grow(tab->arena, tab->duration,
+				tab->cap * sizeof(*du), cap * sizeof(*du));
+		if (!st || !dt || !nm || !id || !du)
+			return -1;
+		tab->start_time = st;
+		tab->delta_time = dt;
+		tab->name = nm;
+		tab->id = id;
+		tab->duration = du;
+		tab->cap = cap;
+	}
+	tab->start_time[tab->count] = start_time;
+	tab->delta_time[tab->count] = delta_time;
+	tab->name[tab->count] = name;
+	tab->id[tab->count] = id;
+	tab->duration[tab->count] = duration;
+	tab->count++;
+	return 0;
+}
@@ -0,0 +1,122 @@
+/*
+ *  Copyright (C) 2025 Texas Instruments Incorporated
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions
+ *  are met:
+ *
+ *    Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *
+ *    Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the
+ *    distribution.
+ *
+ *    Neither the name of Texas Instruments Incorporated nor the names of
+ *    its contributors may be used to endorse or promote products derived
+ *    from this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ *  "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ *  LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ *  A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ *  OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ *  SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ *  LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ *  DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ *  THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ *  (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ *  OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/**
+ * \file record_store.h
+ * \brief Arena backed, structure-of-arrays boot record store with stage
+ * names interned once into a string table and referenced by index.
+ */
+
+#ifndef RECORD_STORE_H
+#define RECORD_STORE_H
+
+/* ========================================================================== */
+/*                           Include Files                                    */
+/* ========================================================================== */
+#include <stdint.h>
+#include <stddef.h>
+
+/* ========================================================================== */
+/*                           Macros & Typedefs                                */
+/* ========================================================================== */
+
+#define ARENA_MIN_CHUNK		(64u << 10)
+#define RECORD_TABLE_MIN_CAP	64
+#define STRTAB_MIN_SLOTS	64
+#define STRTAB_NONE		UINT32_MAX
+/* Record id of stages that have no bootstage id (e.g. MCU profiles) */
+#define RECORD_NO_ID		(-1)
+
+/* ========================================================================== */
+/*                           Data Structures                                  */
+/* ========================================================================== */
+
+typedef struct arena_chunk {
+	struct arena_chunk *next;
+	size_t size;
+	size_t used;
+	/* Data follows, aligned for any type */
+	uint64_t data[];
+} arena_chunk_t;
+
+/**
+ * Bump allocator. Everything allocated from it is released at once by
+ * arena_release().
+ */
+typedef struct {
+	arena_chunk_t *head;
+	size_t total;
+} arena_t;
+
+/**
+ * Interned string table; each distinct name is stored once.
+ */
+typedef struct {
+	arena_t *arena;
+	const char **strs; /* Index -> string */
+	uint32_t count;
+	uint32_t cap;
+	uint32_t *slots; /* Open addressing hash of index + 1, 0 = empty */
+	uint32_t nslots;
+} strtab_t;
+
+/**
+ * Growable column store of boot records.
+ */
+typedef struct {
+	arena_t *arena;
+	uint64_t *start_time;
+	uint64_t *delta_time;
+	uint32_t *name; /* strtab_t index */
+	int32_t *id; /* Bootstage id, or RECORD_NO_ID */
+	uint64_t *duration; /* Accumulated duration, 0 for point records */
+	uint32_t count;
+	uint32_t cap;
+} record_table_t;
+
+/* ========================================================================== */
+/*                          Function Declarations                             */
+/* ========================================================================== */
+
+void arena_init(arena_t *arena);
+void *arena_alloc(arena_t *arena, size_t size);
+void arena_release(arena_t *arena);
+
+void strtab_init(strtab_t *tab, arena_t *arena);
+uint32_t strtab_intern(strtab_t *tab, const char *s, size_t len);
+const char *strtab_str(const strtab_t *tab, uint32_t idx);
+
+void record_table_init(record_table_t *tab, arena_t *arena);
+int record_table_push(record_table_t *tab, uint64_t start_time,
+		uint64_t delta_time, uint32_t name, int32_t id, uint64_t duration);
+
+#endif /* RECORD_STORE_H */
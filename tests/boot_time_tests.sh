@@ -0,0 +1,200 @@
+#!/bin/sh
+#
+#  Copyright (C) 2025 Texas Instruments Incorporated
+#
+#  Redistribution and use in source and binary forms, with or without
+#  modification, are permitted provided that the following conditions
+#  are met:
+#
+#    Redistributions of source code must retain the above copyright
+#    notice, this list of conditions and the following disclaimer.
+#
+#    Redistributions in binary form must reproduce the above copyright
+#    notice, this list of conditions and the following disclaimer in the
+#    documentation and/or other materials provided with the
+#    distribution.
+#
+#    Neither the name of Texas Instruments Incorporated nor the names of
+#    its contributors may be used to endorse or promote products derived
+#    from this software without specific prior written permission.
+#
+#  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+#  "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+#  LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+#  A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+#  OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+#  SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+#  LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+#  DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+#  THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+#  (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+#  OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+#
+
+#
+# Regression tests, run by ctest. Each case generates boots with
+# boot_time_gen, runs boot_time_report_parser on them and compares the
+# reports of two ways of reading the same boot.
+#
+# Usage: boot_time_tests.sh <case> <boot_time_gen> <boot_time_report_parser> [<zlib found>]
+#
+
+set -eu
+
+test_case=$1
+GEN=$2
+PARSER=$3
+HAVE_ZLIB=${4:-}
+WORK=$(mktemp -d)
+trap 'rm -rf "$WORK"' EXIT
+cd "$WORK"
+
+fail()
+{
+	echo "FAIL: $*" >&2
+	exit 1
+}
+
+# Report without its title line, which names the host or archive
+report()
+{
+	"$PARSER" "$@" | grep -v "Boot Time Report"
+}
+
+same()
+{
+	cmp -s "$1" "$2" || { diff "$1" "$2" >&2; fail "$3"; }
+}
+
+# Every boot of a multi-boot log, split in memory by --no-index and found
+# through the index
+test_no_index_boots()
+{
+	"$GEN" region -o r.bin -s 11
+	"$GEN" log -o k.log -b 3 -c 20 -s 11
+	for b in -2 -1 0; do
+		report -d r.bin -l k.log -b $b --initcalls > idx$b.txt
+		report -d r.bin -l k.log -b $b --initcalls --no-index > raw$b.txt
+		same idx$b.txt raw$b.txt "boot $b differs without the index"
+	done
+	! cmp -s idx-2.txt idx0.txt || fail "boots -2 and 0 gave the same report"
+}
+
+# A second append leaves the archived boot alone, and both read back
+test_archive_append()
+{
+	"$GEN" region -o r1.bin -s 12
+	"$GEN" log -o k1.log -s 12
+	"$GEN" region -o r2.bin -s 14
+	"$GEN" log -o k2.log -s 14
+	report -d r1.bin -l k1.log --archive a.btar > boot1.txt
+	size=$(wc -c < a.btar)
+	tail -c +57 a.btar > before
+	report -d r2.bin -l k2.log --archive a.btar > boot2.txt
+	head -c "$size" a.btar | tail -c +57 | cmp -s - before ||
+		fail "append rewrote the archived boot"
+	"$PARSER" --archive-dump a.btar | grep -q "Archived Boots (2)" ||
+		fail "archive does not hold 2 boots"
+
+	report --archive-dump a.btar -b -1 > dump1.txt
+	same boot1.txt dump1.txt "first archived boot differs from its report"
+	report --archive-dump a.btar -b 0 > dump2.txt
+	same boot2.txt dump2.txt "second archived boot differs from its report"
+	! cmp -s boot1.txt boot2.txt || fail "both boots gave the same report"
+}
+
+# Index brought up to date after lines are appended to the last boot
+test_index_append()
+{
+	"$GEN" region -o r.bin -s 13
+	"$GEN" log -o full.log -b 2 -c 20 -s 13
+	lines=$(wc -l < full.log)
+	head -n $((lines * 3 / 4)) full.log > k.log
+	report -d r.bin -l k.log > /dev/null
+	[ -s k.log.btidx ] || fail "no index written"
+	tail -n +$((lines * 3 / 4 + 1)) full.log >> k.log
+	for b in -1 0; do
+		report -d r.bin -l k.log -b $b --initcalls > inc$b.txt
+		report -d r.bin -l full.log -b $b --initcalls --no-index > ref$b.txt
+		same ref$b.txt inc$b.txt "boot $b after the log grew"
+	done
+}
+
+# Boots moved by logrotate into numbered and compressed segments
+test_log_rotation()
+{
+	"$GEN" region -o r.bin -s 14
+	"$GEN" log -o all.log -b 4 -c 20 -s 14
+	awk 'BEGIN { n = 1 } /ID:300 / { if (seen) n++; seen = 1 } { print > ("seg" n) }' all.log
+	mv seg4 messages
+	mv seg3 messages.1
+	if [ "$HAVE_ZLIB" = TRUE ]; then
+		gzip -c seg2 > messages.2.gz
+	else
+		mv seg2 messages.2
+	fi
+	mv seg1 messages.3
+	for b in -3 -2 -1 0; do
+		report -d r.bin -l messages -b $b --initcalls > rot$b.txt
+		report -d r.bin -l all.log -b $b --initcalls --no-index > ref$b.txt
+		same ref$b.txt rot$b.txt "boot $b from the rotated segments"
+	done
+}
+
+# Milestones land at the same place whatever tracker time printk starts at
+test_printk_offset()
+{
+	"$GEN" region -o r.bin -s 15
+	for ms in 0 1500; do
+		"$GEN" log -o k$ms.log -s 15 --printk-offset $ms
+		"$GEN" milestones -o m$ms -s 15 --printk-offset $ms
+		report -d r.bin -l k$ms.log --milestones=m$ms > r$ms.txt
+	done
+	grep -q "multi-user" r0.txt || fail "no milestones reported"
+	same r0.txt r1500.txt "milestones moved by the printk offset"
+}
+
+# Markers that overlap each other or the tracker tag all match
+test_overlapping_markers()
+{
+	"$GEN" region -o r.bin -s 15
+	"$GEN" log -o k.log -s 15 -S 64K
+	cat > m.conf <<-EOF
+	"[BOOT"             bootish
+	"eth0: Link is Up"  link-up
+	"Link"              link
+	"is Up"             is-up
+	"is Up"             is-up-again
+	EOF
+	report -d r.bin -l k.log > plain.txt
+	report -d r.bin -l k.log --markers m.conf > markers.txt
+	grep "Kernel Time" plain.txt > want.txt
+	grep "Kernel Time" markers.txt > got.txt
+	same want.txt got.txt "tracker lines lost to a marker"
+
+	lines=$(grep -c "eth0: Link is Up" k.log)
+	[ "$lines" -gt 0 ] || fail "no link lines generated"
+	for name in link-up link is-up is-up-again; do
+		[ "$(grep -c "^$name " markers.txt)" = "$lines" ] ||
+			fail "$name does not match every link line"
+	done
+}
+
+# --watch --until returns at once when the stage is already in the region
+test_watch_until_read()
+{
+	"$GEN" region -o r.bin -s 3
+	"$GEN" log -o k.log -s 3
+	"$PARSER" -d r.bin -l k.log --watch --until MCU:IPC_SYNC_ALL \
+		--watch-timeout 2s > /dev/null || fail "IPC_SYNC_ALL not found in the region"
+}
+
+case $test_case in
+no_index_boots|archive_append|index_append|log_rotation|printk_offset|watch_until_read|\
+overlapping_markers)
+	"test_$test_case"
+	;;
+*)
+	fail "unknown test case $test_case"
+	;;
+esac